@@ -1,4 +1,6 @@
 ﻿#pragma once
+#include <cstddef>
+#include <functional>
 
 namespace raw {
 	/*
@@ -82,6 +84,199 @@ namespace raw {
 	template<typename T> class vector_non_triv;
 
 
+	/*
+	 * @brief Packed bit container (one bit per flag instead of one byte).
+	 *
+	 * ## Storage Structure:
+	 * - `vector_triv<uint64_t> words` - Bits packed into 64-bit words.
+	 * - `size_t size` - Number of bits currently stored.
+	 *
+	 * ## Key Features:
+	 * - Word level `push_back`, `set`/`reset`/`test` and bulk AND/OR/XOR/ANDNOT.
+	 * - SIMD `count()` and optional rank/select support structures.
+	 * - `find_next_set` iteration that skips whole zero words.
+	 */
+	class bit_vector;
+
+
+	/*
+	 * @brief Fixed-capacity vectors with inline storage, chosen by `raw::inplace_vector<T, N>`.
+	 *
+	 * ## Storage Structure:
+	 * - `T elems[N]` - Uninitialized inline slots (a union, so T is not default-constructed).
+	 * - `size` - Number of elements, stored in the smallest unsigned type that can hold `N`.
+	 *
+	 * ## Key Features:
+	 * - Never allocates; growing past `N` raises std::length_error or returns `status::length_error`.
+	 * - Same member API as raw::vector, plus `unchecked_push_back`.
+	 * - The trivial specialization is itself trivially copyable.
+	 */
+	template<typename T, size_t N> class inplace_vector_triv;
+	template<typename T, size_t N> class inplace_vector_non_triv;
+
+
+	/*
+	 * @brief Sequence with a movable gap at the cursor, for clustered mid-sequence edits.
+	 *
+	 * ## Storage Structure:
+	 * - `T* data` - One buffer laid out as `[front | gap | back]`.
+	 * - `gap_begin`, `gap_end` - The gap; `gap_begin` is the cursor.
+	 *
+	 * ## Key Features:
+	 * - O(1) insert/erase at the cursor, O(distance) cursor moves.
+	 * - memmove relocation for trivial types, move_if_noexcept for the rest.
+	 * - `make_contiguous()` closes the gap and exposes the elements as one array.
+	 */
+	template<typename T> class gap_buffer;
+
+
+	/*
+	 * @brief Non-owning view of contiguous elements (`raw::span<T>`).
+	 *
+	 * ## Storage Structure:
+	 * - `T* ptr` - First viewed element.
+	 * - `size_t count` - Number of viewed elements.
+	 *
+	 * ## Key Features:
+	 * - Implicit, allocation-free conversion from raw::vector, raw::inplace_vector and std containers.
+	 * - O(1) `subspan`, `first`, `last`; `strided(step)` and `chunks(n)` views.
+	 */
+	template<typename T> class span;
+	template<typename T> class strided_span;
+	template<typename T> class span_chunks;
+
+
+	/*
+	 * @brief Open-addressing hash containers in the SwissTable layout.
+	 *
+	 * ## Storage Structure:
+	 * - `vector_triv<uint8_t> ctrl_bytes` - One control byte per slot: empty, deleted, or 7 hash bits.
+	 * - `value_type* slots` - Inline elements, `capacity` = 2^k - 1 of them.
+	 *
+	 * ## Key Features:
+	 * - One 16-byte SIMD compare per probed group; only matching slots are read.
+	 * - Heterogeneous lookup with transparent Hash and Eq (default for std::string keys).
+	 * - memcpy rehash for trivially copyable elements.
+	 */
+	template<typename K> struct flat_hash;
+	template<typename K, typename V, typename Hash = flat_hash<K>, typename Eq = std::equal_to<>> class flat_hash_map;
+	template<typename K, typename Hash = flat_hash<K>, typename Eq = std::equal_to<>> class flat_hash_set;
+
+
+	/*
+	 * @brief Dense element storage addressed by generational handles.
+	 *
+	 * ## Storage Structure:
+	 * - `vector<T> values` - The elements, packed for iteration.
+	 * - `vector_triv<slot_entry> slots` - Per handle index: dense position (or next free slot) and generation.
+	 *
+	 * ## Key Features:
+	 * - O(1) insert, lookup and swap-and-pop erase; handles survive other elements' erasure.
+	 * - Stale handles are detected by generation; freed slots are reused FIFO.
+	 */
+	struct slot_handle;
+	template<typename T> class slot_map;
+
+
+	/*
+	 * @brief vector_triv over a fixed virtual-memory reservation; elements never move.
+	 *
+	 * ## Storage Structure:
+	 * - `T* data` - Start of a `PROT_NONE` reservation made on first growth.
+	 * - `committed` - Read/write prefix of the reservation, grown with `mprotect`.
+	 *
+	 * ## Key Features:
+	 * - Growth never copies; pointers stay valid for the vector's lifetime.
+	 * - `shrink_to_fit()` decommits unused pages with `madvise`.
+	 * - Same member API as vector_triv.
+	 */
+	struct vm_reservation;
+	template<typename T> class vm_vector;
+
+	/*
+	 * @brief Objects of several types derived from `Base`, stored by value in one buffer.
+	 *
+	 * ## Storage Structure:
+	 * - `bytes` - The objects back to back, each at its own alignment.
+	 * - `entries` - `{Base*, offset, ops}` per object; `ops` relocates and destroys its type.
+	 *
+	 * ## Key Features:
+	 * - No allocation per object; iteration walks adjacent memory.
+	 * - `is<D>()`, `get_if<D>()`, `for_each<D>()` by exact dynamic type.
+	 * - `group_by_type()` makes each type one contiguous run.
+	 */
+	template<typename Base> struct poly_ops;
+	template<typename Base> class poly_vector;
+
+	/*
+	 * @brief D-ary heap priority queue over raw::vector, ordered like std::priority_queue.
+	 *
+	 * ## Storage Structure:
+	 * - `vector<T> items` - Level order after `pad` unused slots; children of `i` are `D*i+1 .. D*i+D`.
+	 * - `pad` - Shifts the root so every child group starts on a cache-line boundary (trivial T).
+	 *
+	 * ## Key Features:
+	 * - log_D(n) levels, one cache line per level.
+	 * - O(n) `push_range`, one-sift `pop_push` / `replace_top`.
+	 * - Optional `Track` callback for positions; `update(pos)` / `erase(pos)` for decrease-key.
+	 */
+	struct no_heap_tracking;
+	template<typename T, size_t D = 4, typename Compare = std::less<T>, typename Track = no_heap_tracking> class dary_heap;
+
+	/*
+	 * @brief Read-only sorted array in Eytzinger (breadth-first) order for branchless lower_bound.
+	 *
+	 * ## Storage Structure:
+	 * - `vector<T> items` - Slot k has children 2k and 2k+1; slot 0 sits on a 64-byte boundary.
+	 *
+	 * ## Key Features:
+	 * - O(n) construction from a sorted span.
+	 * - Branchless descent with a fixed step count, prefetching four levels ahead.
+	 * - `lower_bound_batch` interleaves 16 searches to overlap cache misses.
+	 */
+	template<typename T, typename Compare = std::less<T>> class eytzinger_array;
+
+	/*
+	 * @brief Vector of strings sharing one character buffer, read as std::string_view.
+	 *
+	 * ## Storage Structure:
+	 * - `vector_triv<char> chars` - Every string's characters, back to back.
+	 * - `vector_triv<entry> entries` - A `{begin, end}` pair of `Offset`s per string.
+	 *
+	 * ## Key Features:
+	 * - Two allocations however many strings; `string_vector32` costs 8 bytes per string.
+	 * - `append_delimited` splits a whole buffer with one copy.
+	 * - `sort()` permutes entries only, comparing 8-byte prefix keys first.
+	 */
+	template<typename Offset> class basic_string_vector;
+
+	/*
+	 * @brief Read-mostly vector: wait-free reader snapshots, writers publish whole versions.
+	 *
+	 * ## Storage Structure:
+	 * - `std::atomic<version*> current` - The published `vector<T>`; old versions wait on the retired list.
+	 * - Cache-line-sized reader slots holding the epoch each active reader saw.
+	 *
+	 * ## Key Features:
+	 * - `reader::read()` is wait-free and writes only the reader's own slot.
+	 * - Writers batch changes on a private copy and publish with one pointer swap.
+	 * - Epoch-based reclamation frees a version once no reader can see it.
+	 */
+	template<typename T> class rcu_vector;
+
+	/*
+	 * @brief Per-thread local vectors for parallel loops, merged into one vector.
+	 *
+	 * ## Storage Structure:
+	 * - One `vector<T>` per slot, each slot aligned to its own cache line.
+	 *
+	 * ## Key Features:
+	 * - `local(worker)` for deterministic slot order, `local()` for first-come slots.
+	 * - `merge()` allocates once from prefix offsets and copies the pieces in parallel.
+	 */
+	template<typename T> class thread_collector;
+
+
 	
 
 }
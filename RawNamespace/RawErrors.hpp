@@ -0,0 +1,231 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+/************************************************************************
+* Error reporting shared by all raw containers.
+*
+* Exceptions are used unless the translation unit is compiled without them
+* (-fno-exceptions, /EHs-c-) or RAW_NO_EXCEPTIONS is defined. In that mode
+* every `throw` in the library is replaced by a call to the handlers below,
+* which report and abort, and the `try_*` member functions return a
+* `raw::status` instead.
+*
+* All raising helpers are out of line and marked cold, so the paths that
+* call them (push_back, at, ...) stay small enough to inline.
+***********************************************************************/
+
+#if !defined(RAW_NO_EXCEPTIONS) && !(defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+#define RAW_NO_EXCEPTIONS
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RAW_COLD __attribute__((noinline, cold))
+#define RAW_LIKELY(x) __builtin_expect(!!(x), 1)
+#define RAW_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#elif defined(_MSC_VER)
+#define RAW_COLD __declspec(noinline)
+#define RAW_LIKELY(x) (x)
+#define RAW_UNLIKELY(x) (x)
+#else
+#define RAW_COLD
+#define RAW_LIKELY(x) (x)
+#define RAW_UNLIKELY(x) (x)
+#endif
+
+/// Put before a loop whose iterations are known not to alias (checked by the caller).
+#if defined(__clang__)
+#define RAW_IVDEP _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define RAW_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define RAW_IVDEP __pragma(loop(ivdep))
+#else
+#define RAW_IVDEP
+#endif
+
+/// Put before a short loop with a constant trip count that should be fully unrolled.
+#if defined(__clang__)
+#define RAW_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define RAW_UNROLL _Pragma("GCC unroll 16")
+#else
+#define RAW_UNROLL
+#endif
+
+/// Hint that `addr` will be read soon; a no-op where unsupported.
+#if defined(__GNUC__)
+#define RAW_PREFETCH(addr) __builtin_prefetch(static_cast<const void*>(addr), 0, 3)
+#else
+#define RAW_PREFETCH(addr) ((void)0)
+#endif
+
+/*********************************************************************
+ * CONSTANT EVALUATION: `RAW_CONSTEXPR20`, `RAW_HAS_CONSTEXPR_VECTOR`
+ *
+ * With C++20 constexpr allocation the vectors are usable in constant
+ * expressions; their members are then marked `RAW_CONSTEXPR20`. Older
+ * standards get plain inline functions.
+ *********************************************************************/
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L && \
+	defined(__cpp_lib_is_constant_evaluated) && __cpp_lib_is_constant_evaluated >= 201811L
+#define RAW_HAS_CONSTEXPR_VECTOR 1
+#define RAW_CONSTEXPR20 constexpr
+#else
+#define RAW_CONSTEXPR20
+#endif
+
+/*********************************************************************
+ * TRY/CATCH MACROS: `RAW_TRY`, `RAW_CATCH_ALL`, `RAW_RETHROW`
+ *
+ * For cleanup-and-rethrow blocks around element constructors. Without
+ * exceptions nothing can throw, so the handler block is dead code.
+ *********************************************************************/
+#ifdef RAW_NO_EXCEPTIONS
+#define RAW_TRY if (true)
+#define RAW_CATCH_ALL else
+#define RAW_RETHROW std::abort()
+#else
+#define RAW_TRY try
+#define RAW_CATCH_ALL catch (...)
+#define RAW_RETHROW throw
+#endif
+
+namespace raw {
+	/*********************************************************************
+	 * ENUM: `status`
+	 *
+	 * Result of the non-throwing `try_*` operations. On anything but `ok`
+	 * the container is left exactly as it was.
+	 *********************************************************************/
+	enum class status {
+		ok,
+		out_of_memory,
+		out_of_range,
+		length_error
+	};
+
+	inline const char* to_string(status s) {
+		switch (s) {
+		case status::ok: return "ok";
+		case status::out_of_memory: return "out of memory";
+		case status::out_of_range: return "index out of range";
+		case status::length_error: return "length error";
+		}
+		return "unknown";
+	}
+
+	/*********************************************************************
+	 * ALLOCATION FAILURE HANDLER
+	 *
+	 * Called with the requested byte count whenever a throwing operation
+	 * (push_back, reserve, ...) cannot get memory. It may release caches,
+	 * log, throw its own exception or terminate. If it returns, the library
+	 * throws std::bad_alloc, or aborts when built without exceptions.
+	 * The `try_*` operations never call it; they return
+	 * `status::out_of_memory` instead.
+	 *********************************************************************/
+	using alloc_failure_handler = void(*)(size_t bytes);
+
+	namespace detail {
+		/// True while the caller is being evaluated at compile time (always false before C++20).
+		constexpr bool is_constant_evaluated() noexcept {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			return std::is_constant_evaluated();
+#else
+			return false;
+#endif
+		}
+
+		inline std::atomic<alloc_failure_handler>& alloc_handler_slot() {
+			static std::atomic<alloc_failure_handler> handler{ nullptr };
+			return handler;
+		}
+
+		[[noreturn]] inline void fatal(const char* what) {
+			std::fputs("raw: ", stderr);
+			std::fputs(what, stderr);
+			std::fputc('\n', stderr);
+			std::abort();
+		}
+
+		[[noreturn]] RAW_COLD inline void alloc_failure(size_t bytes) {
+			if (alloc_failure_handler handler = alloc_handler_slot().load(std::memory_order_acquire))
+				handler(bytes);
+#ifdef RAW_NO_EXCEPTIONS
+			fatal("allocation failed");
+#else
+			throw std::bad_alloc();
+#endif
+		}
+
+		[[noreturn]] RAW_COLD inline void throw_out_of_range(const char* what) {
+#ifdef RAW_NO_EXCEPTIONS
+			fatal(what);
+#else
+			throw std::out_of_range(what);
+#endif
+		}
+
+		[[noreturn]] RAW_COLD inline void throw_length_error(const char* what) {
+#ifdef RAW_NO_EXCEPTIONS
+			fatal(what);
+#else
+			throw std::length_error(what);
+#endif
+		}
+
+		[[noreturn]] RAW_COLD inline void throw_invalid_argument(const char* what) {
+#ifdef RAW_NO_EXCEPTIONS
+			fatal(what);
+#else
+			throw std::invalid_argument(what);
+#endif
+		}
+
+		[[noreturn]] RAW_COLD inline void throw_logic_error(const char* what) {
+#ifdef RAW_NO_EXCEPTIONS
+			fatal(what);
+#else
+			throw std::logic_error(what);
+#endif
+		}
+
+		/// For failed system calls; `err` is the errno value.
+		[[noreturn]] RAW_COLD inline void throw_system_error(int err, const char* what) {
+#ifdef RAW_NO_EXCEPTIONS
+			(void)err;
+			fatal(what);
+#else
+			throw std::system_error(err, std::generic_category(), what);
+#endif
+		}
+
+		/// Turns a failed `status` into the matching exception (or handler call).
+		/// In a constant expression a failure is a compile error.
+		RAW_CONSTEXPR20 inline void raise_if(status s, size_t bytes) {
+			if (RAW_LIKELY(s == status::ok))
+				return;
+			if (s == status::out_of_range)
+				throw_out_of_range("Index out of range");
+			if (s == status::length_error)
+				throw_length_error("Requested size exceeds max_size()");
+			alloc_failure(bytes);
+		}
+	}
+
+	/// Installs `handler` (nullptr restores the default) and returns the previous one.
+	inline alloc_failure_handler set_alloc_failure_handler(alloc_failure_handler handler) {
+		return detail::alloc_handler_slot().exchange(handler, std::memory_order_acq_rel);
+	}
+
+	inline alloc_failure_handler get_alloc_failure_handler() {
+		return detail::alloc_handler_slot().load(std::memory_order_acquire);
+	}
+}
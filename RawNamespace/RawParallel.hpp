@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <thread>
+#include "RawNamespace/RawErrors.hpp"
+
+/************************************************************************
+* Fork-join helpers shared by the parallel paths (radix sort, collector
+* merge). Work is split into `threads` equal slices; slice 0 runs on the
+* calling thread, the rest on short-lived std::threads joined before
+* returning.
+***********************************************************************/
+
+namespace raw {
+	namespace detail {
+		constexpr unsigned parallel_max_threads = 64;
+
+		/*********************************************************************
+		 * FUNCTION: `parallel_thread_count(requested, work, min_work, work_per_thread)`
+		 *
+		 * 1 below `min_work`; otherwise `requested` (0 = hardware
+		 * concurrency), capped at parallel_max_threads and at one thread per
+		 * `work_per_thread` units. `work` is in whatever unit the caller
+		 * measures (elements, bytes).
+		 *********************************************************************/
+		inline unsigned parallel_thread_count(unsigned requested, size_t work,
+			size_t min_work, size_t work_per_thread) noexcept {
+			if (work < min_work)
+				return 1;
+			unsigned threads = requested ? requested : std::thread::hardware_concurrency();
+			if (threads == 0)
+				threads = 1;
+			if (threads > parallel_max_threads)
+				threads = parallel_max_threads;
+			const size_t by_size = work / work_per_thread;
+			return by_size < threads ? static_cast<unsigned>(by_size) : threads;
+		}
+
+		/*********************************************************************
+		 * FUNCTION: `parallel_run(threads, fn)`
+		 *
+		 * Runs `fn(t)` for t in [0, threads), t = 0 on the calling thread.
+		 * `threads` must be 1..parallel_max_threads.
+		 *
+		 * Throws: std::system_error if a thread cannot start, or whatever
+		 *         `fn(0)` throws; started threads are joined first.
+		 *********************************************************************/
+		template<typename Fn>
+		void parallel_run(unsigned threads, const Fn& fn) {
+			if (threads == 1) {
+				fn(0u);
+				return;
+			}
+			std::thread workers[parallel_max_threads];
+			unsigned started = 0;
+			RAW_TRY {
+				for (unsigned t = 1; t < threads; ++t) {
+					workers[t - 1] = std::thread(fn, t);
+					++started;
+				}
+				fn(0u);
+			} RAW_CATCH_ALL {
+				for (unsigned t = 0; t < started; ++t)
+					workers[t].join();
+				RAW_RETHROW;
+			}
+			for (unsigned t = 0; t < started; ++t)
+				workers[t].join();
+		}
+	}
+}
@@ -0,0 +1,474 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+#if defined(__AVX2__) || defined(__AVX512VPOPCNTDQ__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+namespace raw {
+	namespace bit_ops {
+		/*********************************************************************
+		 * HELPER FUNCTIONS: `popcount64()`, `ctz64()`, `select64()`
+		 *
+		 * Single word primitives used by `bit_vector`.
+		 * `ctz64()` and `select64()` expect at least one set bit.
+		 *********************************************************************/
+
+		inline unsigned popcount64(uint64_t word) {
+#if defined(_MSC_VER)
+			return static_cast<unsigned>(__popcnt64(word));
+#else
+			return static_cast<unsigned>(__builtin_popcountll(word));
+#endif
+		}
+
+		inline unsigned ctz64(uint64_t word) {
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64(&index, word);
+			return static_cast<unsigned>(index);
+#else
+			return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+		}
+
+		/// Returns position of the `k`-th (0-based) set bit of `word`.
+		inline unsigned select64(uint64_t word, unsigned k) {
+#if defined(__BMI2__)
+			return ctz64(_pdep_u64(uint64_t(1) << k, word));
+#else
+			for (unsigned i = 0; i < k; ++i)
+				word &= word - 1;
+			return ctz64(word);
+#endif
+		}
+
+		/*************************************************************************************
+		 * HELPER FUNCTION: `popcount_words(const uint64_t* words, size_t count)`
+		 *
+		 * Counts set bits in `count` words.
+		 * Uses VPOPCNTQ on AVX-512, the nibble lookup (`pshufb` + `psadbw`) on AVX2,
+		 * and the scalar instruction otherwise.
+		 *************************************************************************************/
+
+		inline uint64_t popcount_words(const uint64_t* words, size_t count) {
+			uint64_t total = 0;
+			size_t i = 0;
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512F__)
+			__m512i acc512 = _mm512_setzero_si512();
+			for (; i + 8 <= count; i += 8)
+				acc512 = _mm512_add_epi64(acc512, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+			total += static_cast<uint64_t>(_mm512_reduce_add_epi64(acc512));
+#elif defined(__AVX2__)
+			const __m256i lookup = _mm256_setr_epi8(
+				0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+				0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+			const __m256i low_mask = _mm256_set1_epi8(0x0f);
+			__m256i acc = _mm256_setzero_si256();
+			for (; i + 4 <= count; i += 4) {
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+				__m256i lo = _mm256_and_si256(v, low_mask);
+				__m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+				__m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+				acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+			}
+			total += static_cast<uint64_t>(_mm256_extract_epi64(acc, 0)) + static_cast<uint64_t>(_mm256_extract_epi64(acc, 1))
+				+ static_cast<uint64_t>(_mm256_extract_epi64(acc, 2)) + static_cast<uint64_t>(_mm256_extract_epi64(acc, 3));
+#endif
+			for (; i < count; ++i)
+				total += popcount64(words[i]);
+			return total;
+		}
+	}
+
+	class bit_vector {
+	public:
+		static constexpr size_t npos = std::numeric_limits<size_t>::max();
+		static constexpr size_t word_bits = 64;
+
+	private:
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `words`         - Packed storage, bit `i` lives in `words[i / 64]` at position `i % 64`.
+		 *                   Bits past `size` in the last word are always kept at 0.
+		 * `size`          - Number of bits stored.
+		 * `rank_blocks`   - Number of set bits before every 512 bit block (plus a final total).
+		 * `select_samples`- Block index holding every `select_sample_rate`-th set bit.
+		 * `rank_ready`    - False once the bits were modified after `build_rank_select()`.
+		 *************************************************************************************************/
+
+		static constexpr size_t block_words = 8;
+		static constexpr size_t select_sample_rate = 4096;
+
+		vector_triv<uint64_t> words;
+		size_t size = 0;
+		vector_triv<uint64_t> rank_blocks;
+		vector_triv<uint64_t> select_samples;
+		bool rank_ready = false;
+
+		static size_t words_for(size_t bits) { return (bits + word_bits - 1) / word_bits; }
+
+		uint64_t* word_data() { return words.get_size() ? &words[0] : nullptr; }
+		const uint64_t* word_data() const { return words.get_size() ? &words[0] : nullptr; }
+
+		/// Clears the bits past `size` in the last word so counting never sees stale bits.
+		void clear_tail() {
+			size_t used = size % word_bits;
+			if (used)
+				words[words.get_size() - 1] &= (uint64_t(1) << used) - 1;
+		}
+
+		void check_same_size(const bit_vector& other) const {
+			if (size != other.size)
+				detail::throw_invalid_argument("bit_vector sizes differ");
+		}
+
+	public:
+
+		/*********************************************************************
+		 * CONSTRUCTORS: `bit_vector()`, `bit_vector(size_t bits, bool value)`
+		 *
+		 * Creates an empty vector or one holding `bits` copies of `value`.
+		 *
+		 * Throws: std::bad_alloc on allocation failure.
+		 *********************************************************************/
+
+		bit_vector() = default;
+
+		explicit bit_vector(size_t bits, bool value = false) {
+			resize(bits, value);
+		}
+
+		/*********************************************************************
+		 * GETTER FUNCTIONS: `get_size()`, `get_word_count()`, `empty()`, `word()`
+		 *
+		 * Number of bits, number of 64-bit words and read access to a single word.
+		 *********************************************************************/
+
+		size_t get_size() const { return size; }
+		size_t get_word_count() const { return words.get_size(); }
+		bool empty() const { return size == 0; }
+		uint64_t word(size_t index) const { return words[index]; }
+
+		/*************************************************************************************
+		 * PUSH_BACK FUNCTIONS: `push_back(bool bit)`, `push_back_word(uint64_t word, size_t bits)`
+		 *
+		 * `push_back` appends one bit, touching a single word.
+		 * `push_back_word` appends the low `bits` bits of `word` at once (at most two word writes).
+		 *
+		 * Throws: std::bad_alloc on allocation failure, std::invalid_argument if `bits` > 64.
+		 *************************************************************************************/
+
+		void push_back(bool bit) {
+			size_t offset = size % word_bits;
+			if (offset == 0)
+				words.push_back(uint64_t(bit));
+			else if (bit)
+				words[words.get_size() - 1] |= uint64_t(1) << offset;
+			++size;
+			rank_ready = false;
+		}
+
+		void push_back_word(uint64_t word, size_t bits = word_bits) {
+			if (bits > word_bits)
+				detail::throw_invalid_argument("push_back_word takes at most 64 bits");
+			if (bits == 0)
+				return;
+			if (bits < word_bits)
+				word &= (uint64_t(1) << bits) - 1;
+			size_t offset = size % word_bits;
+			if (offset == 0) {
+				words.push_back(word);
+			}
+			else {
+				words[words.get_size() - 1] |= word << offset;
+				if (offset + bits > word_bits)
+					words.push_back(word >> (word_bits - offset));
+			}
+			size += bits;
+			rank_ready = false;
+		}
+
+		/*********************************************************************
+		 * BIT ACCESS: `test()`, `set()`, `reset()`, `flip()`, `operator[]`
+		 *
+		 * `test()`, `set()`, `reset()` and `flip()` check bounds and throw
+		 * `std::out_of_range`. `operator[]` reads without bounds checking.
+		 *********************************************************************/
+
+		bool operator [] (size_t pos) const {
+			return (words[pos / word_bits] >> (pos % word_bits)) & 1;
+		}
+
+		bool test(size_t pos) const {
+			if (pos >= size)
+				detail::throw_out_of_range("Index out of range");
+			return (*this)[pos];
+		}
+
+		void set(size_t pos, bool value = true) {
+			if (pos >= size)
+				detail::throw_out_of_range("Index out of range");
+			uint64_t mask = uint64_t(1) << (pos % word_bits);
+			if (value)
+				words[pos / word_bits] |= mask;
+			else
+				words[pos / word_bits] &= ~mask;
+			rank_ready = false;
+		}
+
+		void reset(size_t pos) { set(pos, false); }
+
+		void flip(size_t pos) {
+			if (pos >= size)
+				detail::throw_out_of_range("Index out of range");
+			words[pos / word_bits] ^= uint64_t(1) << (pos % word_bits);
+			rank_ready = false;
+		}
+
+		/*********************************************************************
+		 * WHOLE VECTOR FUNCTIONS: `set_all()`, `reset_all()`, `resize()`, `clear()`
+		 *
+		 * `resize()` fills new bits with `value`.
+		 *
+		 * Throws: std::bad_alloc on allocation failure.
+		 *********************************************************************/
+
+		void set_all() {
+			if (size)
+				std::memset(word_data(), 0xff, words.get_size() * sizeof(uint64_t));
+			clear_tail();
+			rank_ready = false;
+		}
+
+		void reset_all() {
+			if (size)
+				std::memset(word_data(), 0, words.get_size() * sizeof(uint64_t));
+			rank_ready = false;
+		}
+
+		void resize(size_t bits, bool value = false) {
+			size_t old_size = size;
+			size_t old_words = words.get_size();
+			words.resize(words_for(bits));
+			size = bits;
+			if (bits > old_size && value) {
+				if (old_size % word_bits)
+					words[old_words - 1] |= ~uint64_t(0) << (old_size % word_bits);
+				if (words.get_size() > old_words)
+					std::memset(word_data() + old_words, 0xff, (words.get_size() - old_words) * sizeof(uint64_t));
+			}
+			clear_tail();
+			rank_ready = false;
+		}
+
+		void clear() {
+			words.clear();
+			size = 0;
+			rank_ready = false;
+		}
+
+		/*************************************************************************************
+		 * BULK OPERATORS: `&=`, `|=`, `^=`, `and_not()`
+		 *
+		 * Combine with `other` word by word (four words per step with AVX2).
+		 * `and_not(other)` keeps the bits set here and not set in `other`.
+		 *
+		 * Throws: std::invalid_argument when sizes differ.
+		 *************************************************************************************/
+
+	private:
+		struct and_op {
+			static uint64_t apply(uint64_t a, uint64_t b) { return a & b; }
+#if defined(__AVX2__)
+			static __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+		};
+		struct or_op {
+			static uint64_t apply(uint64_t a, uint64_t b) { return a | b; }
+#if defined(__AVX2__)
+			static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+		};
+		struct xor_op {
+			static uint64_t apply(uint64_t a, uint64_t b) { return a ^ b; }
+#if defined(__AVX2__)
+			static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#endif
+		};
+		struct and_not_op {
+			static uint64_t apply(uint64_t a, uint64_t b) { return a & ~b; }
+#if defined(__AVX2__)
+			static __m256i apply(__m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+#endif
+		};
+
+		template<typename Op>
+		bit_vector& combine(const bit_vector& other) {
+			check_same_size(other);
+			uint64_t* dst = word_data();
+			const uint64_t* src = other.word_data();
+			const size_t count = words.get_size();
+			size_t i = 0;
+#if defined(__AVX2__)
+			for (; i + 4 <= count; i += 4) {
+				__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+				__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Op::apply(a, b));
+			}
+#endif
+			for (; i < count; ++i)
+				dst[i] = Op::apply(dst[i], src[i]);
+			rank_ready = false;
+			return *this;
+		}
+
+	public:
+		bit_vector& operator &=(const bit_vector& other) { return combine<and_op>(other); }
+		bit_vector& operator |=(const bit_vector& other) { return combine<or_op>(other); }
+		bit_vector& operator ^=(const bit_vector& other) { return combine<xor_op>(other); }
+		bit_vector& and_not(const bit_vector& other) { return combine<and_not_op>(other); }
+
+		/*********************************************************************
+		 * COUNT FUNCTION: `count()`
+		 *
+		 * Returns the number of set bits using the SIMD popcount kernel.
+		 *********************************************************************/
+
+		size_t count() const {
+			return static_cast<size_t>(bit_ops::popcount_words(word_data(), words.get_size()));
+		}
+
+		/*************************************************************************************
+		 * SEARCH FUNCTIONS: `find_first()`, `find_next_set(size_t pos)`
+		 *
+		 * Return the first set bit at or after `pos`, or `npos` if there is none.
+		 * Whole zero words are skipped with a single compare each.
+		 *************************************************************************************/
+
+		size_t find_next_set(size_t pos) const {
+			if (pos >= size)
+				return npos;
+			size_t index = pos / word_bits;
+			uint64_t word = words[index] & (~uint64_t(0) << (pos % word_bits));
+			const size_t count = words.get_size();
+			while (word == 0) {
+				if (++index == count)
+					return npos;
+				word = words[index];
+			}
+			return index * word_bits + bit_ops::ctz64(word);
+		}
+
+		size_t find_first() const { return find_next_set(0); }
+
+		/// Calls `fn(index)` for every set bit in increasing order.
+		template<typename Fn>
+		void for_each_set(Fn fn) const {
+			const size_t count = words.get_size();
+			for (size_t index = 0; index < count; ++index) {
+				uint64_t word = words[index];
+				while (word) {
+					fn(index * word_bits + bit_ops::ctz64(word));
+					word &= word - 1;
+				}
+			}
+		}
+
+		/*************************************************************************************
+		 * RANK / SELECT SUPPORT: `build_rank_select()`, `rank()`, `select()`
+		 *
+		 * `build_rank_select()` stores the set bit count before every 512 bit block
+		 * (one `uint64_t` per 8 words, 12.5% overhead) and samples the block of every
+		 * 4096-th set bit. Both queries then touch one block of words.
+		 *
+		 * `rank(pos)`  - number of set bits in [0, pos).
+		 * `select(k)`  - position of the `k`-th (0-based) set bit, `npos` if `k` >= count().
+		 *
+		 * Any modification invalidates the structure; queries then throw std::logic_error
+		 * until `build_rank_select()` is called again.
+		 *************************************************************************************/
+
+		void build_rank_select() {
+			const size_t count = words.get_size();
+			const size_t blocks = (count + block_words - 1) / block_words;
+			rank_blocks.clear();
+			rank_blocks.reserve(blocks + 1);
+			select_samples.clear();
+
+			uint64_t running = 0;
+			uint64_t next_sample = 0;
+			const uint64_t* data = word_data();
+			for (size_t b = 0; b < blocks; ++b) {
+				rank_blocks.push_back(running);
+				size_t begin = b * block_words;
+				size_t len = std::min(block_words, count - begin);
+				running += bit_ops::popcount_words(data + begin, len);
+				while (next_sample < running) {
+					select_samples.push_back(b);
+					next_sample += select_sample_rate;
+				}
+			}
+			rank_blocks.push_back(running);
+			rank_ready = true;
+		}
+
+		bool has_rank_select() const { return rank_ready; }
+
+		size_t rank(size_t pos) const {
+			if (!rank_ready)
+				detail::throw_logic_error("rank/select structure is stale, call build_rank_select()");
+			if (pos > size)
+				detail::throw_out_of_range("Index out of range");
+			size_t word_index = pos / word_bits;
+			size_t block = word_index / block_words;
+			uint64_t result = rank_blocks[block];
+			const uint64_t* data = word_data();
+			result += bit_ops::popcount_words(data + block * block_words, word_index - block * block_words);
+			if (pos % word_bits)
+				result += bit_ops::popcount64(data[word_index] & ((uint64_t(1) << (pos % word_bits)) - 1));
+			return static_cast<size_t>(result);
+		}
+
+		size_t select(size_t k) const {
+			if (!rank_ready)
+				detail::throw_logic_error("rank/select structure is stale, call build_rank_select()");
+			const size_t blocks = rank_blocks.get_size() - 1;
+			if (k >= rank_blocks[blocks])
+				return npos;
+
+			size_t sample = k / select_sample_rate;
+			size_t lo = static_cast<size_t>(select_samples[sample]);
+			size_t hi = sample + 1 < select_samples.get_size() ? static_cast<size_t>(select_samples[sample + 1]) + 1 : blocks;
+			// last block with rank_blocks[block] <= k
+			while (hi - lo > 1) {
+				size_t mid = lo + (hi - lo) / 2;
+				if (rank_blocks[mid] <= k)
+					lo = mid;
+				else
+					hi = mid;
+			}
+
+			uint64_t remaining = k - rank_blocks[lo];
+			size_t index = lo * block_words;
+			for (;; ++index) {
+				unsigned ones = bit_ops::popcount64(words[index]);
+				if (remaining < ones)
+					break;
+				remaining -= ones;
+			}
+			return index * word_bits + bit_ops::select64(words[index], static_cast<unsigned>(remaining));
+		}
+	};
+}
@@ -0,0 +1,244 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/RawParallel.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* raw::thread_collector<T> - per-thread output vectors for parallel
+* loops, merged into one raw::vector at the end.
+*
+*     raw::thread_collector<hit> hits(workers);
+*     parallel_for(workers, [&](size_t w) {
+*         raw::vector<hit>& out = hits.local(w);   // this worker's own vector
+*         for (...) out.push_back(h);
+*     });
+*     raw::vector<hit> all = hits.merge();
+*
+* Each local vector sits in its own 64-byte-aligned slot, so workers
+* appending at the same time never share a cache line. The merge sums
+* the local sizes into offsets, allocates the result once, and copies
+* the pieces with memcpy (trivially copyable T) - split evenly by bytes
+* over several threads for large results - or moves them (other T).
+*
+* Order: the result is the slots in index order, each in push order.
+* With `local(worker)` and stable worker indices the result is
+* deterministic. `local()` instead gives each thread a slot the first
+* time it asks, so slots follow whichever thread came first.
+*
+* Only `local()` / `local(worker)` and pushes into distinct slots may
+* run concurrently; merge, clear and size queries need the workers done.
+***********************************************************************/
+
+namespace raw {
+	/*********************************************************************
+	 * OPTIONS: `merge_options`
+	 *
+	 * `threads`       - copy threads for results of 1 MiB and more (trivially
+	 *                   copyable T); 0 uses every hardware thread. Each copies
+	 *                   an equal byte range, whatever the piece sizes.
+	 * `keep_capacity` - locals keep their buffers for the next round (true)
+	 *                   or free them (false).
+	 *********************************************************************/
+	struct merge_options {
+		unsigned threads = 1;
+		bool keep_capacity = true;
+	};
+
+	namespace detail {
+		constexpr size_t collector_parallel_min_bytes = size_t(1) << 20;
+		constexpr size_t collector_bytes_per_thread = size_t(1) << 18;
+
+		inline uint64_t next_collector_id() noexcept {
+			static std::atomic<uint64_t> counter{ 0 };
+			return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+	}
+
+	template<typename T>
+	class thread_collector {
+	private:
+		struct alignas(64) slot {
+			vector<T> items;
+			std::atomic<std::thread::id> owner{ std::thread::id() };
+		};
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `slots`      - `slot_count` local vectors, one cache line apart at least.
+		 * `next_free`  - Slots handed out by `local()` so far; they are taken from the front.
+		 * `id`         - Distinguishes this collector in the per-thread `local()` cache.
+		 *************************************************************************************************/
+		std::unique_ptr<slot[]> slots;
+		size_t slot_count = 0;
+		std::atomic<size_t> next_free{ 0 };
+		uint64_t id = detail::next_collector_id();
+
+		struct local_cache {
+			uint64_t collector = 0;
+			size_t index = 0;
+		};
+
+		static local_cache& cache() noexcept {
+			thread_local local_cache entry;
+			return entry;
+		}
+
+		/// `local()` past the one-entry cache: this thread's slot, or a new one.
+		RAW_COLD size_t find_or_claim() {
+			const std::thread::id self = std::this_thread::get_id();
+			const size_t claimed = next_free.load(std::memory_order_acquire);
+			for (size_t i = 0; i < claimed && i < slot_count; ++i) {
+				if (slots[i].owner.load(std::memory_order_relaxed) == self)
+					return i;
+			}
+			const size_t index = next_free.fetch_add(1, std::memory_order_acq_rel);
+			if (index >= slot_count)
+				detail::throw_length_error("thread_collector: more threads than slots");
+			slots[index].owner.store(self, std::memory_order_relaxed);
+			return index;
+		}
+
+	public:
+		using value_type = T;
+
+		/*********************************************************************
+		 * CONSTRUCTOR: `thread_collector(slots)`
+		 *
+		 * `slots` local vectors (0: one per hardware thread).
+		 *
+		 * Throws: allocation failure.
+		 *********************************************************************/
+		explicit thread_collector(size_t slots_ = 0) {
+			slot_count = slots_ ? slots_ : std::thread::hardware_concurrency();
+			if (slot_count == 0)
+				slot_count = 1;
+			slots.reset(new slot[slot_count]);
+		}
+
+		thread_collector(const thread_collector&) = delete;
+		thread_collector& operator=(const thread_collector&) = delete;
+
+		/*********************************************************************
+		 * LOCAL VECTORS: `local(worker)`, `local()`
+		 *
+		 * `local(worker)` - slot `worker`; the caller keeps one worker per slot.
+		 * `local()`       - the calling thread's slot, assigned on its first
+		 *                   call (one thread_local compare afterwards). Slots
+		 *                   are keyed by std::thread::id, so a thread started
+		 *                   after another one ended may be given its slot.
+		 * Do not mix the two on one collector.
+		 *
+		 * Throws: std::out_of_range (`worker` >= slots), std::length_error
+		 *         (`local()` from more threads than slots).
+		 *********************************************************************/
+		vector<T>& local(size_t worker) {
+			if (worker >= slot_count)
+				detail::throw_out_of_range("thread_collector: worker index out of range");
+			return slots[worker].items;
+		}
+
+		vector<T>& local() {
+			local_cache& entry = cache();
+			if (RAW_UNLIKELY(entry.collector != id)) {
+				entry.index = find_or_claim();
+				entry.collector = id;
+			}
+			return slots[entry.index].items;
+		}
+
+		/*********************************************************************
+		 * MERGE: `merge(options)`, `merge_into(out, options)`
+		 *
+		 * Concatenates the locals in slot order into a new vector, or appends
+		 * them to `out`, allocating exactly once. The locals are cleared;
+		 * slot assignments made by `local()` stay.
+		 *
+		 * Throws: allocation failure (nothing is moved then), exceptions from
+		 *         T's move constructor.
+		 *********************************************************************/
+		vector<T> merge(merge_options options = merge_options()) {
+			vector<T> out;
+			merge_into(out, options);
+			return out;
+		}
+
+		void merge_into(vector<T>& out, merge_options options = merge_options()) {
+			vector<size_t> offsets(slot_count + 1);
+			for (size_t i = 0; i < slot_count; ++i)
+				offsets[i + 1] = offsets[i] + slots[i].items.get_size();
+			const size_t total = offsets[slot_count];
+			if (total != 0) {
+				out.reserve(out.get_size() + total);
+				if constexpr (myis_trivial<T>::value) {
+					copy_pieces(out.spare_data(), offsets, options.threads);
+					out.commit_spare(total);
+				}
+				else {
+					for (size_t i = 0; i < slot_count; ++i) {
+						vector<T>& piece = slots[i].items;
+						for (size_t k = 0; k < piece.get_size(); ++k)
+							out.push_back(std::move(piece[k]));
+					}
+				}
+			}
+			clear(options.keep_capacity);
+		}
+
+		/*********************************************************************
+		 * OTHER: `clear(keep_capacity)`, `get_size()`, `get_slot_count()`
+		 *
+		 * `get_size()` - elements over all locals.
+		 *********************************************************************/
+		void clear(bool keep_capacity = true) {
+			for (size_t i = 0; i < slot_count; ++i) {
+				if (keep_capacity)
+					slots[i].items.clear();
+				else
+					slots[i].items.release();
+			}
+		}
+
+		size_t get_size() const noexcept {
+			size_t total = 0;
+			for (size_t i = 0; i < slot_count; ++i)
+				total += slots[i].items.get_size();
+			return total;
+		}
+
+		size_t get_slot_count() const noexcept { return slot_count; }
+
+	private:
+		/// Copies the locals to `dst` at `offsets`; thread t copies elements [t*total/n, (t+1)*total/n).
+		void copy_pieces(T* dst, const vector<size_t>& offsets, unsigned requested) const {
+			const size_t total = offsets[slot_count];
+			const unsigned threads = detail::parallel_thread_count(requested, total * sizeof(T),
+				detail::collector_parallel_min_bytes, detail::collector_bytes_per_thread);
+			detail::parallel_run(threads, [&](unsigned t) {
+				const size_t begin = total * t / threads;
+				const size_t end = total * (t + 1) / threads;
+				// First slot holding element `begin`: offsets are sorted, so binary search.
+				size_t lo = 0, hi = slot_count;
+				while (hi - lo > 1) {
+					const size_t mid = (lo + hi) / 2;
+					if (offsets[mid] <= begin) lo = mid;
+					else hi = mid;
+				}
+				for (size_t i = lo; i < slot_count && offsets[i] < end; ++i) {
+					const size_t from = offsets[i] > begin ? offsets[i] : begin;
+					const size_t to = offsets[i + 1] < end ? offsets[i + 1] : end;
+					if (from < to)
+						detail::copy_elements(dst + from, slots[i].items.get_data() + (from - offsets[i]), to - from);
+				}
+			});
+		}
+	};
+}
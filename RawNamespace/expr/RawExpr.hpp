@@ -0,0 +1,483 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+#include "RawNamespace/vector/expression_fwd.hpp"
+#include "RawNamespace/span/RawSpan.hpp"
+
+/************************************************************************
+* Lazy element-wise expressions over trivial numeric vectors and spans.
+*
+*     raw::vector<float> a, b, d;
+*     raw::vector<float> c = a * b + d;          // one loop, no temporaries
+*     c = raw::where(a > b, a - b, 0.0f);
+*     float dot = raw::sum(a * b);
+*
+* Arithmetic, comparisons and `where` on raw::vector<T> / raw::span<T>
+* (T arithmetic) build a small tree of nodes that only hold pointers.
+* Nothing runs until the tree is assigned to a vector (or `raw::assign`
+* into a span) or reduced; then a single loop reads every operand once
+* and the compiler vectorizes it. Scalars broadcast.
+*
+* Operands must have equal lengths (std::invalid_argument otherwise).
+* Reading the destination itself is fine (`c = c * 2 + a`); an operand
+* that overlaps the destination at another offset is evaluated into a
+* temporary first. `==` and `!=` keep their usual meaning; element-wise
+* equality is `raw::equal` / `raw::not_equal`.
+***********************************************************************/
+
+namespace raw {
+	/*********************************************************************
+	 * CRTP BASE: `expression<E>`
+	 *
+	 * Every node derives from it, so the operators below are found by ADL
+	 * for nodes too. A node provides `value_type`, `get_size()`,
+	 * `eval(i)` and `aliases(begin, end, same_start_ok)`.
+	 *********************************************************************/
+	template<typename E>
+	struct expression : detail::expression_tag {
+		const E& self() const noexcept { return static_cast<const E&>(*this); }
+	};
+
+	namespace detail {
+		/// Length of a scalar operand: matches anything.
+		constexpr size_t broadcast = size_t(-1);
+
+		inline bool ranges_overlap(const void* a_begin, const void* a_end, const void* b_begin, const void* b_end) noexcept {
+			uintptr_t ab = reinterpret_cast<uintptr_t>(a_begin), ae = reinterpret_cast<uintptr_t>(a_end);
+			uintptr_t bb = reinterpret_cast<uintptr_t>(b_begin), be = reinterpret_cast<uintptr_t>(b_end);
+			return ab < be && bb < ae;
+		}
+
+		inline size_t combined_size(size_t a, size_t b) {
+			if (a == broadcast)
+				return b;
+			if (b == broadcast || a == b)
+				return a;
+			throw_invalid_argument("expression operands differ in size");
+		}
+
+		/*********************************************************************
+		 * LEAVES: `terminal<T>`, `scalar<T>`
+		 *
+		 * `terminal` - a vector's or span's elements, by pointer.
+		 * `scalar`   - one value repeated for every index.
+		 *********************************************************************/
+		template<typename T>
+		class terminal : public expression<terminal<T>> {
+		private:
+			const T* ptr;
+			size_t count;
+		public:
+			using value_type = T;
+			terminal(const T* ptr_, size_t count_) noexcept : ptr(ptr_), count(count_) {}
+			size_t get_size() const noexcept { return count; }
+			T eval(size_t i) const noexcept { return ptr[i]; }
+			bool aliases(const void* begin, const void* end, bool same_start_ok) const noexcept {
+				if (!count || !ranges_overlap(ptr, ptr + count, begin, end))
+					return false;
+				return !(same_start_ok && static_cast<const void*>(ptr) == begin);
+			}
+		};
+
+		template<typename T>
+		class scalar : public expression<scalar<T>> {
+		private:
+			T value;
+		public:
+			using value_type = T;
+			explicit scalar(T value_) noexcept : value(value_) {}
+			size_t get_size() const noexcept { return broadcast; }
+			T eval(size_t) const noexcept { return value; }
+			bool aliases(const void*, const void*, bool) const noexcept { return false; }
+		};
+
+		/*********************************************************************
+		 * NODES: `unary<Op, E>`, `binary<Op, L, R>`, `select<C, A, B>`
+		 *
+		 * Hold their children by value (they are a few pointers each) and
+		 * check at construction that the lengths agree.
+		 *********************************************************************/
+		template<typename Op, typename E>
+		class unary : public expression<unary<Op, E>> {
+		private:
+			E e;
+		public:
+			using value_type = decltype(Op::apply(std::declval<typename E::value_type>()));
+			explicit unary(const E& e_) : e(e_) {}
+			size_t get_size() const noexcept { return e.get_size(); }
+			value_type eval(size_t i) const noexcept { return Op::apply(e.eval(i)); }
+			bool aliases(const void* begin, const void* end, bool same_start_ok) const noexcept {
+				return e.aliases(begin, end, same_start_ok);
+			}
+		};
+
+		template<typename Op, typename L, typename R>
+		class binary : public expression<binary<Op, L, R>> {
+		private:
+			L l;
+			R r;
+			size_t count;
+		public:
+			using value_type = decltype(Op::apply(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+			binary(const L& l_, const R& r_) : l(l_), r(r_), count(combined_size(l_.get_size(), r_.get_size())) {}
+			size_t get_size() const noexcept { return count; }
+			value_type eval(size_t i) const noexcept { return Op::apply(l.eval(i), r.eval(i)); }
+			bool aliases(const void* begin, const void* end, bool same_start_ok) const noexcept {
+				return l.aliases(begin, end, same_start_ok) || r.aliases(begin, end, same_start_ok);
+			}
+		};
+
+		template<typename C, typename A, typename B>
+		class select : public expression<select<C, A, B>> {
+		private:
+			C c;
+			A a;
+			B b;
+			size_t count;
+		public:
+			using value_type = std::common_type_t<typename A::value_type, typename B::value_type>;
+			select(const C& c_, const A& a_, const B& b_)
+				: c(c_), a(a_), b(b_), count(combined_size(c_.get_size(), combined_size(a_.get_size(), b_.get_size()))) {}
+			size_t get_size() const noexcept { return count; }
+			// Both sides are evaluated so the loop stays branch-free (a blend).
+			value_type eval(size_t i) const noexcept {
+				value_type x = a.eval(i);
+				value_type y = b.eval(i);
+				return c.eval(i) ? x : y;
+			}
+			bool aliases(const void* begin, const void* end, bool same_start_ok) const noexcept {
+				return c.aliases(begin, end, same_start_ok) || a.aliases(begin, end, same_start_ok) || b.aliases(begin, end, same_start_ok);
+			}
+		};
+
+		/*********************************************************************
+		 * OPERATIONS
+		 *********************************************************************/
+		struct op_plus { template<typename A, typename B> static auto apply(A a, B b) noexcept { return a + b; } };
+		struct op_minus { template<typename A, typename B> static auto apply(A a, B b) noexcept { return a - b; } };
+		struct op_multiplies { template<typename A, typename B> static auto apply(A a, B b) noexcept { return a * b; } };
+		struct op_divides { template<typename A, typename B> static auto apply(A a, B b) noexcept { return a / b; } };
+		struct op_less { template<typename A, typename B> static bool apply(A a, B b) noexcept { return a < b; } };
+		struct op_less_equal { template<typename A, typename B> static bool apply(A a, B b) noexcept { return a <= b; } };
+		struct op_greater { template<typename A, typename B> static bool apply(A a, B b) noexcept { return a > b; } };
+		struct op_greater_equal { template<typename A, typename B> static bool apply(A a, B b) noexcept { return a >= b; } };
+		struct op_equal { template<typename A, typename B> static bool apply(A a, B b) noexcept { return a == b; } };
+		struct op_not_equal { template<typename A, typename B> static bool apply(A a, B b) noexcept { return a != b; } };
+		struct op_minimum { template<typename A, typename B> static auto apply(A a, B b) noexcept { return b < a ? b : a; } };
+		struct op_maximum { template<typename A, typename B> static auto apply(A a, B b) noexcept { return a < b ? b : a; } };
+		struct op_negate { template<typename A> static auto apply(A a) noexcept { return -a; } };
+		struct op_abs { template<typename A> static A apply(A a) noexcept { return a < A(0) ? A(-a) : a; } };
+		struct op_nonzero { template<typename A> static bool apply(A a) noexcept { return a != A(0); } };
+		struct op_sqrt { template<typename A> static auto apply(A a) noexcept { return std::sqrt(a); } };
+
+		/*********************************************************************
+		 * OPERAND CONVERSION: `to_operand(x)`
+		 *
+		 * Expressions pass through, trivial arithmetic vectors and spans
+		 * become terminals, arithmetic values become scalars. Anything else
+		 * is not an operand, so the operators stay out of overload sets.
+		 *********************************************************************/
+		template<typename E>
+		E to_operand(const expression<E>& e) { return e.self(); }
+
+		template<typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+		terminal<T> to_operand(const vector_triv<T>& v) noexcept { return terminal<T>(v.get_data(), v.get_size()); }
+
+		template<typename T, typename = std::enable_if_t<std::is_arithmetic<std::remove_const_t<T>>::value>>
+		terminal<std::remove_const_t<T>> to_operand(span<T> s) noexcept { return terminal<std::remove_const_t<T>>(s.get_data(), s.get_size()); }
+
+		template<typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+		scalar<T> to_operand(T value) noexcept { return scalar<T>(value); }
+
+		template<typename X>
+		using operand_t = decltype(to_operand(std::declval<const X&>()));
+
+		template<typename X, typename = void>
+		struct is_operand : std::false_type {};
+		template<typename X>
+		struct is_operand<X, std::void_t<operand_t<X>>> : std::true_type {};
+
+		/// An operand that is not a plain number (at least one of these per operator).
+		template<typename X>
+		struct is_array_operand : std::integral_constant<bool, is_operand<X>::value && !std::is_arithmetic<X>::value> {};
+
+		template<typename L, typename R>
+		using enable_binary = std::enable_if_t<is_operand<L>::value && is_operand<R>::value &&
+			(is_array_operand<L>::value || is_array_operand<R>::value)>;
+
+		template<typename X>
+		using enable_unary = std::enable_if_t<is_array_operand<X>::value>;
+
+		template<typename Op, typename L, typename R>
+		binary<Op, operand_t<L>, operand_t<R>> make_binary(const L& l, const R& r) {
+			return binary<Op, operand_t<L>, operand_t<R>>(to_operand(l), to_operand(r));
+		}
+
+		template<typename Op, typename X>
+		unary<Op, operand_t<X>> make_unary(const X& x) {
+			return unary<Op, operand_t<X>>(to_operand(x));
+		}
+
+		/*********************************************************************
+		 * EVALUATION: `evaluate_into(out, expr, n)`, `assign_expression(dst, expr)`
+		 *
+		 * `evaluate_into` is the one loop everything ends in. The expression is
+		 * copied to a local so its pointers live in registers, and aliasing was
+		 * ruled out by the caller, hence RAW_IVDEP. The body runs in blocks of
+		 * 16 with a fixed trip count, which GCC vectorizes even at -O2.
+		 *********************************************************************/
+		template<typename T, typename E>
+		void evaluate_into(T* out, const E& expr, size_t n) noexcept {
+			const E e = expr;
+			size_t i = 0;
+			for (; i + 16 <= n; i += 16) {
+				RAW_IVDEP
+				for (size_t k = 0; k < 16; ++k)
+					out[i + k] = static_cast<T>(e.eval(i + k));
+			}
+			for (; i < n; ++i)
+				out[i] = static_cast<T>(e.eval(i));
+		}
+
+		template<typename Vector, typename Expr>
+		void assign_expression(Vector& dst, const Expr& expr) {
+			using T = typename Vector::value_type;
+			size_t n = expr.get_size();
+			const T* begin = dst.get_data();
+			const T* end = begin + dst.get_size();
+			if (expr.aliases(begin, end, n == dst.get_size())) {
+				vector_triv<T> fresh(n);
+				evaluate_into(fresh.get_data(), expr, n);
+				dst = std::move(fresh);
+				return;
+			}
+			dst.resize(n);
+			evaluate_into(dst.get_data(), expr, n);
+		}
+	}
+
+	/*********************************************************************
+	 * ARITHMETIC OPERATORS: `+`, `-`, `*`, `/`, unary `-`
+	 *
+	 * At least one side must be a vector, span or expression; the other
+	 * may be a plain number. Results follow the usual arithmetic
+	 * conversions (int vector * 0.5 is a double expression).
+	 *********************************************************************/
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto operator+(const L& l, const R& r) { return detail::make_binary<detail::op_plus>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto operator-(const L& l, const R& r) { return detail::make_binary<detail::op_minus>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto operator*(const L& l, const R& r) { return detail::make_binary<detail::op_multiplies>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto operator/(const L& l, const R& r) { return detail::make_binary<detail::op_divides>(l, r); }
+
+	template<typename X, typename = detail::enable_unary<X>>
+	auto operator-(const X& x) { return detail::make_unary<detail::op_negate>(x); }
+
+	/*********************************************************************
+	 * COMPARISONS: `<`, `<=`, `>`, `>=`, `equal()`, `not_equal()`
+	 *
+	 * Element-wise, producing a `bool` expression for `where` and the
+	 * reductions (or to store into a raw::vector<bool>/<uint8_t>).
+	 *********************************************************************/
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto operator<(const L& l, const R& r) { return detail::make_binary<detail::op_less>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto operator<=(const L& l, const R& r) { return detail::make_binary<detail::op_less_equal>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto operator>(const L& l, const R& r) { return detail::make_binary<detail::op_greater>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto operator>=(const L& l, const R& r) { return detail::make_binary<detail::op_greater_equal>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto equal(const L& l, const R& r) { return detail::make_binary<detail::op_equal>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto not_equal(const L& l, const R& r) { return detail::make_binary<detail::op_not_equal>(l, r); }
+
+	/*********************************************************************
+	 * ELEMENT-WISE FUNCTIONS: `minimum()`, `maximum()`, `abs()`, `sqrt()`, `where()`
+	 *
+	 * `where(cond, a, b)` - `cond[i] ? a[i] : b[i]`; `a` and `b` may be
+	 *                       numbers. Both sides are evaluated for every
+	 *                       element, so `where(not_equal(d, 0), n / d, 0)`
+	 *                       is no guard: on integers it still divides by
+	 *                       zero (undefined behaviour). Guard the operand
+	 *                       instead: `n / where(not_equal(d, 0), d, 1)`.
+	 *********************************************************************/
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto minimum(const L& l, const R& r) { return detail::make_binary<detail::op_minimum>(l, r); }
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto maximum(const L& l, const R& r) { return detail::make_binary<detail::op_maximum>(l, r); }
+
+	template<typename X, typename = detail::enable_unary<X>>
+	auto abs(const X& x) { return detail::make_unary<detail::op_abs>(x); }
+
+	template<typename X, typename = detail::enable_unary<X>>
+	auto sqrt(const X& x) { return detail::make_unary<detail::op_sqrt>(x); }
+
+	template<typename C, typename A, typename B,
+		typename = std::enable_if_t<detail::is_array_operand<C>::value && detail::is_operand<A>::value && detail::is_operand<B>::value>>
+	auto where(const C& cond, const A& a, const B& b) {
+		using node = detail::select<detail::operand_t<C>, detail::operand_t<A>, detail::operand_t<B>>;
+		return node(detail::to_operand(cond), detail::to_operand(a), detail::to_operand(b));
+	}
+
+	/*********************************************************************
+	 * MATERIALIZING: `eval(x)`, `assign(dst, x)`
+	 *
+	 * `eval`   - a new raw::vector holding the result.
+	 * `assign` - writes into an existing span of the same length.
+	 *
+	 * Throws: std::invalid_argument if the lengths differ, std::bad_alloc.
+	 *********************************************************************/
+	template<typename X, typename = detail::enable_unary<X>>
+	auto eval(const X& x) {
+		using value_type = typename detail::operand_t<X>::value_type;
+		return vector<value_type>(detail::to_operand(x));
+	}
+
+	template<typename T, typename X, typename = detail::enable_unary<X>>
+	void assign(span<T> dst, const X& x) {
+		detail::operand_t<X> e = detail::to_operand(x);
+		size_t n = e.get_size();
+		if (n != dst.get_size())
+			detail::throw_invalid_argument("expression operands differ in size");
+		if (e.aliases(dst.get_data(), dst.get_data() + n, true)) {
+			vector_triv<T> fresh(n);
+			detail::evaluate_into(fresh.get_data(), e, n);
+			detail::copy_elements(dst.get_data(), fresh.get_data(), n);
+			return;
+		}
+		detail::evaluate_into(dst.get_data(), e, n);
+	}
+
+	/*********************************************************************
+	 * REDUCTIONS: `sum()`, `dot()`, `min_value()`, `max_value()`, `count()`, `any()`, `all()`
+	 *
+	 * One pass, no temporaries. `sum` keeps 8 partial sums so the loop
+	 * vectorizes; for floating point the result can differ from a strict
+	 * left-to-right sum in the last bits. Sums of bool count the true ones.
+	 *
+	 * Throws: std::out_of_range from `min_value`/`max_value` of an empty operand.
+	 *********************************************************************/
+	template<typename X, typename = detail::enable_unary<X>>
+	auto sum(const X& x) {
+		const detail::operand_t<X> e = detail::to_operand(x);
+		using value_type = typename detail::operand_t<X>::value_type;
+		using acc_type = std::conditional_t<std::is_same<value_type, bool>::value, size_t, decltype(value_type() + value_type())>;
+		const size_t n = e.get_size();
+		acc_type lanes[8] = {};
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			for (size_t k = 0; k < 8; ++k)
+				lanes[k] += static_cast<acc_type>(e.eval(i + k));
+		}
+		acc_type total = acc_type();
+		for (size_t k = 0; k < 8; ++k)
+			total += lanes[k];
+		for (; i < n; ++i)
+			total += static_cast<acc_type>(e.eval(i));
+		return total;
+	}
+
+	template<typename L, typename R, typename = detail::enable_binary<L, R>>
+	auto dot(const L& l, const R& r) { return sum(l * r); }
+
+	template<typename X, typename = detail::enable_unary<X>>
+	size_t count(const X& x) {
+		return static_cast<size_t>(sum(detail::make_unary<detail::op_nonzero>(x)));
+	}
+
+	template<typename X, typename = detail::enable_unary<X>>
+	auto min_value(const X& x) {
+		const detail::operand_t<X> e = detail::to_operand(x);
+		using value_type = typename detail::operand_t<X>::value_type;
+		const size_t n = e.get_size();
+		if (n == 0)
+			detail::throw_out_of_range("min_value of an empty expression");
+		value_type lanes[8];
+		for (size_t k = 0; k < 8; ++k)
+			lanes[k] = e.eval(0);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			for (size_t k = 0; k < 8; ++k)
+				lanes[k] = detail::op_minimum::apply(lanes[k], e.eval(i + k));
+		}
+		value_type best = lanes[0];
+		for (size_t k = 1; k < 8; ++k)
+			best = detail::op_minimum::apply(best, lanes[k]);
+		for (; i < n; ++i)
+			best = detail::op_minimum::apply(best, e.eval(i));
+		return best;
+	}
+
+	template<typename X, typename = detail::enable_unary<X>>
+	auto max_value(const X& x) {
+		const detail::operand_t<X> e = detail::to_operand(x);
+		using value_type = typename detail::operand_t<X>::value_type;
+		const size_t n = e.get_size();
+		if (n == 0)
+			detail::throw_out_of_range("max_value of an empty expression");
+		value_type lanes[8];
+		for (size_t k = 0; k < 8; ++k)
+			lanes[k] = e.eval(0);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			for (size_t k = 0; k < 8; ++k)
+				lanes[k] = detail::op_maximum::apply(lanes[k], e.eval(i + k));
+		}
+		value_type best = lanes[0];
+		for (size_t k = 1; k < 8; ++k)
+			best = detail::op_maximum::apply(best, lanes[k]);
+		for (; i < n; ++i)
+			best = detail::op_maximum::apply(best, e.eval(i));
+		return best;
+	}
+
+	/// Any element non-zero / true; stops after the first block of 256 that has one.
+	template<typename X, typename = detail::enable_unary<X>>
+	bool any(const X& x) {
+		const detail::operand_t<X> e = detail::to_operand(x);
+		const size_t n = e.get_size();
+		for (size_t block = 0; block < n; block += 256) {
+			size_t stop = n - block < 256 ? n : block + 256;
+			bool hit = false;
+			for (size_t i = block; i < stop; ++i)
+				hit |= static_cast<bool>(e.eval(i));
+			if (hit)
+				return true;
+		}
+		return false;
+	}
+
+	/// Every element non-zero / true; true for an empty operand.
+	template<typename X, typename = detail::enable_unary<X>>
+	bool all(const X& x) {
+		const detail::operand_t<X> e = detail::to_operand(x);
+		const size_t n = e.get_size();
+		for (size_t block = 0; block < n; block += 256) {
+			size_t stop = n - block < 256 ? n : block + 256;
+			bool every = true;
+			for (size_t i = block; i < stop; ++i)
+				every &= static_cast<bool>(e.eval(i));
+			if (!every)
+				return false;
+		}
+		return true;
+	}
+}
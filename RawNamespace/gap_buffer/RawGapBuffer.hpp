@@ -0,0 +1,507 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/vector/memory_ops.hpp"
+#include "RawNamespace/span/RawSpan.hpp"
+
+/************************************************************************
+* raw::gap_buffer<T> - sequence with a movable hole at the cursor.
+*
+* One buffer holds `[front | gap | back]`. Inserting or erasing at the
+* cursor only moves the gap edges, so clustered edits cost O(1). Moving
+* the cursor shifts the elements between the old and the new position
+* across the gap, O(distance). Growth relocates both halves into a buffer
+* twice as large and puts the new gap at the cursor.
+*
+* Growth and copies use the vector's relocation helpers (memory_ops.hpp):
+* memcpy for trivial types, move_if_noexcept construct/destroy loops
+* otherwise. Cursor moves are a memmove for trivial types; other types
+* step one element at a time across the gap.
+***********************************************************************/
+
+namespace raw {
+	template<typename T>
+	class gap_buffer {
+	private:
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `data`      - Buffer of `capacity` slots; `[0, gap_begin)` and `[gap_end, capacity)` are live.
+		 * `gap_begin` - Cursor position, first slot of the gap.
+		 * `gap_end`   - One past the last slot of the gap.
+		 * `capacity`  - Number of allocated slots.
+		 *************************************************************************************************/
+		T* data = nullptr;
+		size_t gap_begin = 0;
+		size_t gap_end = 0;
+		size_t capacity = 0;
+
+		static constexpr bool trivial = myis_trivial<T>::value;
+
+		size_t back_size() const noexcept { return capacity - gap_end; }
+
+		/*************************************************************************************
+		 * PRIVATE FUNCTIONS: `shift_left(pos)`, `shift_right(pos)`
+		 *
+		 * `shift_left`  - moves `[pos, gap_begin)` to the far side of the gap.
+		 * `shift_right` - moves the first elements after the gap in front of it
+		 *                 until `gap_begin == pos`.
+		 * The non-trivial versions step one element at a time and update the gap
+		 * after each step, so a throwing move leaves a valid (partly moved) buffer.
+		 *************************************************************************************/
+
+		void shift_left(size_t pos) {
+			if constexpr (trivial) {
+				size_t count = gap_begin - pos;
+				detail::move_elements(data + gap_end - count, data + pos, count);
+				gap_end -= count;
+				gap_begin = pos;
+			}
+			else {
+				while (gap_begin > pos) {
+					detail::construct(data + gap_end - 1, std::move(data[gap_begin - 1]));
+					detail::destroy(data + gap_begin - 1);
+					--gap_begin;
+					--gap_end;
+				}
+			}
+		}
+
+		void shift_right(size_t pos) {
+			if constexpr (trivial) {
+				size_t count = pos - gap_begin;
+				detail::move_elements(data + gap_begin, data + gap_end, count);
+				gap_end += count;
+				gap_begin = pos;
+			}
+			else {
+				while (gap_begin < pos) {
+					detail::construct(data + gap_begin, std::move(data[gap_end]));
+					detail::destroy(data + gap_end);
+					++gap_begin;
+					++gap_end;
+				}
+			}
+		}
+
+		/*************************************************************************************
+		 * PRIVATE FUNCTIONS: `grown_capacity()`, `try_grow()`
+		 *
+		 * `grown_capacity(current, required)` - doubles `current` until it is at least
+		 *                                       `required`, 0 past `max_size()`.
+		 * `try_grow(required)`                - makes room for `required` elements in total,
+		 *                                       the gap stays at the cursor. Leaves the
+		 *                                       buffer untouched if the allocation or an
+		 *                                       element copy fails.
+		 *************************************************************************************/
+
+		static size_t grown_capacity(size_t current, size_t required) noexcept {
+			size_t new_capacity = current ? current : 8;
+			while (new_capacity < required) {
+				if (new_capacity > max_size() / 2)
+					return required <= max_size() ? max_size() : 0;
+				new_capacity *= 2;
+			}
+			return new_capacity;
+		}
+
+		RAW_COLD status try_grow(size_t required) {
+			if (required <= capacity)
+				return status::ok;
+			size_t new_capacity = grown_capacity(capacity, required);
+			if (!new_capacity)
+				return status::length_error;
+			T* new_data = detail::allocate<T>(new_capacity);
+			if (!new_data)
+				return status::out_of_memory;
+
+			size_t back = back_size();
+			size_t new_gap_end = new_capacity - back;
+			RAW_TRY {
+				detail::move_construct_elements(new_data, data, gap_begin);
+			}
+			RAW_CATCH_ALL {
+				detail::deallocate(new_data, new_capacity);
+				RAW_RETHROW;
+			}
+			RAW_TRY {
+				detail::move_construct_elements(new_data + new_gap_end, data + gap_end, back);
+			}
+			RAW_CATCH_ALL {
+				detail::destroy_elements(new_data, gap_begin);
+				detail::deallocate(new_data, new_capacity);
+				RAW_RETHROW;
+			}
+			detail::destroy_elements(data, gap_begin);
+			detail::destroy_elements(data + gap_end, back);
+			if (data) detail::deallocate(data, capacity);
+			data = new_data;
+			gap_end = new_gap_end;
+			capacity = new_capacity;
+			return status::ok;
+		}
+
+		/// Maps a logical index to its slot, skipping the gap.
+		size_t slot(size_t index) const noexcept {
+			return index < gap_begin ? index : index + (gap_end - gap_begin);
+		}
+
+		template<typename Arg>
+		status insert_value(Arg&& arg) {
+			if (RAW_UNLIKELY(gap_begin == gap_end)) {
+				status s = try_grow(capacity + 1);
+				if (s != status::ok)
+					return s;
+			}
+			detail::construct(data + gap_begin, std::forward<Arg>(arg));
+			++gap_begin;
+			return status::ok;
+		}
+
+	public:
+		using value_type = T;
+
+		/*********************************************************************
+		 * CONSTRUCTORS: `gap_buffer()`, `gap_buffer(size_t reserve_)`
+		 *
+		 * Default constructor does not allocate.
+		 * `gap_buffer(reserve_)` starts with an empty buffer and a gap of
+		 * `reserve_` slots.
+		 *
+		 * Throws: std::bad_alloc (or the allocation failure handler) if the
+		 *         allocation fails, std::length_error past max_size().
+		 *********************************************************************/
+
+		gap_buffer() noexcept = default;
+
+		explicit gap_buffer(size_t reserve_) {
+			reserve(reserve_);
+		}
+
+		/*********************************************************************
+		 * COPY CONSTRUCTOR: `gap_buffer(const gap_buffer& other)`
+		 *
+		 * Copies the elements into a buffer of the same capacity, keeping the
+		 * gap and the cursor where `other` has them.
+		 *
+		 * Throws: allocation failure, or exceptions from T's copy constructor
+		 *         (nothing is leaked).
+		 *********************************************************************/
+
+		gap_buffer(const gap_buffer& other) {
+			if (!other.capacity)
+				return;
+			T* new_data = detail::allocate<T>(other.capacity);
+			if (!new_data) detail::alloc_failure(sizeof(T) * other.capacity);
+			RAW_TRY {
+				detail::copy_construct_elements(new_data, other.data, other.gap_begin);
+			}
+			RAW_CATCH_ALL {
+				detail::deallocate(new_data, other.capacity);
+				RAW_RETHROW;
+			}
+			RAW_TRY {
+				detail::copy_construct_elements(new_data + other.gap_end, other.data + other.gap_end, other.back_size());
+			}
+			RAW_CATCH_ALL {
+				detail::destroy_elements(new_data, other.gap_begin);
+				detail::deallocate(new_data, other.capacity);
+				RAW_RETHROW;
+			}
+			data = new_data;
+			gap_begin = other.gap_begin;
+			gap_end = other.gap_end;
+			capacity = other.capacity;
+		}
+
+		/*********************************************************************
+		 * MOVE CONSTRUCTOR: `gap_buffer(gap_buffer&& other) noexcept`
+		 *
+		 * Takes over `other`'s buffer. `other` becomes empty with capacity 0.
+		 *********************************************************************/
+
+		gap_buffer(gap_buffer&& other) noexcept
+			: data(other.data), gap_begin(other.gap_begin), gap_end(other.gap_end), capacity(other.capacity) {
+			other.data = nullptr;
+			other.gap_begin = other.gap_end = other.capacity = 0;
+		}
+
+		/*********************************************************************
+		 * ASSIGNMENT: `operator=(const gap_buffer&)`, `operator=(gap_buffer&&)`
+		 *
+		 * Copy assignment builds the copy first (strong guarantee).
+		 * Move assignment frees the current elements and takes `other`'s buffer.
+		 *********************************************************************/
+
+		gap_buffer& operator=(const gap_buffer& other) {
+			if (this != &other) {
+				gap_buffer copy(other);
+				swap(copy);
+			}
+			return *this;
+		}
+
+		gap_buffer& operator=(gap_buffer&& other) noexcept {
+			if (this != &other) {
+				gap_buffer stolen(std::move(other));
+				swap(stolen);
+			}
+			return *this;
+		}
+
+		~gap_buffer() {
+			clear();
+			if (data) detail::deallocate(data, capacity);
+		}
+
+		/*********************************************************************
+		 * SIZE FUNCTIONS: `get_size()`, `get_capacity()`, `gap_size()`, `cursor()`, `empty()`, `max_size()`
+		 *
+		 * `cursor()` is the logical index the next insert lands at.
+		 *********************************************************************/
+
+		size_t get_size() const noexcept { return capacity - (gap_end - gap_begin); }
+		size_t get_capacity() const noexcept { return capacity; }
+		size_t gap_size() const noexcept { return gap_end - gap_begin; }
+		size_t cursor() const noexcept { return gap_begin; }
+		bool empty() const noexcept { return get_size() == 0; }
+
+		static constexpr size_t max_size() noexcept {
+			return size_t(std::numeric_limits<ptrdiff_t>::max()) / sizeof(T);
+		}
+
+		/*********************************************************************
+		 * INDEXING FUNCTIONS: `at()`, `operator[]` (const and non-const)
+		 *
+		 * Logical indices, the gap is skipped.
+		 * `at()` - with bounds checking, throws `std::out_of_range`.
+		 * `operator[]` - no bounds checking.
+		 *********************************************************************/
+
+		T& at(size_t index) {
+			if (index >= get_size())
+				detail::throw_out_of_range("Index out of range");
+			return data[slot(index)];
+		}
+
+		const T& at(size_t index) const {
+			if (index >= get_size())
+				detail::throw_out_of_range("Index out of range");
+			return data[slot(index)];
+		}
+
+		T& operator [] (size_t index) noexcept { return data[slot(index)]; }
+		const T& operator [] (size_t index) const noexcept { return data[slot(index)]; }
+
+		/*********************************************************************
+		 * CURSOR FUNCTIONS: `move_cursor(pos)`, `try_move_cursor(pos)`
+		 *
+		 * Moves the gap so that the next insert lands at logical index `pos`.
+		 * Only the elements between the old and the new cursor move: O(distance).
+		 * If a move constructor throws, the cursor stops part of the way.
+		 *
+		 * Throws: std::out_of_range if `pos` > get_size().
+		 *********************************************************************/
+
+		void move_cursor(size_t pos) {
+			detail::raise_if(try_move_cursor(pos), 0);
+		}
+
+		status try_move_cursor(size_t pos) {
+			if (pos > get_size())
+				return status::out_of_range;
+			if (gap_begin == gap_end) {
+				// Nothing to move across an empty gap.
+				gap_begin = gap_end = pos;
+			}
+			else if (pos < gap_begin)
+				shift_left(pos);
+			else if (pos > gap_begin)
+				shift_right(pos);
+			return status::ok;
+		}
+
+		/*********************************************************************
+		 * INSERT FUNCTIONS: `insert(value)`, `emplace(args...)`, `try_insert(value)`
+		 *
+		 * Constructs the element at the cursor and advances the cursor past it,
+		 * like typing. Amortized O(1); `value` may refer into this buffer.
+		 *
+		 * Throws: allocation failure, std::length_error past max_size(),
+		 *         exceptions from T's constructor.
+		 *********************************************************************/
+
+		void insert(const T& value) {
+			if (RAW_UNLIKELY(gap_begin == gap_end)) {
+				T tmp(value);
+				detail::raise_if(insert_value(std::move(tmp)), sizeof(T) * capacity * 2);
+				return;
+			}
+			detail::construct(data + gap_begin, value);
+			++gap_begin;
+		}
+
+		void insert(T&& value) {
+			if (RAW_UNLIKELY(gap_begin == gap_end)) {
+				T tmp(std::move(value));
+				detail::raise_if(insert_value(std::move(tmp)), sizeof(T) * capacity * 2);
+				return;
+			}
+			detail::construct(data + gap_begin, std::move(value));
+			++gap_begin;
+		}
+
+		template<typename... Args>
+		T& emplace(Args&&... args) {
+			if (RAW_UNLIKELY(gap_begin == gap_end))
+				detail::raise_if(insert_value(T(std::forward<Args>(args)...)), sizeof(T) * capacity * 2);
+			else
+				detail::construct(data + gap_begin++, std::forward<Args>(args)...);
+			return data[gap_begin - 1];
+		}
+
+		status try_insert(const T& value) {
+			if (RAW_UNLIKELY(gap_begin == gap_end)) {
+				T tmp(value);
+				return insert_value(std::move(tmp));
+			}
+			detail::construct(data + gap_begin, value);
+			++gap_begin;
+			return status::ok;
+		}
+
+		status try_insert(T&& value) {
+			if (RAW_UNLIKELY(gap_begin == gap_end)) {
+				T tmp(std::move(value));
+				return insert_value(std::move(tmp));
+			}
+			detail::construct(data + gap_begin, std::move(value));
+			++gap_begin;
+			return status::ok;
+		}
+
+		/*********************************************************************
+		 * INSERT AT POSITION: `insert(pos, value)`, `insert(pos, items)`
+		 *
+		 * Moves the cursor to `pos`, then inserts. The cursor ends up after
+		 * the inserted elements. `items` must not view this buffer.
+		 *
+		 * Throws: std::out_of_range if `pos` > get_size(), plus everything
+		 *         `insert(value)` throws.
+		 *********************************************************************/
+
+		void insert(size_t pos, const T& value) {
+			if (pos > get_size())
+				detail::throw_out_of_range("Index out of range");
+			T tmp(value);
+			move_cursor(pos);
+			insert(std::move(tmp));
+		}
+
+		void insert(size_t pos, span<const T> items) {
+			size_t count = items.get_size();
+			if (pos > get_size())
+				detail::throw_out_of_range("Index out of range");
+			if (count > max_size() - get_size())
+				detail::throw_length_error("Requested size exceeds max_size()");
+			if (count > gap_size())
+				detail::raise_if(try_grow(get_size() + count), sizeof(T) * (get_size() + count));
+			move_cursor(pos);
+			detail::copy_construct_elements(data + gap_begin, items.get_data(), count);
+			gap_begin += count;
+		}
+
+		/*********************************************************************
+		 * ERASE FUNCTIONS: `erase_before(count)`, `erase_after(count)`, `erase(pos, count)`
+		 *
+		 * `erase_before` - removes `count` elements left of the cursor (backspace).
+		 * `erase_after`  - removes `count` elements right of the cursor (delete).
+		 * `erase`        - moves the cursor to `pos` and erases after it.
+		 * The removed slots join the gap; nothing else moves.
+		 *
+		 * Throws: std::out_of_range if fewer than `count` elements are there.
+		 *********************************************************************/
+
+		void erase_before(size_t count = 1) {
+			if (count > gap_begin)
+				detail::throw_out_of_range("Index out of range");
+			gap_begin -= count;
+			detail::destroy_elements(data + gap_begin, count);
+		}
+
+		void erase_after(size_t count = 1) {
+			if (count > back_size())
+				detail::throw_out_of_range("Index out of range");
+			detail::destroy_elements(data + gap_end, count);
+			gap_end += count;
+		}
+
+		void erase(size_t pos, size_t count = 1) {
+			if (pos > get_size() || count > get_size() - pos)
+				detail::throw_out_of_range("Index out of range");
+			move_cursor(pos);
+			erase_after(count);
+		}
+
+		/*********************************************************************
+		 * CAPACITY FUNCTIONS: `reserve(n)`, `try_reserve(n)`, `clear()`
+		 *
+		 * `reserve` makes room for `n` elements without moving the cursor.
+		 * `clear` destroys all elements and keeps the buffer; the whole
+		 * buffer becomes the gap.
+		 *
+		 * Throws: allocation failure, std::length_error past max_size().
+		 *********************************************************************/
+
+		void reserve(size_t n) {
+			detail::raise_if(try_reserve(n), sizeof(T) * n);
+		}
+
+		status try_reserve(size_t n) {
+			if (n > max_size())
+				return status::length_error;
+			return try_grow(n);
+		}
+
+		void clear() noexcept {
+			detail::destroy_elements(data, gap_begin);
+			detail::destroy_elements(data + gap_end, back_size());
+			gap_begin = 0;
+			gap_end = capacity;
+		}
+
+		/*********************************************************************
+		 * CONTIGUOUS ACCESS: `make_contiguous()`, `is_contiguous()`
+		 *
+		 * `make_contiguous()` closes the gap by moving it to the end and returns
+		 * a span over all `get_size()` elements in order. The cursor ends up
+		 * at the end. The span stays valid until the next edit.
+		 *********************************************************************/
+
+		span<T> make_contiguous() {
+			move_cursor(get_size());
+			return span<T>(data, get_size());
+		}
+
+		bool is_contiguous() const noexcept {
+			return gap_end == capacity;
+		}
+
+		/*********************************************************************
+		 * SWAP FUNCTION: `swap(gap_buffer& other) noexcept`
+		 *********************************************************************/
+
+		void swap(gap_buffer& other) noexcept {
+			std::swap(data, other.data);
+			std::swap(gap_begin, other.gap_begin);
+			std::swap(gap_end, other.gap_end);
+			std::swap(capacity, other.capacity);
+		}
+	};
+}
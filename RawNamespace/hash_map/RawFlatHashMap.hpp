@@ -0,0 +1,924 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RAW_HASH_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/vector/memory_ops.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* raw::flat_hash_map<K, V> / raw::flat_hash_set<K> - open addressing in
+* the SwissTable layout.
+*
+* Slots live inline in one array; a parallel array of control bytes,
+* one per slot, says whether the slot is empty, deleted, or full, and
+* for full slots holds 7 bits of the key's hash (H2). A lookup hashes
+* once, loads a group of 16 control bytes (8 without SSE2), compares all
+* of them against H2 in one instruction and only touches the slots whose
+* byte matched; a group with an empty byte ends the probe. Groups are
+* probed triangularly over a power-of-two table.
+*
+*     ctrl: [c0 .. c(cap-1)] [sentinel] [clone of c0 .. c(G-2)]
+*
+* The clones let a group be loaded at any slot without wrapping. The
+* table is rehashed at 7/8 load. Erase leaves a tombstone unless no
+* probe can have passed the slot. Rehash relocates trivial slots with
+* memcpy and the rest with move_if_noexcept.
+*
+* Iterators and references are invalidated by any insert that rehashes.
+***********************************************************************/
+
+namespace raw {
+	/*********************************************************************
+	 * STRUCT: `flat_hash<K>`
+	 *
+	 * Default hasher: std::hash<K>, except for std::string, where it is
+	 * transparent, so `find("literal")` and `find(string_view)` do not
+	 * build a std::string.
+	 *********************************************************************/
+	template<typename K>
+	struct flat_hash : std::hash<K> {};
+
+	template<>
+	struct flat_hash<std::string> {
+		using is_transparent = void;
+		size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>()(s); }
+	};
+
+	namespace detail {
+		/*********************************************************************
+		 * CONTROL BYTES
+		 *
+		 * `ctrl_empty`    - 0b10000000, never held a value since the last rehash.
+		 * `ctrl_deleted`  - 0b11111110, tombstone.
+		 * `ctrl_sentinel` - 0b11111111, one past the last slot; iteration stops here.
+		 * full            - 0b0hhhhhhh, H2 of the slot's hash.
+		 *********************************************************************/
+		constexpr uint8_t ctrl_empty = 0x80;
+		constexpr uint8_t ctrl_deleted = 0xFE;
+		constexpr uint8_t ctrl_sentinel = 0xFF;
+
+		inline bool ctrl_is_full(uint8_t c) noexcept { return c < 0x80; }
+		inline bool ctrl_is_empty_or_deleted(uint8_t c) noexcept { return c >= 0x80 && c != ctrl_sentinel; }
+
+		inline unsigned hash_ctz(uint64_t word) noexcept {
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64(&index, word);
+			return static_cast<unsigned>(index);
+#else
+			return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+		}
+
+		inline unsigned hash_clz(uint64_t word) noexcept {
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanReverse64(&index, word);
+			return 63u - static_cast<unsigned>(index);
+#else
+			return static_cast<unsigned>(__builtin_clzll(word));
+#endif
+		}
+
+		/// Spreads a std::hash value (often the identity for integers) over all bits.
+		inline size_t hash_mix(size_t h) noexcept {
+			uint64_t x = static_cast<uint64_t>(h);
+			x ^= x >> 32;
+			x *= 0x9E3779B97F4A7C15ull;
+			x ^= x >> 29;
+			return static_cast<size_t>(x);
+		}
+
+		/*********************************************************************
+		 * CLASS: `probe_mask<Mask, Width, Shift>`
+		 *
+		 * Set of matching positions in a group: bit `i << Shift` stands for
+		 * slot `i`. Iterate with `lowest()` / `clear_lowest()`.
+		 *********************************************************************/
+		template<typename Mask, unsigned Width, unsigned Shift>
+		class probe_mask {
+		private:
+			Mask bits;
+		public:
+			explicit probe_mask(Mask bits_) noexcept : bits(bits_) {}
+			explicit operator bool() const noexcept { return bits != 0; }
+			unsigned lowest() const noexcept { return hash_ctz(bits) >> Shift; }
+			void clear_lowest() noexcept { bits &= bits - 1; }
+			unsigned trailing_zeros() const noexcept { return hash_ctz(bits) >> Shift; }
+			unsigned leading_zeros() const noexcept {
+				return (hash_clz(bits) - (64u - (Width << Shift))) >> Shift;
+			}
+		};
+
+		/*********************************************************************
+		 * STRUCT: `probe_group`
+		 *
+		 * `width` control bytes loaded from any position.
+		 * `match(h2)`                - full slots whose H2 equals `h2`.
+		 * `match_empty()`            - empty slots.
+		 * `match_empty_or_deleted()` - slots an insert may take.
+		 * `count_leading_empty_or_deleted()` - how far iteration may skip.
+		 *
+		 * SSE2 compares 16 bytes with `pcmpeqb` + `pmovmskb`; the portable
+		 * version treats 8 bytes as one 64-bit word (`match` can then report
+		 * a false positive, which the key comparison filters out).
+		 *********************************************************************/
+#ifdef RAW_HASH_SSE2
+		struct probe_group {
+			static constexpr size_t width = 16;
+			using mask = probe_mask<uint32_t, 16, 0>;
+
+			__m128i ctrl;
+
+			explicit probe_group(const uint8_t* p) noexcept : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+			mask match(uint8_t h2) const noexcept {
+				return mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl))));
+			}
+			mask match_empty() const noexcept {
+				return mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(ctrl_empty)), ctrl))));
+			}
+			mask match_empty_or_deleted() const noexcept {
+				// Signed compare: empty (-128) and deleted (-2) are below the sentinel (-1), full bytes are not.
+				return mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(ctrl_sentinel)), ctrl))));
+			}
+			unsigned count_leading_empty_or_deleted() const noexcept {
+				uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(ctrl_sentinel)), ctrl)));
+				return hash_ctz(uint64_t(bits) + 1);
+			}
+		};
+#else
+		struct probe_group {
+			static constexpr size_t width = 8;
+			using mask = probe_mask<uint64_t, 8, 3>;
+			static constexpr uint64_t lsbs = 0x0101010101010101ull;
+			static constexpr uint64_t msbs = 0x8080808080808080ull;
+
+			uint64_t ctrl;
+
+			explicit probe_group(const uint8_t* p) noexcept {
+				std::memcpy(&ctrl, p, sizeof(ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+				ctrl = __builtin_bswap64(ctrl);
+#endif
+			}
+
+			mask match(uint8_t h2) const noexcept {
+				uint64_t x = ctrl ^ (lsbs * h2);
+				return mask((x - lsbs) & ~x & msbs);
+			}
+			mask match_empty() const noexcept { return mask(ctrl & ~(ctrl << 6) & msbs); }
+			mask match_empty_or_deleted() const noexcept { return mask(ctrl & ~(ctrl << 7) & msbs); }
+			unsigned count_leading_empty_or_deleted() const noexcept {
+				constexpr uint64_t gaps = 0x00FEFEFEFEFEFEFEull;
+				return (hash_ctz(((~ctrl & (ctrl >> 7)) | gaps) + 1) + 7) >> 3;
+			}
+		};
+#endif
+
+		/// Triangular probing over groups: offsets 0, G, 3G, 6G, ... visit every group once.
+		class probe_seq {
+		private:
+			size_t mask;
+			size_t offset;
+			size_t index = 0;
+		public:
+			probe_seq(size_t hash, size_t mask_) noexcept : mask(mask_), offset(hash & mask_) {}
+			size_t get_offset() const noexcept { return offset; }
+			size_t slot(size_t i) const noexcept { return (offset + i) & mask; }
+			void next() noexcept {
+				index += probe_group::width;
+				offset = (offset + index) & mask;
+			}
+		};
+
+		/*********************************************************************
+		 * POLICIES: `map_policy<K, V>`, `set_policy<K>`
+		 *
+		 * What a slot holds and where its key is.
+		 *********************************************************************/
+		template<typename K, typename V>
+		struct map_policy {
+			using key_type = K;
+			using value_type = std::pair<const K, V>;
+			static constexpr bool mutable_elements = true;
+			static const K& key(const value_type& v) noexcept { return v.first; }
+		};
+
+		template<typename K>
+		struct set_policy {
+			using key_type = K;
+			using value_type = K;
+			static constexpr bool mutable_elements = false;
+			static const K& key(const value_type& v) noexcept { return v; }
+		};
+
+		template<typename Hash, typename Eq, typename = void>
+		struct is_transparent_pair : std::false_type {};
+		template<typename Hash, typename Eq>
+		struct is_transparent_pair<Hash, Eq, std::void_t<typename Hash::is_transparent, typename Eq::is_transparent>> : std::true_type {};
+
+		/*********************************************************************
+		 * CLASS: `flat_table<Policy, Hash, Eq>`
+		 *
+		 * The table shared by flat_hash_map and flat_hash_set: lookup,
+		 * insertion slots, erase, growth, iteration, copy and move.
+		 *********************************************************************/
+		template<typename Policy, typename Hash, typename Eq>
+		class flat_table {
+		public:
+			using key_type = typename Policy::key_type;
+			using value_type = typename Policy::value_type;
+			using hasher = Hash;
+			using key_equal = Eq;
+
+		private:
+			/*************************************************************************************************
+			 * PRIVATE MEMBERS:
+			 *
+			 * `ctrl_bytes`  - `capacity + width` control bytes: one per slot, the sentinel, then clones
+			 *                 of the first `width - 1` bytes. Empty while nothing is allocated.
+			 * `slots`       - `capacity` slots, constructed where the control byte is full.
+			 * `capacity`    - 0 or 2^k - 1, so `hash & capacity` is a slot index.
+			 * `size`        - Number of full slots.
+			 * `growth_left` - Empty slots that may still be filled before the next rehash.
+			 *************************************************************************************************/
+			vector_triv<uint8_t> ctrl_bytes;
+			value_type* slots = nullptr;
+			size_t capacity = 0;
+			size_t size = 0;
+			size_t growth_left = 0;
+			Hash hash_fn;
+			Eq eq_fn;
+
+			static constexpr size_t group_width = probe_group::width;
+			static constexpr bool trivial_slots = myis_trivial<value_type>::value;
+
+			static const uint8_t* empty_ctrl() noexcept {
+				static const uint8_t sentinel[probe_group::width] = { ctrl_sentinel };
+				return sentinel;
+			}
+
+			uint8_t* ctrl() noexcept { return ctrl_bytes.get_data(); }
+			const uint8_t* ctrl() const noexcept { return capacity ? ctrl_bytes.get_data() : empty_ctrl(); }
+
+			/// Largest size a table of `cap` slots holds before it rehashes (7/8, at least one empty slot).
+			static size_t growth_for(size_t cap) noexcept { return cap - (cap + 1) / 8; }
+
+			/// Smallest valid capacity that holds `n` elements without rehashing.
+			static size_t capacity_for(size_t n) noexcept {
+				size_t cap = group_width - 1;
+				while (growth_for(cap) < n)
+					cap = cap * 2 + 1;
+				return cap;
+			}
+
+			template<typename KK>
+			size_t hash_of(const KK& key) const { return hash_mix(hash_fn(key)); }
+			static size_t h1(size_t hash) noexcept { return hash >> 7; }
+			static uint8_t h2(size_t hash) noexcept { return static_cast<uint8_t>(hash & 0x7F); }
+
+			/// Writes a control byte and its clone, if it has one.
+			static void set_ctrl(uint8_t* c, size_t cap, size_t index, uint8_t value) noexcept {
+				c[index] = value;
+				if (index < group_width - 1)
+					c[cap + 1 + index] = value;
+			}
+
+			static size_t find_first_non_full(const uint8_t* c, size_t cap, size_t hash) noexcept {
+				probe_seq seq(h1(hash), cap);
+				while (true) {
+					auto mask = probe_group(c + seq.get_offset()).match_empty_or_deleted();
+					if (mask)
+						return seq.slot(mask.lowest());
+					seq.next();
+				}
+			}
+
+			static void relocate_slot(value_type* dst, value_type* src) {
+				if constexpr (trivial_slots)
+					std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(value_type));
+				else
+					detail::construct(dst, std::move_if_noexcept(*src));
+			}
+
+			static void destroy_slot(value_type* slot) noexcept {
+				if constexpr (!trivial_slots)
+					detail::destroy(slot);
+			}
+
+			void destroy_all() noexcept {
+				if constexpr (!trivial_slots) {
+					const uint8_t* c = ctrl();
+					for (size_t i = 0; i < capacity; ++i)
+						if (ctrl_is_full(c[i]))
+							detail::destroy(slots + i);
+				}
+			}
+
+			/*************************************************************************************
+			 * PRIVATE FUNCTION: `resize(new_capacity)`, `resize_and_insert(new_capacity, hash, args...)`
+			 *
+			 * Rehashes every element into fresh arrays of `new_capacity` slots.
+			 * Tombstones disappear. If an element copy throws (non-trivial
+			 * slots without a noexcept move), the new arrays are freed and the
+			 * table is unchanged.
+			 *
+			 * `resize_and_insert` first constructs a new element for `hash` from
+			 * `args` in the fresh slots and returns its index. The old slots are
+			 * still intact then, so `args` may refer to elements of this table.
+			 *************************************************************************************/
+			RAW_COLD void resize(size_t new_capacity) { rebuild<false>(new_capacity, 0); }
+
+			template<typename... Args>
+			RAW_COLD size_t resize_and_insert(size_t new_capacity, size_t hash, Args&&... args) {
+				return rebuild<true>(new_capacity, hash, std::forward<Args>(args)...);
+			}
+
+			template<bool Insert, typename... Args>
+			size_t rebuild(size_t new_capacity, size_t hash, Args&&... args) {
+				vector_triv<uint8_t> new_ctrl;
+				new_ctrl.resize(new_capacity + group_width);
+				uint8_t* c = new_ctrl.get_data();
+				std::memset(c, ctrl_empty, new_capacity + group_width);
+				c[new_capacity] = ctrl_sentinel;
+				value_type* new_slots = detail::allocate<value_type>(new_capacity);
+				if (!new_slots)
+					detail::alloc_failure(sizeof(value_type) * new_capacity);
+
+				size_t placed = new_capacity;
+				if constexpr (Insert) {
+					placed = find_first_non_full(c, new_capacity, hash);
+					RAW_TRY {
+						detail::construct(new_slots + placed, std::forward<Args>(args)...);
+					}
+					RAW_CATCH_ALL {
+						detail::deallocate(new_slots, new_capacity);
+						RAW_RETHROW;
+					}
+					set_ctrl(c, new_capacity, placed, h2(hash));
+				}
+
+				const uint8_t* old_ctrl = ctrl();
+				size_t i = 0;
+				RAW_TRY {
+					for (; i < capacity; ++i) {
+						if (!ctrl_is_full(old_ctrl[i]))
+							continue;
+						size_t old_hash = hash_of(Policy::key(slots[i]));
+						size_t target = find_first_non_full(c, new_capacity, old_hash);
+						relocate_slot(new_slots + target, slots + i);
+						set_ctrl(c, new_capacity, target, h2(old_hash));
+					}
+				}
+				RAW_CATCH_ALL {
+					if constexpr (!trivial_slots) {
+						for (size_t j = 0; j < new_capacity; ++j)
+							if (ctrl_is_full(c[j]))
+								destroy_slot(new_slots + j);
+					}
+					detail::deallocate(new_slots, new_capacity);
+					RAW_RETHROW;
+				}
+				destroy_all();
+				if (slots)
+					detail::deallocate(slots, capacity);
+				ctrl_bytes = std::move(new_ctrl);
+				slots = new_slots;
+				capacity = new_capacity;
+				size += Insert;
+				growth_left = growth_for(new_capacity) - size;
+				return placed;
+			}
+
+			/// Capacity for an insert that would take the last empty slot: larger, or the same if at most half full (only tombstones go).
+			size_t grown_capacity() const noexcept {
+				if (capacity && size * 2 <= growth_for(capacity))
+					return capacity;
+				return capacity ? capacity * 2 + 1 : group_width - 1;
+			}
+
+			/// Index of the slot holding `key`, or `capacity` if there is none.
+			template<typename KK>
+			size_t find_index(const KK& key, size_t hash) const {
+				if (RAW_UNLIKELY(!capacity))
+					return capacity;
+				const uint8_t* c = ctrl();
+				probe_seq seq(h1(hash), capacity);
+				while (true) {
+					probe_group group(c + seq.get_offset());
+					for (auto mask = group.match(h2(hash)); mask; mask.clear_lowest()) {
+						size_t index = seq.slot(mask.lowest());
+						if (RAW_LIKELY(eq_fn(Policy::key(slots[index]), key)))
+							return index;
+					}
+					if (RAW_LIKELY(group.match_empty()))
+						return capacity;
+					seq.next();
+				}
+			}
+
+		protected:
+			/*************************************************************************************
+			 * PROTECTED FUNCTION: `find_or_insert(key, args...)`
+			 *
+			 * Returns `{index, false}` where `key` already is, or constructs a new
+			 * element from `args` and returns `{index, true}`. `args` may refer to
+			 * elements of this table, also when the insert rehashes. If the
+			 * construction throws, the table is left without the new element.
+			 *************************************************************************************/
+			template<typename KK, typename... Args>
+			std::pair<size_t, bool> find_or_insert(const KK& key, Args&&... args) {
+				size_t hash = hash_of(key);
+				if (capacity) {
+					size_t found = find_index(key, hash);
+					if (found != capacity)
+						return { found, false };
+				}
+				size_t index = capacity ? find_first_non_full(ctrl(), capacity, hash) : 0;
+				if (RAW_UNLIKELY(growth_left == 0 && (!capacity || ctrl()[index] != ctrl_deleted)))
+					return { resize_and_insert(grown_capacity(), hash, std::forward<Args>(args)...), true };
+				growth_left -= ctrl()[index] == ctrl_empty;
+				set_ctrl(ctrl(), capacity, index, h2(hash));
+				++size;
+				RAW_TRY {
+					detail::construct(slots + index, std::forward<Args>(args)...);
+				}
+				RAW_CATCH_ALL {
+					erase_meta(index);
+					RAW_RETHROW;
+				}
+				return { index, true };
+			}
+
+			/// Marks `index` free again: empty if no probe can have passed it, a tombstone otherwise.
+			void erase_meta(size_t index) noexcept {
+				uint8_t* c = ctrl();
+				size_t index_before = (index - group_width) & capacity;
+				auto empty_after = probe_group(c + index).match_empty();
+				auto empty_before = probe_group(c + index_before).match_empty();
+				bool was_never_full = empty_before && empty_after &&
+					empty_after.trailing_zeros() + empty_before.leading_zeros() < group_width;
+				set_ctrl(c, capacity, index, was_never_full ? ctrl_empty : ctrl_deleted);
+				growth_left += was_never_full;
+				--size;
+			}
+
+			template<typename KK>
+			size_t erase_key(const KK& key) {
+				size_t index = find_index(key, hash_of(key));
+				if (index == capacity)
+					return 0;
+				destroy_slot(slots + index);
+				erase_meta(index);
+				return 1;
+			}
+
+		public:
+			/*********************************************************************
+			 * ITERATORS: `iterator`, `const_iterator`
+			 *
+			 * Forward iterators over the full slots, in slot order (which is
+			 * unspecified and changes on rehash).
+			 *********************************************************************/
+			template<bool Const>
+			class basic_iterator {
+			private:
+				friend class flat_table;
+				using slot_ptr = std::conditional_t<Const, const typename Policy::value_type*, typename Policy::value_type*>;
+				const uint8_t* ctrl_ptr = nullptr;
+				slot_ptr slot = nullptr;
+
+				basic_iterator(const uint8_t* ctrl_, slot_ptr slot_) noexcept : ctrl_ptr(ctrl_), slot(slot_) {}
+
+				void skip_free() noexcept {
+					while (ctrl_is_empty_or_deleted(*ctrl_ptr)) {
+						unsigned shift = probe_group(ctrl_ptr).count_leading_empty_or_deleted();
+						ctrl_ptr += shift;
+						slot += shift;
+					}
+				}
+
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = typename Policy::value_type;
+				using difference_type = ptrdiff_t;
+				using pointer = slot_ptr;
+				using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+				basic_iterator() noexcept = default;
+				template<bool C = Const, typename = std::enable_if_t<C>>
+				basic_iterator(const basic_iterator<false>& other) noexcept : ctrl_ptr(other.ctrl_ptr), slot(other.slot) {}
+
+				reference operator*() const noexcept { return *slot; }
+				pointer operator->() const noexcept { return slot; }
+				basic_iterator& operator++() noexcept {
+					++ctrl_ptr;
+					++slot;
+					skip_free();
+					return *this;
+				}
+				basic_iterator operator++(int) noexcept {
+					basic_iterator old = *this;
+					++*this;
+					return old;
+				}
+				friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.ctrl_ptr == b.ctrl_ptr; }
+				friend bool operator!=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.ctrl_ptr != b.ctrl_ptr; }
+
+				friend class basic_iterator<!Const>;
+			};
+
+			using iterator = basic_iterator<!Policy::mutable_elements>;
+			using const_iterator = basic_iterator<true>;
+
+		protected:
+			/// Enables the heterogeneous overloads for `KK` when Hash and Eq are both transparent.
+			template<typename KK>
+			using enable_heterogeneous = std::enable_if_t<is_transparent_pair<Hash, Eq>::value &&
+				!std::is_convertible<const KK&, const_iterator>::value && !std::is_same<KK, key_type>::value>;
+
+			iterator iterator_at(size_t index) noexcept { return iterator(ctrl() + index, slots + index); }
+			const_iterator iterator_at(size_t index) const noexcept { return const_iterator(ctrl() + index, slots + index); }
+
+		public:
+			/*********************************************************************
+			 * CONSTRUCTORS: `flat_table()`, `flat_table(reserve_)`
+			 *
+			 * Default constructor does not allocate. `flat_table(reserve_)`
+			 * makes room for `reserve_` elements.
+			 *
+			 * Throws: std::bad_alloc (or the allocation failure handler).
+			 *********************************************************************/
+			flat_table() = default;
+
+			explicit flat_table(size_t reserve_, const Hash& hash = Hash(), const Eq& eq = Eq())
+				: hash_fn(hash), eq_fn(eq) {
+				reserve(reserve_);
+			}
+
+			/*********************************************************************
+			 * COPY CONSTRUCTOR: `flat_table(const flat_table& other)`
+			 *
+			 * Same capacity and slot layout as `other`, so no rehashing;
+			 * tombstones are copied too.
+			 *
+			 * Throws: allocation failure, exceptions from the element copy.
+			 *********************************************************************/
+			flat_table(const flat_table& other) : hash_fn(other.hash_fn), eq_fn(other.eq_fn) {
+				if (!other.capacity)
+					return;
+				value_type* new_slots = detail::allocate<value_type>(other.capacity);
+				if (!new_slots)
+					detail::alloc_failure(sizeof(value_type) * other.capacity);
+				const uint8_t* c = other.ctrl();
+				size_t i = 0;
+				RAW_TRY {
+					for (; i < other.capacity; ++i) {
+						if (!ctrl_is_full(c[i]))
+							continue;
+						if constexpr (trivial_slots)
+							std::memcpy(static_cast<void*>(new_slots + i), static_cast<const void*>(other.slots + i), sizeof(value_type));
+						else
+							detail::construct(new_slots + i, other.slots[i]);
+					}
+					ctrl_bytes = other.ctrl_bytes;
+				}
+				RAW_CATCH_ALL {
+					for (size_t j = 0; j < i; ++j)
+						if (ctrl_is_full(c[j]))
+							destroy_slot(new_slots + j);
+					detail::deallocate(new_slots, other.capacity);
+					RAW_RETHROW;
+				}
+				slots = new_slots;
+				capacity = other.capacity;
+				size = other.size;
+				growth_left = other.growth_left;
+			}
+
+			/*********************************************************************
+			 * MOVE CONSTRUCTOR: `flat_table(flat_table&& other) noexcept`
+			 *
+			 * Takes over `other`'s arrays; `other` becomes empty with capacity 0.
+			 *********************************************************************/
+			flat_table(flat_table&& other) noexcept
+				: ctrl_bytes(std::move(other.ctrl_bytes)), slots(other.slots), capacity(other.capacity),
+				size(other.size), growth_left(other.growth_left), hash_fn(other.hash_fn), eq_fn(other.eq_fn) {
+				other.slots = nullptr;
+				other.capacity = other.size = other.growth_left = 0;
+			}
+
+			flat_table& operator=(const flat_table& other) {
+				if (this != &other) {
+					flat_table copy(other);
+					swap(copy);
+				}
+				return *this;
+			}
+
+			flat_table& operator=(flat_table&& other) noexcept {
+				if (this != &other) {
+					flat_table stolen(std::move(other));
+					swap(stolen);
+				}
+				return *this;
+			}
+
+			~flat_table() {
+				destroy_all();
+				if (slots)
+					detail::deallocate(slots, capacity);
+			}
+
+			/*********************************************************************
+			 * SIZE FUNCTIONS: `get_size()`, `get_capacity()`, `empty()`, `load_factor()`, `max_size()`
+			 *********************************************************************/
+			size_t get_size() const noexcept { return size; }
+			size_t get_capacity() const noexcept { return capacity; }
+			bool empty() const noexcept { return size == 0; }
+			float load_factor() const noexcept { return capacity ? float(size) / float(capacity) : 0.0f; }
+
+			static constexpr size_t max_size() noexcept {
+				return size_t(std::numeric_limits<ptrdiff_t>::max()) / (sizeof(value_type) + 1) / 2;
+			}
+
+			/*********************************************************************
+			 * ITERATION: `begin()`, `end()`, `cbegin()`, `cend()`
+			 *
+			 * `begin()` skips free slots a group at a time, O(capacity / width)
+			 * for an almost empty table.
+			 *********************************************************************/
+			iterator begin() noexcept {
+				if (!capacity)
+					return end();
+				iterator it(ctrl(), slots);
+				it.skip_free();
+				return it;
+			}
+			const_iterator begin() const noexcept {
+				if (!capacity)
+					return end();
+				const_iterator it(ctrl(), slots);
+				it.skip_free();
+				return it;
+			}
+			iterator end() noexcept { return iterator(static_cast<const flat_table*>(this)->ctrl() + capacity, slots + capacity); }
+			const_iterator end() const noexcept { return const_iterator(ctrl() + capacity, slots + capacity); }
+			const_iterator cbegin() const noexcept { return begin(); }
+			const_iterator cend() const noexcept { return end(); }
+
+			/*********************************************************************
+			 * LOOKUP: `find(key)`, `contains(key)`, `count(key)`
+			 *
+			 * One hash, then one group compare per probed group. With a
+			 * transparent Hash and Eq (the defaults for std::string keys) `key`
+			 * may be any type they accept, e.g. std::string_view or a literal.
+			 *********************************************************************/
+			iterator find(const key_type& key) {
+				size_t index = find_index(key, hash_of(key));
+				return index == capacity ? end() : iterator_at(index);
+			}
+
+			const_iterator find(const key_type& key) const {
+				size_t index = find_index(key, hash_of(key));
+				return index == capacity ? end() : iterator_at(index);
+			}
+
+			template<typename KK, typename = enable_heterogeneous<KK>>
+			iterator find(const KK& key) {
+				size_t index = find_index(key, hash_of(key));
+				return index == capacity ? end() : iterator_at(index);
+			}
+
+			template<typename KK, typename = enable_heterogeneous<KK>>
+			const_iterator find(const KK& key) const {
+				size_t index = find_index(key, hash_of(key));
+				return index == capacity ? end() : iterator_at(index);
+			}
+
+			bool contains(const key_type& key) const { return find_index(key, hash_of(key)) != capacity; }
+
+			template<typename KK, typename = enable_heterogeneous<KK>>
+			bool contains(const KK& key) const { return find_index(key, hash_of(key)) != capacity; }
+
+			size_t count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+			template<typename KK, typename = enable_heterogeneous<KK>>
+			size_t count(const KK& key) const { return contains(key) ? 1 : 0; }
+
+			/*********************************************************************
+			 * ERASE FUNCTIONS: `erase(key)`, `erase(iterator)`
+			 *
+			 * `erase(key)` returns the number of removed elements (0 or 1).
+			 * `erase(iterator)` returns the iterator to the next element.
+			 * Neither rehashes; other iterators stay valid.
+			 *********************************************************************/
+			size_t erase(const key_type& key) { return erase_key(key); }
+
+			template<typename KK, typename = enable_heterogeneous<KK>>
+			size_t erase(const KK& key) { return erase_key(key); }
+
+			iterator erase(const_iterator pos) {
+				size_t index = static_cast<size_t>(pos.slot - slots);
+				destroy_slot(slots + index);
+				erase_meta(index);
+				iterator next = iterator_at(index);
+				++next;
+				return next;
+			}
+
+			/*********************************************************************
+			 * CAPACITY FUNCTIONS: `reserve(n)`, `clear()`, `swap(other)`
+			 *
+			 * `reserve(n)` - after it, `n` elements fit without a rehash.
+			 * `clear()`    - destroys every element, keeps the arrays.
+			 *
+			 * Throws: std::length_error past max_size(), allocation failure.
+			 *********************************************************************/
+			void reserve(size_t n) {
+				if (n > max_size())
+					detail::throw_length_error("Requested size exceeds max_size()");
+				if (n > size + growth_left || (!capacity && n))
+					resize(capacity_for(n));
+			}
+
+			void clear() noexcept {
+				destroy_all();
+				if (capacity) {
+					std::memset(ctrl(), ctrl_empty, capacity + group_width);
+					ctrl()[capacity] = ctrl_sentinel;
+				}
+				size = 0;
+				growth_left = capacity ? growth_for(capacity) : 0;
+			}
+
+			void swap(flat_table& other) noexcept {
+				using std::swap;
+				ctrl_bytes.swap(other.ctrl_bytes);
+				swap(slots, other.slots);
+				swap(capacity, other.capacity);
+				swap(size, other.size);
+				swap(growth_left, other.growth_left);
+				swap(hash_fn, other.hash_fn);
+				swap(eq_fn, other.eq_fn);
+			}
+
+			hasher hash_function() const { return hash_fn; }
+			key_equal key_eq() const { return eq_fn; }
+		};
+	}
+
+	template<typename K, typename V, typename Hash, typename Eq>
+	class flat_hash_map : public detail::flat_table<detail::map_policy<K, V>, Hash, Eq> {
+	private:
+		using base = detail::flat_table<detail::map_policy<K, V>, Hash, Eq>;
+
+		template<typename It>
+		static auto& checked(It it, It last) {
+			if (it == last)
+				detail::throw_out_of_range("Key not found");
+			return it->second;
+		}
+
+	public:
+		using mapped_type = V;
+		using typename base::key_type;
+		using typename base::value_type;
+		using typename base::iterator;
+		using typename base::const_iterator;
+
+		using base::base;
+
+		/*********************************************************************
+		 * INSERT FUNCTIONS: `try_emplace(key, args...)`, `insert(value)`,
+		 *                   `insert_or_assign(key, value)`, `emplace(args...)`
+		 *
+		 * All return `{iterator, inserted}`. `try_emplace` constructs the
+		 * mapped value from `args` only if `key` is new; `insert_or_assign`
+		 * overwrites an existing value; `emplace` builds the pair first.
+		 *
+		 * Throws: allocation failure, exceptions from the key/value constructors
+		 *         (the table is left without the new element).
+		 *********************************************************************/
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+			auto [index, inserted] = this->find_or_insert(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { this->iterator_at(index), inserted };
+		}
+
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+			auto [index, inserted] = this->find_or_insert(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { this->iterator_at(index), inserted };
+		}
+
+		std::pair<iterator, bool> insert(const value_type& value) {
+			auto [index, inserted] = this->find_or_insert(value.first, value);
+			return { this->iterator_at(index), inserted };
+		}
+
+		std::pair<iterator, bool> insert(value_type&& value) {
+			auto [index, inserted] = this->find_or_insert(value.first, std::move(value));
+			return { this->iterator_at(index), inserted };
+		}
+
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+			auto result = try_emplace(key, std::forward<M>(value));
+			if (!result.second)
+				result.first->second = std::forward<M>(value);
+			return result;
+		}
+
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(K&& key, M&& value) {
+			auto result = try_emplace(std::move(key), std::forward<M>(value));
+			if (!result.second)
+				result.first->second = std::forward<M>(value);
+			return result;
+		}
+
+		template<typename... Args>
+		std::pair<iterator, bool> emplace(Args&&... args) {
+			value_type value(std::forward<Args>(args)...);
+			return insert(std::move(value));
+		}
+
+		/*********************************************************************
+		 * ACCESS FUNCTIONS: `operator[](key)`, `at(key)`
+		 *
+		 * `operator[]` value-initializes the mapped value of a new key.
+		 * `at` accepts heterogeneous keys like `find`.
+		 *
+		 * Throws: `at` - std::out_of_range if the key is missing.
+		 *********************************************************************/
+		V& operator [] (const K& key) { return try_emplace(key).first->second; }
+		V& operator [] (K&& key) { return try_emplace(std::move(key)).first->second; }
+
+		V& at(const K& key) { return checked(this->find(key), this->end()); }
+		const V& at(const K& key) const { return checked(this->find(key), this->end()); }
+
+		template<typename KK, typename = typename base::template enable_heterogeneous<KK>>
+		V& at(const KK& key) { return checked(this->find(key), this->end()); }
+
+		template<typename KK, typename = typename base::template enable_heterogeneous<KK>>
+		const V& at(const KK& key) const { return checked(this->find(key), this->end()); }
+	};
+
+	template<typename K, typename Hash, typename Eq>
+	class flat_hash_set : public detail::flat_table<detail::set_policy<K>, Hash, Eq> {
+	private:
+		using base = detail::flat_table<detail::set_policy<K>, Hash, Eq>;
+
+	public:
+		using typename base::key_type;
+		using typename base::value_type;
+		using typename base::iterator;
+		using typename base::const_iterator;
+
+		using base::base;
+
+		/*********************************************************************
+		 * INSERT FUNCTIONS: `insert(key)`, `emplace(args...)`
+		 *
+		 * Return `{iterator, inserted}`; an existing equal key is kept.
+		 * Elements are immutable through iterators.
+		 *
+		 * Throws: allocation failure, exceptions from K's constructor.
+		 *********************************************************************/
+		std::pair<const_iterator, bool> insert(const K& key) {
+			auto [index, inserted] = this->find_or_insert(key, key);
+			return { this->iterator_at(index), inserted };
+		}
+
+		std::pair<const_iterator, bool> insert(K&& key) {
+			auto [index, inserted] = this->find_or_insert(key, std::move(key));
+			return { this->iterator_at(index), inserted };
+		}
+
+		template<typename... Args>
+		std::pair<const_iterator, bool> emplace(Args&&... args) {
+			K key(std::forward<Args>(args)...);
+			return insert(std::move(key));
+		}
+	};
+}
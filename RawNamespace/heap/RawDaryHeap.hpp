@@ -0,0 +1,452 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* raw::dary_heap<T, D, Compare, Track> - priority queue with D children
+* per node, stored in a raw::vector.
+*
+* Same ordering as std::priority_queue: with the default std::less the
+* largest element is on top. A binary heap of n elements is log2(n)
+* levels deep and every level of a sift is a new cache line; with D = 4
+* the depth halves and the D children of a node are adjacent, so one
+* level costs one line. For trivially copyable T whose child group
+* (D * sizeof(T) bytes) is a power of two, the root is shifted by up to
+* D - 1 unused slots so that every child group starts on a
+* min(group, 64)-byte boundary and never straddles two lines:
+*
+*     slots:   [pad][ 0 ][ 1  2  3  4 ][ 5  6  7  8 ][ 9 ...
+*     lines:             ^ group start   ^ group start
+*
+* pop() descends to a leaf along the best children and sifts the old
+* last element up from there (fewer comparisons than stopping early,
+* since that element usually belongs near the bottom), prefetching the
+* grandchild groups one level ahead.
+*
+* Position tracking: `Track` is called as `track(element, position)`
+* every time an element lands in a new slot, and with `npos` when it
+* leaves the heap. Keeping those positions (in the element or a side
+* table) is what `update(pos, value)` and `erase(pos)` need for
+* decrease-key. The default `no_heap_tracking` compiles away.
+***********************************************************************/
+
+namespace raw {
+	/// Default `Track` for dary_heap: positions are not reported.
+	struct no_heap_tracking {
+		template<typename T>
+		void operator()(const T&, size_t) const noexcept {}
+	};
+
+	template<typename T, size_t D, typename Compare, typename Track>
+	class dary_heap {
+		static_assert(D >= 2, "dary_heap needs at least two children per node");
+
+	public:
+		using value_type = T;
+		using value_compare = Compare;
+		static constexpr size_t arity = D;
+		static constexpr size_t npos = SIZE_MAX;
+
+	private:
+		static constexpr bool is_pow2(size_t x) noexcept { return x && !(x & (x - 1)); }
+		static constexpr size_t group_bytes = D * sizeof(T);
+		static constexpr size_t group_align = group_bytes < 64 ? group_bytes : 64;
+		static constexpr bool aligned_groups = myis_trivial<T>::value && is_pow2(sizeof(T)) &&
+			sizeof(T) <= alignof(std::max_align_t) && is_pow2(group_bytes);
+		/// Free slots kept past the end so re-padding after a reallocation never grows the vector.
+		static constexpr size_t slack = aligned_groups ? D - 1 : 0;
+		static constexpr bool tracking = !std::is_same<Track, no_heap_tracking>::value;
+		/// Prefetching grandchildren pays off once the heap is well past L1.
+		static constexpr size_t prefetch_from = 16384;
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `items` - `pad` unused slots, then the heap in level order: children of `i` are
+		 *           `D*i + 1 .. D*i + D`.
+		 * `pad`   - Slots before the root; 0 unless `aligned_groups`.
+		 *************************************************************************************************/
+		vector<T> items;
+		size_t pad = 0;
+		Compare comp;
+		Track track;
+
+		T* heap() noexcept { return items.get_data() + pad; }
+		const T* heap() const noexcept { return items.get_data() + pad; }
+
+		void placed(T* h, size_t pos) {
+			if constexpr (tracking)
+				track(static_cast<const T&>(h[pos]), pos);
+		}
+
+		void removed(const T& value) {
+			if constexpr (tracking)
+				track(value, npos);
+		}
+
+		/// Slots before the root so that the first child group of `data` starts on a `group_align` boundary.
+		static size_t wanted_pad(const T* data) noexcept {
+			const uintptr_t first_child = reinterpret_cast<uintptr_t>(data) + sizeof(T);
+			return ((group_align - first_child % group_align) % group_align) / sizeof(T);
+		}
+
+		/*************************************************************************************
+		 * PRIVATE FUNCTIONS: `ensure_room(extra)`, `grow(need)`, `realign()`
+		 *
+		 * `ensure_room` makes room for `extra` more elements plus `slack`;
+		 * `grow` reallocates (doubling) and `realign` then moves the heap to
+		 * the padding the new buffer needs, within the reserved slack.
+		 *************************************************************************************/
+
+		void ensure_room(size_t extra) {
+			const size_t need = items.get_size() + extra + slack;
+			if (RAW_LIKELY(items.get_data() && need <= items.get_capacity()))
+				return;
+			grow(need);
+		}
+
+		RAW_COLD void grow(size_t need) {
+			size_t target = items.get_capacity() * 2;
+			if (target < need)
+				target = need;
+			if (target < 16)
+				target = 16;
+			items.reserve(target);
+			realign();
+		}
+
+		void realign() noexcept {
+			if constexpr (aligned_groups) {
+				T* data = items.get_data();
+				const size_t want = wanted_pad(data);
+				if (want == pad)
+					return;
+				const size_t n = items.get_size() - pad;
+				if (want > pad) {
+					items.commit_spare(want - pad);
+					std::memmove(data + want, data + pad, n * sizeof(T));
+				}
+				else {
+					std::memmove(data + want, data + pad, n * sizeof(T));
+					items.resize(want + n);
+				}
+				pad = want;
+			}
+		}
+
+		/*************************************************************************************
+		 * PRIVATE FUNCTIONS: `best_child()`, `sift_up()`, `sift_down()`, `sift_to_leaf()`
+		 *
+		 * All take a hole at `pos` (its element moved out into `value` or
+		 * already dead) and fill it. `sift_down` stops where `value` fits;
+		 * `sift_to_leaf` moves the best child up at every level and returns
+		 * the leaf hole it ends at.
+		 *************************************************************************************/
+
+		/// Full groups play a pairwise tournament: the selects have no data-dependent branches and a log2(D) deep chain.
+		size_t best_child(const T* h, size_t first, size_t n) const {
+			if (RAW_LIKELY(first + D <= n)) {
+				size_t round[D];
+				RAW_UNROLL
+				for (size_t c = 0; c < D; ++c)
+					round[c] = first + c;
+				RAW_UNROLL
+				for (size_t step = 1; step < D; step *= 2) {
+					RAW_UNROLL
+					for (size_t c = 0; c + step < D; c += 2 * step)
+						round[c] = comp(h[round[c]], h[round[c + step]]) ? round[c + step] : round[c];
+				}
+				return round[0];
+			}
+			size_t best = first;
+			for (size_t c = first + 1; c < n; ++c)
+				if (comp(h[best], h[c]))
+					best = c;
+			return best;
+		}
+
+		static void prefetch_grandchildren(const T* h, size_t first, size_t n) noexcept {
+			const size_t grand = D * first + 1;
+			if (grand >= n)
+				return;
+			const char* begin = reinterpret_cast<const char*>(h + grand);
+			RAW_UNROLL
+			for (size_t line = 0; line < (D * D * sizeof(T) + 63) / 64; ++line)
+				RAW_PREFETCH(begin + line * 64);
+		}
+
+		void sift_up(size_t pos, T value) {
+			T* h = heap();
+			while (pos > 0) {
+				const size_t parent = (pos - 1) / D;
+				if (!comp(h[parent], value))
+					break;
+				h[pos] = std::move(h[parent]);
+				placed(h, pos);
+				pos = parent;
+			}
+			h[pos] = std::move(value);
+			placed(h, pos);
+		}
+
+		void sift_down(size_t pos, T value) {
+			T* h = heap();
+			const size_t n = get_size();
+			const bool prefetch = n >= prefetch_from;
+			for (;;) {
+				const size_t first = D * pos + 1;
+				if (first >= n)
+					break;
+				if (prefetch)
+					prefetch_grandchildren(h, first, n);
+				const size_t best = best_child(h, first, n);
+				if (!comp(value, h[best]))
+					break;
+				h[pos] = std::move(h[best]);
+				placed(h, pos);
+				pos = best;
+			}
+			h[pos] = std::move(value);
+			placed(h, pos);
+		}
+
+		size_t sift_to_leaf(size_t pos) {
+			T* h = heap();
+			const size_t n = get_size();
+			const bool prefetch = n >= prefetch_from;
+			for (;;) {
+				const size_t first = D * pos + 1;
+				if (first >= n)
+					return pos;
+				if (prefetch)
+					prefetch_grandchildren(h, first, n);
+				const size_t best = best_child(h, first, n);
+				h[pos] = std::move(h[best]);
+				placed(h, pos);
+				pos = best;
+			}
+		}
+
+		/// Floyd's bottom-up construction over the whole array, O(n).
+		void heapify() {
+			const size_t n = get_size();
+			if (n < 2)
+				return;
+			T* h = heap();
+			for (size_t i = (n - 2) / D + 1; i-- > 0;)
+				sift_down(i, std::move(h[i]));
+		}
+
+		void check_not_empty(const char* what) const {
+			if (RAW_UNLIKELY(empty()))
+				detail::throw_out_of_range(what);
+		}
+
+	public:
+		explicit dary_heap(const Compare& comp_ = Compare(), const Track& track_ = Track())
+			: comp(comp_), track(track_) {}
+
+		/*********************************************************************
+		 * COPY / MOVE: constructors, assignment, `swap()`
+		 *
+		 * A copy lives in a new buffer and computes its own padding; a move
+		 * takes the buffer and leaves `other` empty.
+		 *********************************************************************/
+
+		dary_heap(const dary_heap& other) : comp(other.comp), track(other.track) {
+			const size_t n = other.get_size();
+			ensure_room(n);
+			for (size_t i = 0; i < n; ++i)
+				items.push_back(other.heap()[i]);
+		}
+
+		dary_heap(dary_heap&& other) noexcept
+			: items(std::move(other.items)), pad(other.pad), comp(std::move(other.comp)), track(std::move(other.track)) {
+			other.pad = 0;
+		}
+
+		dary_heap& operator=(const dary_heap& other) {
+			if (this != &other) {
+				dary_heap copy(other);
+				swap(copy);
+			}
+			return *this;
+		}
+
+		dary_heap& operator=(dary_heap&& other) noexcept {
+			if (this != &other) {
+				dary_heap stolen(std::move(other));
+				swap(stolen);
+			}
+			return *this;
+		}
+
+		void swap(dary_heap& other) noexcept {
+			items.swap(other.items);
+			std::swap(pad, other.pad);
+			std::swap(comp, other.comp);
+			std::swap(track, other.track);
+		}
+
+		/*********************************************************************
+		 * INSERT FUNCTIONS: `push(value)`, `push_range(first, last)`, `push_range(range)`
+		 *
+		 * `push_range` appends everything, then either sifts each new element
+		 * up (few additions to a big heap) or rebuilds the whole heap
+		 * bottom-up in O(n) when the additions outnumber what was there.
+		 *
+		 * Throws: allocation failure, exceptions from T or Compare.
+		 *********************************************************************/
+
+		void push(T value) {
+			ensure_room(1);
+			const size_t pos = get_size();
+			items.push_back(std::move(value));
+			sift_up(pos, std::move(heap()[pos]));
+		}
+
+		template<typename It>
+		void push_range(It first, It last) {
+			using category = typename std::iterator_traits<It>::iterator_category;
+			if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value)
+				ensure_room(static_cast<size_t>(std::distance(first, last)));
+			const size_t old = get_size();
+			for (; first != last; ++first) {
+				ensure_room(1);
+				items.push_back(*first);
+			}
+			const size_t n = get_size();
+			if constexpr (tracking) {
+				for (size_t i = old; i < n; ++i)
+					placed(heap(), i);
+			}
+			if (n - old > old)
+				heapify();
+			else {
+				for (size_t i = old; i < n; ++i)
+					sift_up(i, std::move(heap()[i]));
+			}
+		}
+
+		template<typename Range>
+		void push_range(const Range& range) {
+			push_range(std::begin(range), std::end(range));
+		}
+
+		/*********************************************************************
+		 * ACCESS: `top()`, `operator[](pos)`, `get_data()`
+		 *
+		 * `top()` is the element no other compares greater than (by `Compare`).
+		 * `operator[]` and `get_data()` expose the heap array in level order,
+		 * e.g. to look up a tracked position. No bounds checking.
+		 *********************************************************************/
+
+		const T& top() const noexcept { return heap()[0]; }
+		const T& operator [] (size_t pos) const noexcept { return heap()[pos]; }
+		const T* get_data() const noexcept { return heap(); }
+
+		/*********************************************************************
+		 * REMOVAL: `pop()`, `pop_push(value)`, `replace_top(value)`
+		 *
+		 * `pop_push` removes and returns the top and inserts `value` in one
+		 * sift (the usual step of a timer wheel or k-way merge);
+		 * `replace_top` does the same without returning the old top.
+		 *
+		 * Throws: std::out_of_range on an empty heap, exceptions from T or Compare.
+		 *********************************************************************/
+
+		void pop() {
+			check_not_empty("dary_heap is empty");
+			T* h = heap();
+			removed(h[0]);
+			const size_t last = get_size() - 1;
+			if (last == 0) {
+				items.pop_back();
+				return;
+			}
+			T value = std::move(h[last]);
+			items.pop_back();
+			sift_up(sift_to_leaf(0), std::move(value));
+		}
+
+		T pop_push(T value) {
+			check_not_empty("dary_heap is empty");
+			T* h = heap();
+			removed(h[0]);
+			T old = std::move(h[0]);
+			sift_down(0, std::move(value));
+			return old;
+		}
+
+		void replace_top(T value) {
+			check_not_empty("dary_heap is empty");
+			removed(heap()[0]);
+			sift_down(0, std::move(value));
+		}
+
+		/*********************************************************************
+		 * POSITIONAL: `update(pos, value)`, `erase(pos)`
+		 *
+		 * For use with position tracking. `update` replaces the element at
+		 * `pos` and moves it up or down as needed (decrease- and increase-key);
+		 * `erase` removes and returns it.
+		 *
+		 * Throws: std::out_of_range if `pos >= get_size()`, exceptions from T or Compare.
+		 *********************************************************************/
+
+		void update(size_t pos, T value) {
+			if (pos >= get_size())
+				detail::throw_out_of_range("dary_heap position out of range");
+			if (pos > 0 && comp(heap()[(pos - 1) / D], value))
+				sift_up(pos, std::move(value));
+			else
+				sift_down(pos, std::move(value));
+		}
+
+		T erase(size_t pos) {
+			if (pos >= get_size())
+				detail::throw_out_of_range("dary_heap position out of range");
+			T* h = heap();
+			removed(h[pos]);
+			T old = std::move(h[pos]);
+			const size_t last = get_size() - 1;
+			if (pos != last) {
+				T value = std::move(h[last]);
+				items.pop_back();
+				update(pos, std::move(value));
+			}
+			else
+				items.pop_back();
+			return old;
+		}
+
+		/*********************************************************************
+		 * SIZE FUNCTIONS: `get_size()`, `empty()`, `clear()`, `reserve(n)`
+		 *
+		 * `clear()` keeps the buffer (and reports nothing to `Track`).
+		 *
+		 * Throws: allocation failure (`reserve`).
+		 *********************************************************************/
+
+		size_t get_size() const noexcept { return items.get_size() - pad; }
+		bool empty() const noexcept { return items.get_size() == pad; }
+
+		void clear() {
+			items.resize(pad);
+		}
+
+		void reserve(size_t n) {
+			if (n > get_size())
+				ensure_room(n - get_size());
+		}
+	};
+}
@@ -0,0 +1,603 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* raw::inplace_vector<T, N> - fixed capacity vector with inline storage.
+*
+* Same member API as raw::vector, but the `N` slots live inside the object
+* and nothing ever touches the heap. Growing past `N` is an error: the
+* throwing operations raise std::length_error, the `try_*` operations
+* return `status::length_error`, and `unchecked_push_back` leaves the check
+* to the caller.
+*
+* There is no vector_base here: a vtable would make the object non
+* trivially copyable. The iterator types are shared with raw::vector.
+***********************************************************************/
+
+namespace raw {
+	namespace detail {
+		/// Smallest unsigned type that can count up to `N`.
+		template<size_t N>
+		using inplace_size_t = std::conditional_t<(N <= UINT8_MAX), uint8_t,
+			std::conditional_t<(N <= UINT16_MAX), uint16_t,
+			std::conditional_t<(N <= UINT32_MAX), uint32_t, size_t>>>;
+
+		/*********************************************************************
+		 * UNIONS: `inplace_storage<T, N>`, `inplace_storage_non_triv<T, N>`
+		 *
+		 * Uninitialized room for `N` elements. The union keeps T's alignment
+		 * and skips T's default constructor; the non-trivial one also has an
+		 * empty destructor, elements are destroyed by the owning vector.
+		 *********************************************************************/
+		template<typename T, size_t N>
+		union inplace_storage {
+			T elems[N ? N : 1];
+			unsigned char unused;
+			constexpr inplace_storage() noexcept : unused() {}
+		};
+
+		template<typename T, size_t N>
+		union inplace_storage_non_triv {
+			T elems[N ? N : 1];
+			unsigned char unused;
+			constexpr inplace_storage_non_triv() noexcept : unused() {}
+			~inplace_storage_non_triv() {}
+		};
+	}
+
+	template<typename T, size_t N>
+	class inplace_vector_triv {
+	private:
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `storage` - Inline room for `N` elements of type `T`.
+		 * `size`    - Number of currently used elements, in the smallest type that can hold `N`.
+		 *************************************************************************************************/
+		detail::inplace_storage<T, N> storage;
+		detail::inplace_size_t<N> size = 0;
+
+		T* data() noexcept { return storage.elems; }
+		const T* data() const noexcept { return storage.elems; }
+
+	public:
+		using value_type = T;
+		using Iterator = typename vector_base<T>::template IteratorBase<T>;
+		using const_iterator = typename vector_base<T>::template IteratorBase<const T>;
+		using reverse_iterator = typename vector_base<T>::template ReverseIterator<T>;
+		using const_reverse_iterator = typename vector_base<T>::template ReverseIterator<const T>;
+
+		/*********************************************************************
+		 * CONSTRUCTORS: `inplace_vector_triv()`, `inplace_vector_triv(size_t size_)`
+		 *
+		 * Default constructor creates an empty vector without touching the slots.
+		 * The size constructor zero-fills the first `size_` elements.
+		 * Copy and move are the implicit ones, so the whole object is trivially
+		 * copyable.
+		 *
+		 * Throws: std::length_error if `size_` > N.
+		 *********************************************************************/
+
+		inplace_vector_triv() = default;
+
+		explicit inplace_vector_triv(size_t size_) {
+			resize(size_);
+		}
+
+		/*************************************************************************************
+		 * PUSH_BACK FUNCTIONS: `push_back()`, `try_push_back()`, `unchecked_push_back()`
+		 *
+		 * `push_back`           - appends, raises std::length_error when full.
+		 * `try_push_back`       - appends, returns status::length_error when full.
+		 * `unchecked_push_back` - appends; the caller guarantees `size < N`.
+		 *************************************************************************************/
+
+		void push_back(const T& elem) {
+			if (RAW_UNLIKELY(size >= N))
+				detail::throw_length_error("inplace_vector capacity exceeded");
+			data()[size++] = elem;
+		}
+
+		status try_push_back(const T& elem) noexcept {
+			if (RAW_UNLIKELY(size >= N))
+				return status::length_error;
+			data()[size++] = elem;
+			return status::ok;
+		}
+
+		void unchecked_push_back(const T& elem) noexcept {
+			data()[size++] = elem;
+		}
+
+		/*********************************************************************
+		 * INDEXING FUNCTIONS: `at()`, `operator[]` (const and non-const)
+		 *
+		 * `at()` - with bounds checking, throws `std::out_of_range`.
+		 * `operator[]` - no bounds checking.
+		 *********************************************************************/
+
+		T& at(const size_t index) {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			return data()[index];
+		}
+
+		const T& at(const size_t index) const {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			return data()[index];
+		}
+
+		T& operator [] (const size_t index) { return data()[index]; }
+		const T& operator [] (const size_t index) const { return data()[index]; }
+
+		/*********************************************************************
+		 * GETTER FUNCTIONS: `get_size()`, `get_data()`, `get_capacity()`, `max_size()`, `empty()`, `is_trivial()`
+		 *
+		 * Capacity and max_size are always `N`.
+		 *********************************************************************/
+
+		size_t get_size() const { return size; }
+		T* get_data() noexcept { return data(); }
+		const T* get_data() const noexcept { return data(); }
+		static constexpr size_t get_capacity() { return N; }
+		static constexpr size_t max_size() noexcept { return N; }
+		bool empty() const { return size == 0; }
+		static constexpr bool is_trivial() { return true; }
+
+		/*************************************************************************************
+		 * SIZE FUNCTIONS: `resize()`, `try_resize()`, `reserve()`, `try_reserve()`
+		 *
+		 * `resize` zero-fills new elements. `reserve` only checks `reserve_size` <= N.
+		 * Failures are std::length_error / status::length_error; the vector is unchanged.
+		 *************************************************************************************/
+
+		status try_resize(size_t new_size) noexcept {
+			if (new_size > N)
+				return status::length_error;
+			if (new_size > size)
+				std::memset(static_cast<void*>(data() + size), 0, (new_size - size) * sizeof(T));
+			size = static_cast<detail::inplace_size_t<N>>(new_size);
+			return status::ok;
+		}
+
+		void resize(size_t new_size) {
+			detail::raise_if(try_resize(new_size), new_size * sizeof(T));
+		}
+
+		status try_reserve(size_t reserve_size) const noexcept {
+			return reserve_size <= N ? status::ok : status::length_error;
+		}
+
+		void reserve(size_t reserve_size) const {
+			detail::raise_if(try_reserve(reserve_size), reserve_size * sizeof(T));
+		}
+
+		/*********************************************************************
+		 * CLEAR, SHRINK_TO_FIT, POP_BACK
+		 *
+		 * None of them touch memory; `shrink_to_fit` is a no-op kept for API parity.
+		 *
+		 * Throws: std::out_of_range from `pop_back` on an empty vector.
+		 *********************************************************************/
+
+		void clear() noexcept { size = 0; }
+		void shrink_to_fit() noexcept {}
+
+		void pop_back() {
+			if (size == 0)
+				detail::throw_out_of_range("Vector is empty");
+			--size;
+		}
+
+		/*************************************************************************************
+		 * INSERT FUNCTIONS: `insert()` overloads, `try_insert()`
+		 *
+		 * Shifts the tail one slot right and stores `value` at `index`.
+		 *
+		 * Throws: std::out_of_range if `index` > size, std::length_error when full.
+		 *************************************************************************************/
+
+		status try_insert(size_t index, const T& value) noexcept {
+			if (index > size)
+				return status::out_of_range;
+			if (size >= N)
+				return status::length_error;
+			T copy = value;
+			std::memmove(static_cast<void*>(data() + index + 1), data() + index, (size - index) * sizeof(T));
+			data()[index] = copy;
+			++size;
+			return status::ok;
+		}
+
+		void insert(size_t index, const T& value) {
+			detail::raise_if(try_insert(index, value), (size_t(size) + 1) * sizeof(T));
+		}
+
+		Iterator insert(Iterator pos, const T& value) {
+			size_t insert_index = pos - begin();
+			insert(insert_index, value);
+			return Iterator(data() + insert_index);
+		}
+
+		/*********************************************************************
+		 * ERASE FUNCTIONS: `erase()` overloads
+		 *
+		 * Shifts subsequent elements left.
+		 *
+		 * Throws: std::out_of_range.
+		 *********************************************************************/
+
+		void erase(size_t index) {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			std::memmove(static_cast<void*>(data() + index), data() + index + 1, (size - index - 1) * sizeof(T));
+			--size;
+		}
+
+		Iterator erase(Iterator pos) {
+			size_t erase_index = pos - begin();
+			erase(erase_index);
+			return Iterator(data() + erase_index);
+		}
+
+		/// Swaps contents with `other`; O(N) since the elements live inline.
+		void swap(inplace_vector_triv& other) noexcept {
+			std::swap(*this, other);
+		}
+
+		/*********************************************************************
+		 * ITERATORS
+		 *********************************************************************/
+
+		Iterator begin() { return Iterator(data()); }
+		Iterator end() { return Iterator(data() + size); }
+		const_iterator begin() const { return const_iterator(data()); }
+		const_iterator end() const { return const_iterator(data() + size); }
+		const_iterator cbegin() const { return const_iterator(data()); }
+		const_iterator cend() const { return const_iterator(data() + size); }
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+		const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+
+		T& front() { return data()[0]; }
+		T& back() { return data()[size - 1]; }
+		const T& front() const { return data()[0]; }
+		const T& back() const { return data()[size - 1]; }
+
+		Iterator data_get() { return begin(); }
+		const_iterator data_get() const { return cbegin(); }
+	};
+
+	template<typename T, size_t N>
+	class inplace_vector_non_triv {
+	private:
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `storage` - Inline room for `N` elements; only `[0, size)` are constructed.
+		 * `size`    - Number of constructed elements.
+		 *************************************************************************************************/
+		detail::inplace_storage_non_triv<T, N> storage;
+		detail::inplace_size_t<N> size = 0;
+
+		T* data() noexcept { return storage.elems; }
+		const T* data() const noexcept { return storage.elems; }
+
+		template<typename Arg>
+		status append(Arg&& arg) {
+			if (RAW_UNLIKELY(size >= N))
+				return status::length_error;
+			detail::construct(data() + size, std::forward<Arg>(arg));
+			++size;
+			return status::ok;
+		}
+
+		/// Opens a hole at `index` (`index < size < N`) and moves `value` into it.
+		void insert_value(size_t index, T&& value) {
+			detail::construct(data() + size, std::move(data()[size - 1]));
+			++size;
+			for (size_t i = size - 2; i > index; --i)
+				data()[i] = std::move(data()[i - 1]);
+			data()[index] = std::move(value);
+		}
+
+	public:
+		using value_type = T;
+		using Iterator = typename vector_base<T>::template IteratorBase<T>;
+		using const_iterator = typename vector_base<T>::template IteratorBase<const T>;
+		using reverse_iterator = typename vector_base<T>::template ReverseIterator<T>;
+		using const_reverse_iterator = typename vector_base<T>::template ReverseIterator<const T>;
+
+		/*********************************************************************
+		 * CONSTRUCTORS
+		 *
+		 * Default: empty, nothing constructed.
+		 * Size: default-constructs `size_` elements.
+		 * Copy/move: element-wise; `other` keeps its (moved-from) elements.
+		 *
+		 * Throws: std::length_error if `size_` > N, exceptions from T's constructors.
+		 *********************************************************************/
+
+		inplace_vector_non_triv() noexcept {}
+
+		explicit inplace_vector_non_triv(size_t size_) {
+			resize(size_);
+		}
+
+		inplace_vector_non_triv(const inplace_vector_non_triv& other) {
+			for (size_t i = 0; i < other.size; ++i) {
+				detail::construct(data() + i, other.data()[i]);
+				size = static_cast<detail::inplace_size_t<N>>(i + 1);
+			}
+		}
+
+		inplace_vector_non_triv(inplace_vector_non_triv&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+			for (size_t i = 0; i < other.size; ++i) {
+				detail::construct(data() + i, std::move(other.data()[i]));
+				size = static_cast<detail::inplace_size_t<N>>(i + 1);
+			}
+		}
+
+		inplace_vector_non_triv& operator=(const inplace_vector_non_triv& other) {
+			if (this != &other) {
+				clear();
+				for (size_t i = 0; i < other.size; ++i) {
+					detail::construct(data() + i, other.data()[i]);
+					size = static_cast<detail::inplace_size_t<N>>(i + 1);
+				}
+			}
+			return *this;
+		}
+
+		inplace_vector_non_triv& operator=(inplace_vector_non_triv&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+			if (this != &other) {
+				clear();
+				for (size_t i = 0; i < other.size; ++i) {
+					detail::construct(data() + i, std::move(other.data()[i]));
+					size = static_cast<detail::inplace_size_t<N>>(i + 1);
+				}
+			}
+			return *this;
+		}
+
+		~inplace_vector_non_triv() {
+			clear();
+		}
+
+		/*************************************************************************************
+		 * PUSH_BACK FUNCTIONS: `push_back()`, `try_push_back()`, `unchecked_push_back()`
+		 *
+		 * `push_back`           - appends, raises std::length_error when full.
+		 * `try_push_back`       - appends, returns status::length_error when full.
+		 * `unchecked_push_back` - appends; the caller guarantees `size < N`.
+		 *
+		 * Throws: exceptions from T's constructors.
+		 *************************************************************************************/
+
+		void push_back(const T& elem) { detail::raise_if(append(elem), (size_t(size) + 1) * sizeof(T)); }
+		void push_back(T&& elem) { detail::raise_if(append(std::move(elem)), (size_t(size) + 1) * sizeof(T)); }
+		status try_push_back(const T& elem) { return append(elem); }
+		status try_push_back(T&& elem) { return append(std::move(elem)); }
+
+		void unchecked_push_back(const T& elem) {
+			detail::construct(data() + size, elem);
+			++size;
+		}
+		void unchecked_push_back(T&& elem) {
+			detail::construct(data() + size, std::move(elem));
+			++size;
+		}
+
+		/*********************************************************************
+		 * INDEXING FUNCTIONS: `at()`, `operator[]` (const and non-const)
+		 *********************************************************************/
+
+		T& at(const size_t index) {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			return data()[index];
+		}
+
+		const T& at(const size_t index) const {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			return data()[index];
+		}
+
+		T& operator [] (const size_t index) { return data()[index]; }
+		const T& operator [] (const size_t index) const { return data()[index]; }
+
+		/*********************************************************************
+		 * GETTER FUNCTIONS: `get_size()`, `get_data()`, `get_capacity()`, `max_size()`, `empty()`, `is_trivial()`
+		 *********************************************************************/
+
+		size_t get_size() const { return size; }
+		T* get_data() noexcept { return data(); }
+		const T* get_data() const noexcept { return data(); }
+		static constexpr size_t get_capacity() { return N; }
+		static constexpr size_t max_size() noexcept { return N; }
+		bool empty() const { return size == 0; }
+		static constexpr bool is_trivial() { return false; }
+
+		/*************************************************************************************
+		 * SIZE FUNCTIONS: `resize()`, `try_resize()`, `reserve()`, `try_reserve()`
+		 *
+		 * `resize` default-constructs new elements or destroys the tail.
+		 *
+		 * Throws: std::length_error if the size would pass N, exceptions from T's constructor.
+		 *************************************************************************************/
+
+		status try_resize(size_t new_size) {
+			if (new_size > N)
+				return status::length_error;
+			while (size > new_size)
+				pop_back();
+			while (size < new_size) {
+				detail::construct(data() + size);
+				++size;
+			}
+			return status::ok;
+		}
+
+		void resize(size_t new_size) {
+			detail::raise_if(try_resize(new_size), new_size * sizeof(T));
+		}
+
+		status try_reserve(size_t reserve_size) const noexcept {
+			return reserve_size <= N ? status::ok : status::length_error;
+		}
+
+		void reserve(size_t reserve_size) const {
+			detail::raise_if(try_reserve(reserve_size), reserve_size * sizeof(T));
+		}
+
+		/*********************************************************************
+		 * CLEAR, SHRINK_TO_FIT, POP_BACK
+		 *
+		 * Destroy elements only; the storage stays where it is.
+		 *
+		 * Throws: std::out_of_range from `pop_back` on an empty vector.
+		 *********************************************************************/
+
+		void clear() noexcept {
+			while (size > 0) {
+				--size;
+				detail::destroy(data() + size);
+			}
+		}
+
+		void shrink_to_fit() noexcept {}
+
+		void pop_back() {
+			if (size == 0)
+				detail::throw_out_of_range("Vector is empty");
+			--size;
+			detail::destroy(data() + size);
+		}
+
+		/*************************************************************************************
+		 * INSERT FUNCTIONS: `insert()` overloads, `try_insert()`
+		 *
+		 * Throws: std::out_of_range if `index` > size, std::length_error when full,
+		 *         exceptions from T's constructors.
+		 *************************************************************************************/
+
+		status try_insert(size_t index, const T& value) {
+			if (index > size)
+				return status::out_of_range;
+			if (index == size)
+				return append(value);
+			if (size >= N)
+				return status::length_error;
+			insert_value(index, T(value));
+			return status::ok;
+		}
+
+		status try_insert(size_t index, T&& value) {
+			if (index > size)
+				return status::out_of_range;
+			if (index == size)
+				return append(std::move(value));
+			if (size >= N)
+				return status::length_error;
+			insert_value(index, std::move(value));
+			return status::ok;
+		}
+
+		void insert(size_t index, const T& value) {
+			detail::raise_if(try_insert(index, value), (size_t(size) + 1) * sizeof(T));
+		}
+
+		void insert(size_t index, T&& value) {
+			detail::raise_if(try_insert(index, std::move(value)), (size_t(size) + 1) * sizeof(T));
+		}
+
+		Iterator insert(Iterator pos, const T& value) {
+			size_t insert_index = pos - begin();
+			insert(insert_index, value);
+			return Iterator(data() + insert_index);
+		}
+
+		Iterator insert(Iterator pos, T&& value) {
+			size_t insert_index = pos - begin();
+			insert(insert_index, std::move(value));
+			return Iterator(data() + insert_index);
+		}
+
+		/*********************************************************************
+		 * ERASE FUNCTIONS: `erase()` overloads
+		 *
+		 * Move-assigns the tail one slot left, then destroys the last element.
+		 *
+		 * Throws: std::out_of_range.
+		 *********************************************************************/
+
+		void erase(size_t index) {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			for (size_t i = index; i + 1 < size; ++i)
+				data()[i] = std::move(data()[i + 1]);
+			pop_back();
+		}
+
+		Iterator erase(Iterator pos) {
+			size_t erase_index = pos - begin();
+			erase(erase_index);
+			return Iterator(data() + erase_index);
+		}
+
+		/// Swaps contents with `other` element by element.
+		void swap(inplace_vector_non_triv& other) {
+			inplace_vector_non_triv tmp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(tmp);
+		}
+
+		/*********************************************************************
+		 * ITERATORS
+		 *********************************************************************/
+
+		Iterator begin() { return Iterator(data()); }
+		Iterator end() { return Iterator(data() + size); }
+		const_iterator begin() const { return const_iterator(data()); }
+		const_iterator end() const { return const_iterator(data() + size); }
+		const_iterator cbegin() const { return const_iterator(data()); }
+		const_iterator cend() const { return const_iterator(data() + size); }
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+		const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+
+		T& front() { return data()[0]; }
+		T& back() { return data()[size - 1]; }
+		const T& front() const { return data()[0]; }
+		const T& back() const { return data()[size - 1]; }
+
+		Iterator data_get() { return begin(); }
+		const_iterator data_get() const { return cbegin(); }
+	};
+
+	/*********************************************************************
+	 * inplace_vector ALIAS TEMPLATE: `inplace_vector<T, N>`
+	 *
+	 * Chooses between `inplace_vector_triv` and `inplace_vector_non_triv`
+	 * based on `myis_trivial`, like `raw::vector`.
+	 *********************************************************************/
+	template<typename T, size_t N>
+	using inplace_vector = std::conditional_t<myis_trivial<T>::value, inplace_vector_triv<T, N>, inplace_vector_non_triv<T, N>>;
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+#include "RawNamespace/span/RawSpan.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define RAW_HAS_FD_IO 1
+#endif
+
+/************************************************************************
+* File descriptor I/O straight into and out of byte vectors (POSIX).
+*
+* `append_from_fd(v, fd, max)` reads into the vector's spare capacity,
+* so bytes land in their final place with no staging copy. The read
+* size comes from the kernel when it can tell: the remaining length for
+* regular files (fstat), the queued byte count for pipes, sockets and
+* ttys (FIONREAD). The spare area is backed by a 64 KiB stack buffer in
+* the same readv, so a read larger than the hint still completes in one
+* call; only those extra bytes are copied.
+*
+* `write_to_fd(fd, bufs...)` writes one or more byte buffers with one
+* write/writev per round, continuing after partial writes.
+*
+* Both retry on EINTR and stop early, without an error, when a
+* non-blocking descriptor returns EAGAIN.
+***********************************************************************/
+
+#ifdef RAW_HAS_FD_IO
+namespace raw {
+	/*********************************************************************
+	 * STRUCT: `fd_read_result`
+	 *
+	 * `bytes` - bytes appended by the call.
+	 * `eof`   - the descriptor reported end of file.
+	 *********************************************************************/
+	struct fd_read_result {
+		size_t bytes = 0;
+		bool eof = false;
+	};
+
+	namespace detail {
+		/// Spare area offered to a read whose size the kernel could not predict.
+		constexpr size_t fd_default_read = 16 * 1024;
+		/// Stack buffer behind the spare area in every readv.
+		constexpr size_t fd_overflow_bytes = 64 * 1024;
+		/// Cap on one request so the readv total stays far below SSIZE_MAX.
+		constexpr size_t fd_max_request = size_t(1) << 30;
+
+		/*********************************************************************
+		 * FUNCTION: `fd_pending(fd, regular)`
+		 *
+		 * Bytes `fd` can deliver without blocking, 0 if unknown or none.
+		 * Sets `regular` for regular files, which are read until EOF.
+		 *********************************************************************/
+		inline size_t fd_pending(int fd, bool& regular) noexcept {
+			struct stat st;
+			if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+				regular = true;
+				const off_t pos = ::lseek(fd, 0, SEEK_CUR);
+				return pos >= 0 && st.st_size > pos ? static_cast<size_t>(st.st_size - pos) : 0;
+			}
+			int queued = 0;
+			if (::ioctl(fd, FIONREAD, &queued) == 0 && queued > 0)
+				return static_cast<size_t>(queued);
+			return 0;
+		}
+
+		inline bool fd_would_block(int err) noexcept {
+			return err == EAGAIN || err == EWOULDBLOCK;
+		}
+
+		template<typename C>
+		iovec fd_iovec(const C& buffer) noexcept {
+			auto view = span(buffer);
+			static_assert(sizeof(*view.begin()) == 1, "write_to_fd needs byte buffers");
+			return iovec{ const_cast<void*>(static_cast<const void*>(view.begin())), view.get_size() };
+		}
+	}
+
+	/*********************************************************************
+	 * FUNCTION: `append_from_fd(v, fd, max_bytes)`
+	 *
+	 * Appends up to `max_bytes` bytes read from `fd` to `v`. Regular files
+	 * are read up to the size fstat reports at the call (`eof` is then set
+	 * without another read), or until a read returns 0. Other descriptors
+	 * block at most once, in the first read, then keep reading only while
+	 * FIONREAD reports queued bytes, so a socket returns what has arrived
+	 * instead of waiting for the peer to close. A non-blocking descriptor with nothing queued
+	 * returns 0 bytes and `eof == false`.
+	 *
+	 * Throws: std::system_error if a read fails (bytes read before the
+	 *         failure stay appended), allocation failure.
+	 *********************************************************************/
+	template<typename T>
+	fd_read_result append_from_fd(vector_triv<T>& v, int fd, size_t max_bytes = std::numeric_limits<size_t>::max()) {
+		static_assert(sizeof(T) == 1, "append_from_fd needs a byte vector");
+		fd_read_result result;
+		bool regular = false;
+		size_t hint = detail::fd_pending(fd, regular);
+		while (result.bytes < max_bytes) {
+			const size_t room = std::min(max_bytes - result.bytes, detail::fd_max_request);
+			// Regular files: the hint is exact, and 0 means the file ended at the first fstat.
+			const size_t want = hint ? hint : (regular ? 0 : detail::fd_default_read);
+			v.reserve_spare(std::min(want, room));
+
+			const size_t spare = std::min(v.spare_capacity(), room);
+			alignas(16) char overflow[detail::fd_overflow_bytes];
+			iovec iov[2] = {
+				{ v.spare_data(), spare },
+				{ overflow, std::min(detail::fd_overflow_bytes, room - spare) }
+			};
+			const int count = iov[1].iov_len ? 2 : 1;
+			const ssize_t got = ::readv(fd, iov + (spare ? 0 : 1), spare ? count : 1);
+			if (got < 0) {
+				const int err = errno;
+				if (err == EINTR)
+					continue;
+				if (detail::fd_would_block(err))
+					break;
+				detail::throw_system_error(err, "append_from_fd: readv");
+			}
+			if (got == 0) {
+				result.eof = true;
+				break;
+			}
+
+			const size_t n = static_cast<size_t>(got);
+			const size_t direct = std::min(n, spare);
+			v.commit_spare(direct);
+			if (n > direct) {
+				v.reserve_spare(n - direct);
+				std::memcpy(v.spare_data(), overflow, n - direct);
+				v.commit_spare(n - direct);
+			}
+			result.bytes += n;
+
+			if (regular) {
+				// Reaching the size fstat reported is EOF; no probe read needed.
+				if (hint && n >= hint) {
+					result.eof = true;
+					break;
+				}
+				hint = hint ? hint - n : 0;
+			}
+			else if (!(hint = detail::fd_pending(fd, regular)))
+				break;
+		}
+		return result;
+	}
+
+	/*********************************************************************
+	 * FUNCTION: `write_to_fd(fd, bufs...)`
+	 *
+	 * Writes the byte buffers (raw::vector, raw::span, std::string, ...)
+	 * to `fd` in order, gathering them into one writev per round, and
+	 * returns the number of bytes written. That is everything unless a
+	 * non-blocking `fd` filled up; resume with
+	 * `write_to_fd(fd, span(v).subspan(written))`.
+	 *
+	 * Throws: std::system_error if a write fails.
+	 *********************************************************************/
+	template<typename... Bufs>
+	size_t write_to_fd(int fd, const Bufs&... bufs) {
+		static_assert(sizeof...(Bufs) > 0, "write_to_fd needs at least one buffer");
+		iovec iov[sizeof...(Bufs)] = { detail::fd_iovec(bufs)... };
+		size_t first = 0;
+		size_t written = 0;
+		constexpr size_t count = sizeof...(Bufs);
+		while (first < count && iov[first].iov_len == 0)
+			++first;
+		while (first < count) {
+			const ssize_t put = count - first == 1
+				? ::write(fd, iov[first].iov_base, std::min(iov[first].iov_len, detail::fd_max_request))
+				: ::writev(fd, iov + first, static_cast<int>(count - first));
+			if (put < 0) {
+				const int err = errno;
+				if (err == EINTR)
+					continue;
+				if (detail::fd_would_block(err))
+					break;
+				detail::throw_system_error(err, "write_to_fd: writev");
+			}
+			if (put == 0)
+				break;
+			size_t n = static_cast<size_t>(put);
+			written += n;
+			while (first < count && n >= iov[first].iov_len) {
+				n -= iov[first].iov_len;
+				++first;
+			}
+			if (first < count) {
+				iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + n;
+				iov[first].iov_len -= n;
+			}
+		}
+		return written;
+	}
+}
+#endif
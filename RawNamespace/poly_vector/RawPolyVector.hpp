@@ -0,0 +1,570 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/memory_ops.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* raw::poly_vector<Base> - objects of different types derived from
+* `Base`, stored by value back to back in one buffer.
+*
+*     bytes:   [ Circle | pad | Square | Circle | BigThing ........ ]
+*     entries: [ {Base*, offset, ops} {..} {..} {..} ]
+*
+* Each object sits at the next offset aligned for its own type. The
+* entry array records where it starts, its `Base*` (which may differ
+* from the start under multiple inheritance), and a pointer to the
+* static `poly_ops` table of its exact type. The table knows the size,
+* how to relocate and how to destroy, so `Base` needs no virtual
+* destructor and no clone(). The table's address is also the type's
+* identity for `is<D>()`, `get_if<D>()` and `for_each<D>()`.
+*
+* Relocation on growth is a memcpy for trivially copyable types, one
+* move-and-destroy call for nothrow-movable ones, and a copy for the
+* rest; if a copy throws, the objects already moved are moved back, so
+* every operation that relocates leaves the vector unchanged on failure.
+*
+* Iteration in insertion order goes through the entries; an element
+* costs no allocation of its own and its neighbours are adjacent in
+* memory. `group_by_type()` reorders the objects so each dynamic type
+* forms one run, which makes a loop of virtual calls jump to the same
+* target many times in a row.
+*
+* Growth reallocates the whole buffer and relocates every object, so
+* references are invalidated by emplace_back (like raw::vector).
+***********************************************************************/
+
+namespace raw {
+	/*********************************************************************
+	 * STRUCT: `poly_ops<Base>`
+	 *
+	 * Per-type operations, one static instance per derived type.
+	 * `trivial`  - relocate with memcpy, skip destruction.
+	 * `nothrow`  - `relocate` moves into `dst` and destroys `src`, and
+	 *              cannot throw.
+	 * `relocate` - otherwise copies into `dst`; `src` is left alone.
+	 *********************************************************************/
+	template<typename Base>
+	struct poly_ops {
+		size_t size;
+		size_t align;
+		bool trivial;
+		bool nothrow;
+		Base* (*as_base)(void* object) noexcept;
+		void (*relocate)(void* dst, void* src);
+		void (*destroy)(void* object) noexcept;
+	};
+
+	namespace detail {
+		template<typename Base, typename D>
+		struct poly_ops_for {
+			static Base* as_base(void* object) noexcept { return static_cast<D*>(object); }
+			static constexpr bool nothrow = std::is_nothrow_move_constructible<D>::value;
+
+			static void relocate(void* dst, void* src) {
+				D* from = static_cast<D*>(src);
+				if constexpr (nothrow) {
+					::new (dst) D(std::move(*from));
+					from->~D();
+				}
+				else
+					::new (dst) D(static_cast<const D&>(*from));
+			}
+			static void destroy(void* object) noexcept { static_cast<D*>(object)->~D(); }
+
+			static constexpr poly_ops<Base> value = {
+				sizeof(D), alignof(D), myis_trivial<D>::value, nothrow, &as_base, &relocate, &destroy
+			};
+		};
+	}
+
+	template<typename Base>
+	class poly_vector {
+	private:
+		struct entry {
+			Base* object;
+			size_t offset;
+			const poly_ops<Base>* ops;
+		};
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `bytes`      - Object storage, `byte_capacity` bytes aligned to `align`.
+		 * `used`       - Bytes up to the end of the last object.
+		 * `align`      - Alignment of `bytes`: the largest alignment of any type stored so far.
+		 * `entries`    - One per object, in iteration order.
+		 *************************************************************************************************/
+		unsigned char* bytes = nullptr;
+		size_t used = 0;
+		size_t byte_capacity = 0;
+		size_t align = alignof(std::max_align_t);
+		vector_triv<entry> entries;
+
+		static size_t align_up(size_t offset, size_t alignment) noexcept {
+			return (offset + alignment - 1) & ~(alignment - 1);
+		}
+
+		/// malloc (as raw::vector) up to max_align_t; aligned operator new beyond it.
+		static unsigned char* allocate_bytes(size_t n, size_t alignment) noexcept {
+			if (alignment <= alignof(std::max_align_t))
+				return detail::allocate<unsigned char>(n);
+			return static_cast<unsigned char*>(::operator new(n, std::align_val_t(alignment), std::nothrow));
+		}
+
+		static void free_bytes(unsigned char* p, size_t n, size_t alignment) noexcept {
+			if (!p)
+				return;
+			if (alignment <= alignof(std::max_align_t))
+				detail::deallocate(p, n);
+			else
+				::operator delete(p, std::align_val_t(alignment));
+		}
+
+		/*************************************************************************************
+		 * PRIVATE FUNCTION: `relocate_all(dst, n, order, offsets)`
+		 *
+		 * Relocates the first `n` objects (taken in `order`, or entry order if
+		 * null) to `dst + offsets[i]`, or to their current offset if `offsets`
+		 * is null. Nothrow-movable objects leave the old buffer; the others are
+		 * copied, and `release_sources()` destroys the originals on success.
+		 * If a copy throws, the objects built so far are moved back or destroyed
+		 * and the exception propagates with the old buffer intact.
+		 *************************************************************************************/
+		void relocate_all(unsigned char* dst, size_t n, const uint32_t* order, const size_t* offsets) {
+			size_t built = 0;
+			RAW_TRY {
+				for (; built < n; ++built) {
+					const entry& e = entries[order ? order[built] : built];
+					void* to = dst + (offsets ? offsets[built] : e.offset);
+					if (e.ops->trivial)
+						std::memcpy(to, bytes + e.offset, e.ops->size);
+					else
+						e.ops->relocate(to, bytes + e.offset);
+				}
+			}
+			RAW_CATCH_ALL {
+				for (size_t i = 0; i < built; ++i) {
+					const entry& e = entries[order ? order[i] : i];
+					void* from = dst + (offsets ? offsets[i] : e.offset);
+					if (e.ops->nothrow && !e.ops->trivial)
+						e.ops->relocate(bytes + e.offset, from);
+					else if (!e.ops->trivial)
+						e.ops->destroy(from);
+				}
+				RAW_RETHROW;
+			}
+		}
+
+		/// Destroys the originals of the first `n` objects that `relocate_all` copied.
+		void release_sources(size_t n) noexcept {
+			for (size_t i = 0; i < n; ++i) {
+				const entry& e = entries[i];
+				if (!e.ops->trivial && !e.ops->nothrow)
+					e.ops->destroy(bytes + e.offset);
+			}
+		}
+
+		void destroy_all() noexcept {
+			for (size_t i = 0; i < entries.get_size(); ++i) {
+				const entry& e = entries[i];
+				if (!e.ops->trivial)
+					e.ops->destroy(bytes + e.offset);
+			}
+		}
+
+		/// Re-derives every `entry::object` after the objects moved to `bytes`.
+		void rebase() noexcept {
+			for (size_t i = 0; i < entries.get_size(); ++i)
+				entries[i].object = entries[i].ops->as_base(bytes + entries[i].offset);
+		}
+
+		/*************************************************************************************
+		 * PRIVATE FUNCTION: `regrow(required, new_align, place)`
+		 *
+		 * Moves the objects into a new buffer of at least `required` bytes
+		 * (doubling) aligned to `new_align`, after `place(new_bytes)` has
+		 * constructed the object that asked for the room. Offsets do not change:
+		 * the new buffer is at least as aligned as the old one.
+		 *************************************************************************************/
+		template<typename Place>
+		RAW_COLD void regrow(size_t required, size_t new_align, Place&& place) {
+			size_t new_capacity = byte_capacity ? byte_capacity : 256;
+			while (new_capacity < required) {
+				if (new_capacity > (std::numeric_limits<size_t>::max() >> 2))
+					detail::throw_length_error("poly_vector: byte size overflow");
+				new_capacity *= 2;
+			}
+			unsigned char* fresh = allocate_bytes(new_capacity, new_align);
+			if (!fresh)
+				detail::alloc_failure(new_capacity);
+			RAW_TRY {
+				place(fresh);
+			}
+			RAW_CATCH_ALL {
+				free_bytes(fresh, new_capacity, new_align);
+				RAW_RETHROW;
+			}
+			RAW_TRY {
+				relocate_all(fresh, entries.get_size() - 1, nullptr, nullptr);
+			}
+			RAW_CATCH_ALL {
+				const entry& placed = entries.back();
+				placed.ops->destroy(fresh + placed.offset);
+				free_bytes(fresh, new_capacity, new_align);
+				RAW_RETHROW;
+			}
+			release_sources(entries.get_size() - 1);
+			free_bytes(bytes, byte_capacity, align);
+			bytes = fresh;
+			byte_capacity = new_capacity;
+			align = new_align;
+			rebase();
+		}
+
+	public:
+		using value_type = Base;
+
+		/*********************************************************************
+		 * ITERATORS: `Iterator`, `const_iterator`
+		 *
+		 * Random access over the elements as `Base&`, in entry order.
+		 *********************************************************************/
+		template<typename B, typename E>
+		class IteratorBase {
+		private:
+			E* it = nullptr;
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = std::remove_cv_t<B>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = B*;
+			using reference = B&;
+
+			IteratorBase() noexcept = default;
+			explicit IteratorBase(E* it_) noexcept : it(it_) {}
+			template<typename B2, typename E2, typename = std::enable_if_t<std::is_convertible<E2*, E*>::value && !std::is_same<E2, E>::value>>
+			IteratorBase(const IteratorBase<B2, E2>& other) noexcept : it(other.entry_ptr()) {}
+
+			E* entry_ptr() const noexcept { return it; }
+			B& operator *() const noexcept { return *it->object; }
+			B* operator ->() const noexcept { return it->object; }
+			B& operator [](difference_type n) const noexcept { return *it[n].object; }
+
+			IteratorBase& operator ++() noexcept { ++it; return *this; }
+			IteratorBase operator ++(int) noexcept { IteratorBase tmp = *this; ++it; return tmp; }
+			IteratorBase& operator --() noexcept { --it; return *this; }
+			IteratorBase operator --(int) noexcept { IteratorBase tmp = *this; --it; return tmp; }
+			IteratorBase& operator +=(difference_type n) noexcept { it += n; return *this; }
+			IteratorBase& operator -=(difference_type n) noexcept { it -= n; return *this; }
+			friend IteratorBase operator +(IteratorBase a, difference_type n) noexcept { return a += n; }
+			friend IteratorBase operator +(difference_type n, IteratorBase a) noexcept { return a += n; }
+			friend IteratorBase operator -(IteratorBase a, difference_type n) noexcept { return a -= n; }
+			friend difference_type operator -(const IteratorBase& a, const IteratorBase& b) noexcept { return a.it - b.it; }
+
+			friend bool operator ==(const IteratorBase& a, const IteratorBase& b) noexcept { return a.it == b.it; }
+			friend bool operator !=(const IteratorBase& a, const IteratorBase& b) noexcept { return a.it != b.it; }
+			friend bool operator < (const IteratorBase& a, const IteratorBase& b) noexcept { return a.it < b.it; }
+			friend bool operator > (const IteratorBase& a, const IteratorBase& b) noexcept { return a.it > b.it; }
+			friend bool operator <=(const IteratorBase& a, const IteratorBase& b) noexcept { return a.it <= b.it; }
+			friend bool operator >=(const IteratorBase& a, const IteratorBase& b) noexcept { return a.it >= b.it; }
+		};
+
+		using Iterator = IteratorBase<Base, entry>;
+		using const_iterator = IteratorBase<const Base, const entry>;
+
+		poly_vector() noexcept = default;
+
+		/*********************************************************************
+		 * MOVE: constructor, assignment, `swap()`
+		 *
+		 * Takes over the buffer; references stay valid. poly_vector is
+		 * move-only, like a vector of unique_ptr.
+		 *********************************************************************/
+
+		poly_vector(poly_vector&& other) noexcept
+			: bytes(other.bytes), used(other.used), byte_capacity(other.byte_capacity), align(other.align),
+			  entries(std::move(other.entries)) {
+			other.bytes = nullptr;
+			other.used = other.byte_capacity = 0;
+			other.align = alignof(std::max_align_t);
+			other.entries.clear();
+		}
+
+		poly_vector& operator=(poly_vector&& other) noexcept {
+			if (this != &other) {
+				poly_vector stolen(std::move(other));
+				swap(stolen);
+			}
+			return *this;
+		}
+
+		poly_vector(const poly_vector&) = delete;
+		poly_vector& operator=(const poly_vector&) = delete;
+
+		~poly_vector() {
+			destroy_all();
+			free_bytes(bytes, byte_capacity, align);
+		}
+
+		void swap(poly_vector& other) noexcept {
+			std::swap(bytes, other.bytes);
+			std::swap(used, other.used);
+			std::swap(byte_capacity, other.byte_capacity);
+			std::swap(align, other.align);
+			entries.swap(other.entries);
+		}
+
+		/*********************************************************************
+		 * INSERT FUNCTIONS: `emplace_back<D>(args...)`, `push_back(D&& object)`
+		 *
+		 * Constructs a `D` (which must derive from `Base`) at the end of the
+		 * buffer and returns it. Grows by doubling; `args` may refer to
+		 * elements of this vector.
+		 *
+		 * Throws: allocation failure, exceptions from D's constructor or from
+		 *         relocating existing elements (the vector is then unchanged).
+		 *********************************************************************/
+
+		template<typename D, typename... Args>
+		D& emplace_back(Args&&... args) {
+			static_assert(std::is_base_of<Base, D>::value, "poly_vector elements must derive from Base");
+			static_assert(std::is_move_constructible<D>::value || std::is_copy_constructible<D>::value,
+				"poly_vector elements must be relocatable (move or copy constructible)");
+			const poly_ops<Base>* ops = &detail::poly_ops_for<Base, D>::value;
+			const size_t offset = align_up(used, alignof(D));
+			const size_t end = offset + sizeof(D);
+			entries.reserve_spare(1);
+
+			if (RAW_LIKELY(end <= byte_capacity && alignof(D) <= align)) {
+				D* object = ::new (static_cast<void*>(bytes + offset)) D(std::forward<Args>(args)...);
+				entries.push_back(entry{ object, offset, ops });
+			}
+			else {
+				entries.push_back(entry{ nullptr, offset, ops });
+				RAW_TRY {
+					regrow(end, align > alignof(D) ? align : alignof(D), [&](unsigned char* fresh) {
+						::new (static_cast<void*>(fresh + offset)) D(std::forward<Args>(args)...);
+					});
+				}
+				RAW_CATCH_ALL {
+					entries.pop_back();
+					RAW_RETHROW;
+				}
+			}
+			used = end;
+			return *static_cast<D*>(entries.back().object);
+		}
+
+		template<typename D, typename = std::enable_if_t<std::is_base_of<Base, std::decay_t<D>>::value>>
+		std::decay_t<D>& push_back(D&& object) {
+			return emplace_back<std::decay_t<D>>(std::forward<D>(object));
+		}
+
+		/*********************************************************************
+		 * REMOVAL: `pop_back()`, `clear()`
+		 *
+		 * Destroy the last / all objects. The buffer is kept.
+		 *
+		 * Throws: std::out_of_range (`pop_back` on an empty vector).
+		 *********************************************************************/
+
+		void pop_back() {
+			if (entries.get_size() == 0)
+				detail::throw_out_of_range("poly_vector is empty");
+			const entry e = entries.back();
+			entries.pop_back();
+			e.ops->destroy(bytes + e.offset);
+			used = e.offset;
+		}
+
+		void clear() noexcept {
+			destroy_all();
+			entries.clear();
+			used = 0;
+		}
+
+		/*********************************************************************
+		 * RESERVE: `reserve(count, byte_count)`
+		 *
+		 * Room for `count` objects taking `byte_count` bytes (padding
+		 * included) without reallocating.
+		 *
+		 * Throws: allocation failure, exceptions from relocating elements.
+		 *********************************************************************/
+
+		void reserve(size_t count, size_t byte_count) {
+			entries.reserve(count);
+			if (byte_count <= byte_capacity)
+				return;
+			unsigned char* fresh = allocate_bytes(byte_count, align);
+			if (!fresh)
+				detail::alloc_failure(byte_count);
+			RAW_TRY {
+				relocate_all(fresh, entries.get_size(), nullptr, nullptr);
+			}
+			RAW_CATCH_ALL {
+				free_bytes(fresh, byte_count, align);
+				RAW_RETHROW;
+			}
+			release_sources(entries.get_size());
+			free_bytes(bytes, byte_capacity, align);
+			bytes = fresh;
+			byte_capacity = byte_count;
+			rebase();
+		}
+
+		/*********************************************************************
+		 * SIZE FUNCTIONS: `get_size()`, `empty()`, `get_byte_size()`, `get_byte_capacity()`
+		 *********************************************************************/
+
+		size_t get_size() const noexcept { return entries.get_size(); }
+		bool empty() const noexcept { return entries.get_size() == 0; }
+		size_t get_byte_size() const noexcept { return used; }
+		size_t get_byte_capacity() const noexcept { return byte_capacity; }
+
+		/*********************************************************************
+		 * ACCESS: `operator[]`, `at()`, `front()`, `back()`, `is<D>(i)`, `get_if<D>(i)`
+		 *
+		 * `is<D>(i)`     - element `i` is exactly a `D` (not a type derived from it).
+		 * `get_if<D>(i)` - that `D`, or nullptr.
+		 * `at()` throws std::out_of_range; the rest do no bounds checking.
+		 *********************************************************************/
+
+		Base& operator [] (size_t i) noexcept { return *entries[i].object; }
+		const Base& operator [] (size_t i) const noexcept { return *entries[i].object; }
+
+		Base& at(size_t i) {
+			if (i >= entries.get_size())
+				detail::throw_out_of_range("Index out of range");
+			return *entries[i].object;
+		}
+
+		const Base& at(size_t i) const {
+			if (i >= entries.get_size())
+				detail::throw_out_of_range("Index out of range");
+			return *entries[i].object;
+		}
+
+		Base& front() noexcept { return *entries.front().object; }
+		const Base& front() const noexcept { return *entries.front().object; }
+		Base& back() noexcept { return *entries.back().object; }
+		const Base& back() const noexcept { return *entries.back().object; }
+
+		template<typename D>
+		bool is(size_t i) const noexcept { return entries[i].ops == &detail::poly_ops_for<Base, D>::value; }
+
+		template<typename D>
+		D* get_if(size_t i) noexcept { return is<D>(i) ? static_cast<D*>(entries[i].object) : nullptr; }
+
+		template<typename D>
+		const D* get_if(size_t i) const noexcept { return is<D>(i) ? static_cast<const D*>(entries[i].object) : nullptr; }
+
+		/*********************************************************************
+		 * TYPED ITERATION: `for_each<D>(f)`
+		 *
+		 * Calls `f(D&)` for every element whose type is exactly `D`, in order.
+		 * The static type is known, so calls on a `final` D are not virtual.
+		 *********************************************************************/
+
+		template<typename D, typename F>
+		void for_each(F&& f) {
+			const poly_ops<Base>* ops = &detail::poly_ops_for<Base, D>::value;
+			for (size_t i = 0; i < entries.get_size(); ++i) {
+				if (entries[i].ops == ops)
+					f(*static_cast<D*>(entries[i].object));
+			}
+		}
+
+		template<typename D, typename F>
+		void for_each(F&& f) const {
+			const poly_ops<Base>* ops = &detail::poly_ops_for<Base, D>::value;
+			for (size_t i = 0; i < entries.get_size(); ++i) {
+				if (entries[i].ops == ops)
+					f(*static_cast<const D*>(entries[i].object));
+			}
+		}
+
+		/*********************************************************************
+		 * FUNCTION: `group_by_type()`
+		 *
+		 * Stable reorder so that all objects of one dynamic type are adjacent,
+		 * both in iteration order and in memory; types keep the order of their
+		 * first appearance. Rebuilds the buffer, so references are invalidated.
+		 *
+		 * Throws: allocation failure, exceptions from relocating elements
+		 *         (the vector is then unchanged).
+		 *********************************************************************/
+
+		void group_by_type() {
+			const size_t n = entries.get_size();
+			if (n < 2)
+				return;
+			// Types in first-seen order; the loop is quadratic in the number of types, which is small.
+			vector_triv<const poly_ops<Base>*> types;
+			for (size_t i = 0; i < n; ++i) {
+				bool seen = false;
+				for (size_t t = 0; t < types.get_size() && !seen; ++t)
+					seen = types[t] == entries[i].ops;
+				if (!seen)
+					types.push_back(entries[i].ops);
+			}
+			if (types.get_size() == 1)
+				return;
+
+			vector_triv<uint32_t> order;
+			order.reserve(n);
+			for (size_t t = 0; t < types.get_size(); ++t) {
+				for (size_t i = 0; i < n; ++i) {
+					if (entries[i].ops == types[t])
+						order.push_back(static_cast<uint32_t>(i));
+				}
+			}
+
+			vector_triv<size_t> offsets(n);
+			size_t end = 0;
+			for (size_t k = 0; k < n; ++k) {
+				const poly_ops<Base>* ops = entries[order[k]].ops;
+				offsets[k] = align_up(end, ops->align);
+				end = offsets[k] + ops->size;
+			}
+
+			vector_triv<entry> regrouped(n);
+			const size_t capacity = end > byte_capacity ? end : byte_capacity;
+			unsigned char* fresh = allocate_bytes(capacity, align);
+			if (!fresh)
+				detail::alloc_failure(capacity);
+			RAW_TRY {
+				relocate_all(fresh, n, order.get_data(), offsets.get_data());
+			}
+			RAW_CATCH_ALL {
+				free_bytes(fresh, capacity, align);
+				RAW_RETHROW;
+			}
+			release_sources(n);
+			for (size_t k = 0; k < n; ++k) {
+				const poly_ops<Base>* ops = entries[order[k]].ops;
+				regrouped[k] = entry{ ops->as_base(fresh + offsets[k]), offsets[k], ops };
+			}
+			free_bytes(bytes, byte_capacity, align);
+			bytes = fresh;
+			byte_capacity = capacity;
+			used = end;
+			entries.swap(regrouped);
+		}
+
+		Iterator begin() noexcept { return Iterator(entries.get_data()); }
+		Iterator end() noexcept { return Iterator(entries.get_data() + entries.get_size()); }
+		const_iterator begin() const noexcept { return const_iterator(entries.get_data()); }
+		const_iterator end() const noexcept { return const_iterator(entries.get_data() + entries.get_size()); }
+	};
+}
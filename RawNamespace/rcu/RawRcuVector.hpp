@@ -0,0 +1,339 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/span/RawSpan.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* raw::rcu_vector<T> - read-mostly vector: readers never block or write
+* shared memory, writers publish whole new versions.
+*
+*     raw::rcu_vector<route> table(initial_routes);
+*
+*     // each reader thread, once:
+*     auto reader = table.make_reader();
+*     // per lookup:
+*     auto routes = reader.read();          // wait-free
+*     use(routes[i]);                       // stable until `routes` dies
+*
+*     // writers:
+*     auto batch = table.edit();            // private copy of the current version
+*     batch->push_back(r1); (*batch)[7] = r2;
+*     batch.publish();                      // one atomic pointer swap
+*
+* Readers: each reader owns a cache-line-sized slot. `read()` stores the
+* global epoch in it and loads the current version pointer; dropping
+* the snapshot clears the slot. No reader touches a line another thread
+* writes except the version pointer and the epoch, which change only
+* on publish, so reads scale with the number of cores.
+*
+* Writers are serialized by a mutex. A publish swaps the version
+* pointer, stamps the old version with the epoch and advances it. A
+* retired version is freed once every active reader slot holds a later
+* epoch - no reader can still see it. Reclamation runs after every
+* publish; a reader holding a snapshot for a long time delays it (see
+* `get_retired_count()`), it never blocks a writer.
+*
+* The object itself is neither copyable nor movable, and every reader
+* (and so every snapshot) must be gone before it is destroyed.
+***********************************************************************/
+
+namespace raw {
+	namespace detail {
+		/// One reader's announced epoch, alone on its cache line; 0 while not reading.
+		struct alignas(64) rcu_reader_slot {
+			std::atomic<uint64_t> epoch{ 0 };
+			std::atomic<bool> claimed{ false };
+		};
+	}
+
+	template<typename T>
+	class rcu_vector {
+	private:
+		struct version {
+			vector<T> items;
+			uint64_t retired_at = 0;
+			version* next_retired = nullptr;
+
+			version() = default;
+			explicit version(const vector<T>& items_) : items(items_) {}
+			explicit version(vector<T>&& items_) : items(std::move(items_)) {}
+		};
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `current`    - The published version; replaced, never modified.
+		 * `epoch`      - Advanced by every publish; readers announce the value they saw.
+		 * `slots`      - `slot_count` reader slots.
+		 * `writer`     - Serializes edits, publishes and reclamation.
+		 * `retired`    - Unpublished versions not yet freed, newest first (guarded by `writer`).
+		 *************************************************************************************************/
+		std::atomic<version*> current;
+		std::atomic<uint64_t> epoch{ 1 };
+		std::unique_ptr<detail::rcu_reader_slot[]> slots;
+		size_t slot_count;
+		std::mutex writer;
+		version* retired = nullptr;
+		size_t retired_count = 0;
+
+		/// Publishes `fresh` and retires the old version; `writer` is held.
+		void publish_locked(version* fresh) noexcept {
+			version* old = current.exchange(fresh, std::memory_order_seq_cst);
+			old->retired_at = epoch.fetch_add(1, std::memory_order_seq_cst);
+			old->next_retired = retired;
+			retired = old;
+			++retired_count;
+			reclaim_locked();
+		}
+
+		/// Frees the retired versions no active reader can see; `writer` is held.
+		void reclaim_locked() noexcept {
+			uint64_t oldest = std::numeric_limits<uint64_t>::max();
+			for (size_t i = 0; i < slot_count; ++i) {
+				const uint64_t seen = slots[i].epoch.load(std::memory_order_seq_cst);
+				if (seen != 0 && seen < oldest)
+					oldest = seen;
+			}
+			version** link = &retired;
+			while (*link) {
+				version* v = *link;
+				if (v->retired_at < oldest) {
+					*link = v->next_retired;
+					delete v;
+					--retired_count;
+				}
+				else
+					link = &v->next_retired;
+			}
+		}
+
+		void allocate_slots(size_t max_readers) {
+			if (max_readers == 0)
+				detail::throw_invalid_argument("rcu_vector needs at least one reader slot");
+			slots.reset(new detail::rcu_reader_slot[max_readers]);
+			slot_count = max_readers;
+		}
+
+	public:
+		using value_type = T;
+		class reader;
+
+		/*********************************************************************
+		 * CONSTRUCTORS: `rcu_vector(max_readers)`, `rcu_vector(items, max_readers)`
+		 *
+		 * Starts from an empty vector or from `items`. At most `max_readers`
+		 * readers may exist at the same time.
+		 *
+		 * Throws: allocation failure, std::invalid_argument if `max_readers` is 0.
+		 *********************************************************************/
+		explicit rcu_vector(size_t max_readers = 128) : current(nullptr), slot_count(0) {
+			allocate_slots(max_readers);
+			current.store(new version(), std::memory_order_release);
+		}
+
+		explicit rcu_vector(vector<T> items, size_t max_readers = 128) : current(nullptr), slot_count(0) {
+			allocate_slots(max_readers);
+			current.store(new version(std::move(items)), std::memory_order_release);
+		}
+
+		rcu_vector(const rcu_vector&) = delete;
+		rcu_vector& operator=(const rcu_vector&) = delete;
+
+		~rcu_vector() {
+			delete current.load(std::memory_order_relaxed);
+			while (retired) {
+				version* next = retired->next_retired;
+				delete retired;
+				retired = next;
+			}
+		}
+
+		/*********************************************************************
+		 * CLASS: `snapshot`
+		 *
+		 * A published version, readable until the snapshot is destroyed.
+		 * Move-only; no bounds checking.
+		 *********************************************************************/
+		class snapshot {
+		private:
+			reader* owner = nullptr;
+			const version* v = nullptr;
+
+			friend class reader;
+			snapshot(reader* owner_, const version* v_) noexcept : owner(owner_), v(v_) {}
+
+		public:
+			snapshot(snapshot&& other) noexcept : owner(other.owner), v(other.v) { other.owner = nullptr; }
+			snapshot& operator=(snapshot&& other) noexcept {
+				if (this != &other) {
+					if (owner)
+						owner->leave();
+					owner = other.owner;
+					v = other.v;
+					other.owner = nullptr;
+				}
+				return *this;
+			}
+			snapshot(const snapshot&) = delete;
+			snapshot& operator=(const snapshot&) = delete;
+			~snapshot() {
+				if (owner)
+					owner->leave();
+			}
+
+			const T& operator [] (size_t i) const noexcept { return v->items[i]; }
+			const T* get_data() const noexcept { return v->items.get_data(); }
+			size_t get_size() const noexcept { return v->items.get_size(); }
+			bool empty() const noexcept { return v->items.get_size() == 0; }
+			const T* begin() const noexcept { return get_data(); }
+			const T* end() const noexcept { return get_data() + get_size(); }
+			span<const T> get_span() const noexcept { return span<const T>(get_data(), get_size()); }
+		};
+
+		/*********************************************************************
+		 * CLASS: `reader`
+		 *
+		 * A claimed reader slot, for one thread at a time. `read()` is
+		 * wait-free; snapshots from the same reader may nest (the outermost
+		 * one holds the slot). Move-only; must outlive its snapshots.
+		 *********************************************************************/
+		class reader {
+		private:
+			rcu_vector* owner = nullptr;
+			detail::rcu_reader_slot* slot = nullptr;
+			unsigned depth = 0;
+
+			friend class rcu_vector;
+			friend class snapshot;
+			reader(rcu_vector* owner_, detail::rcu_reader_slot* slot_) noexcept : owner(owner_), slot(slot_) {}
+
+			void leave() noexcept {
+				if (--depth == 0)
+					slot->epoch.store(0, std::memory_order_release);
+			}
+
+		public:
+			reader(reader&& other) noexcept : owner(other.owner), slot(other.slot), depth(other.depth) {
+				other.slot = nullptr;
+			}
+			reader(const reader&) = delete;
+			reader& operator=(const reader&) = delete;
+			reader& operator=(reader&&) = delete;
+			~reader() {
+				if (slot)
+					slot->claimed.store(false, std::memory_order_release);
+			}
+
+			snapshot read() noexcept {
+				if (depth++ == 0) {
+					// Announce before loading the version: a writer that then misses the
+					// announcement published before this load, so the load sees its version.
+					slot->epoch.store(owner->epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+				}
+				return snapshot(this, owner->current.load(std::memory_order_seq_cst));
+			}
+		};
+
+		/*********************************************************************
+		 * FUNCTION: `make_reader()`
+		 *
+		 * Claims a free reader slot (lock-free). Call once per reading thread.
+		 *
+		 * Throws: std::length_error if all `max_readers` slots are taken.
+		 *********************************************************************/
+		reader make_reader() {
+			for (size_t i = 0; i < slot_count; ++i) {
+				bool expected = false;
+				if (!slots[i].claimed.load(std::memory_order_relaxed) &&
+					slots[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+					return reader(this, &slots[i]);
+			}
+			detail::throw_length_error("rcu_vector: all reader slots are taken");
+			return reader(this, nullptr);
+		}
+
+		/*********************************************************************
+		 * CLASS: `write_batch`
+		 *
+		 * Holds the writer lock and a private copy of the current version.
+		 * Change it through `*batch` / `batch->`, then `publish()` it as one
+		 * new version. A batch dropped without `publish()` is discarded.
+		 *********************************************************************/
+		class write_batch {
+		private:
+			rcu_vector* owner;
+			std::unique_lock<std::mutex> lock;
+			std::unique_ptr<version> draft;
+
+			friend class rcu_vector;
+			explicit write_batch(rcu_vector* owner_) : owner(owner_), lock(owner_->writer) {
+				draft.reset(new version(owner->current.load(std::memory_order_relaxed)->items));
+			}
+
+		public:
+			write_batch(write_batch&&) noexcept = default;
+
+			vector<T>& operator *() noexcept { return draft->items; }
+			vector<T>* operator ->() noexcept { return &draft->items; }
+
+			/// Makes the draft the current version; the batch is empty afterwards.
+			void publish() noexcept {
+				owner->publish_locked(draft.release());
+				lock.unlock();
+			}
+		};
+
+		/*********************************************************************
+		 * WRITER FUNCTIONS: `edit()`, `update(f)`, `assign(items)`, `reclaim()`
+		 *
+		 * `edit()`      - a write_batch over a copy of the current version.
+		 * `update(f)`   - `f(vector<T>&)` on a copy, then publishes it.
+		 * `assign(v)`   - publishes `v` as the new version without a copy.
+		 * `reclaim()`   - retries freeing retired versions (publishes do this).
+		 *
+		 * Throws: allocation failure, exceptions from T's copy constructor or
+		 *         `f` (nothing is published then).
+		 *********************************************************************/
+		write_batch edit() { return write_batch(this); }
+
+		template<typename F>
+		void update(F&& f) {
+			write_batch batch = edit();
+			f(*batch);
+			batch.publish();
+		}
+
+		void assign(vector<T> items) {
+			std::unique_ptr<version> fresh(new version(std::move(items)));
+			std::lock_guard<std::mutex> guard(writer);
+			publish_locked(fresh.release());
+		}
+
+		void reclaim() {
+			std::lock_guard<std::mutex> guard(writer);
+			reclaim_locked();
+		}
+
+		/*********************************************************************
+		 * MONITORING: `get_retired_count()`, `get_epoch()`, `get_max_readers()`
+		 *
+		 * Retired versions still waiting for readers; the number of publishes
+		 * so far plus one.
+		 *********************************************************************/
+		size_t get_retired_count() {
+			std::lock_guard<std::mutex> guard(writer);
+			return retired_count;
+		}
+
+		uint64_t get_epoch() const noexcept { return epoch.load(std::memory_order_relaxed); }
+		size_t get_max_readers() const noexcept { return slot_count; }
+	};
+}
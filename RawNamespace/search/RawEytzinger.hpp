@@ -0,0 +1,291 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/span/RawSpan.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* raw::eytzinger_array<T, Compare> - read-only sorted set laid out in
+* breadth-first (Eytzinger) order for fast lower_bound.
+*
+* The sorted input becomes an implicit binary search tree: slot 1 is
+* the root and the children of slot k are 2k and 2k + 1. A search then
+* reads slots 1, 2..3, 4..7, ... so the top levels stay hot in cache,
+* and the 16 descendants four levels below k are the contiguous slots
+* 16k .. 16k + 15. Each step prefetches that block, so the memory
+* latency of a level overlaps with the four levels above it. Slot 0 is
+* placed on a 64-byte boundary to keep those blocks line-aligned.
+*
+* The descent has no data-dependent branch: `k = 2k + (b[k] < key)`,
+* and the number of steps only depends on the size. The answer is
+* recovered from the bits of the final `k`: the last left turn.
+*
+* `lower_bound_batch` runs 16 searches in lockstep, one level at a
+* time, so their loads are independent and the misses overlap. It does
+* not prefetch: 16 lanes already keep the line fill buffers busy, and
+* measured slower with the extra prefetches.
+*
+* Results are slot indices (0-based, in layout order): index with
+* `operator[]`, or lay out a parallel payload array in the same order
+* with `permute()`. A miss returns `get_size()`.
+***********************************************************************/
+
+namespace raw {
+	namespace detail {
+		inline unsigned eytzinger_ctz(uint64_t word) noexcept {
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64(&index, word);
+			return static_cast<unsigned>(index);
+#else
+			return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+		}
+	}
+
+	template<typename T, typename Compare>
+	class eytzinger_array {
+	private:
+		/// Searches interleaved by `lower_bound_batch`.
+		static constexpr size_t batch_lanes = 16;
+		/// Prefetch distance: the 2^4 descendants four levels down.
+		static constexpr size_t prefetch_block = 16;
+		static constexpr size_t prefetch_bytes = prefetch_block * sizeof(T);
+		static constexpr size_t prefetch_lines = prefetch_bytes < 64 ? 1 : (prefetch_bytes > 256 ? 4 : prefetch_bytes / 64);
+		static constexpr bool aligned_layout = myis_trivial<T>::value && sizeof(T) <= alignof(std::max_align_t) &&
+			(sizeof(T) & (sizeof(T) - 1)) == 0;
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `items`  - `pad` unused slots, slot 0 (unused), then slots 1..`count` in Eytzinger order.
+		 * `pad`    - Puts slot 0 on a 64-byte boundary; 0 unless `aligned_layout`.
+		 * `count`  - Number of elements.
+		 * `levels` - Complete tree levels, floor(log2(count + 1)): steps every search takes.
+		 *************************************************************************************************/
+		vector<T> items;
+		size_t pad = 0;
+		size_t count = 0;
+		unsigned levels = 0;
+		Compare comp;
+
+		const T* base() const noexcept { return items.get_data() + pad; }
+
+		/// Allocates slots 0..`count` with slot 0 on a 64-byte boundary; returns slot 0.
+		T* allocate_layout() {
+			items.reserve(count + 1 + (aligned_layout ? 64 / sizeof(T) : 0));
+			if constexpr (aligned_layout) {
+				const uintptr_t address = reinterpret_cast<uintptr_t>(items.get_data());
+				pad = ((64 - address % 64) % 64) / sizeof(T);
+			}
+			items.resize(pad + count + 1);
+			return items.get_data() + pad;
+		}
+
+		/// Calls `f(slot, rank)` for slots 1..n in sorted (in-order) order, iteratively.
+		template<typename F>
+		static void for_each_in_order(size_t n, F&& f) {
+			if (n == 0)
+				return;
+			size_t k = 1;
+			while (2 * k <= n)
+				k *= 2;
+			for (size_t rank = 0; rank < n; ++rank) {
+				f(k, rank);
+				if (2 * k + 1 <= n) {
+					k = 2 * k + 1;
+					while (2 * k <= n)
+						k *= 2;
+				}
+				else {
+					// Climb while k is a right child, then once more to its parent.
+					k >>= detail::eytzinger_ctz(~uint64_t(k)) + 1;
+				}
+			}
+		}
+
+		static void prefetch_descendants(const T* b, size_t k) noexcept {
+			// Integer address math: the block may lie past the end near the leaves.
+			const uintptr_t block = reinterpret_cast<uintptr_t>(b) + k * prefetch_bytes;
+			RAW_UNROLL
+			for (size_t line = 0; line < prefetch_lines; ++line)
+				RAW_PREFETCH(reinterpret_cast<const char*>(block + line * 64));
+		}
+
+		/// Maps the exit slot of a descent to the result slot.
+		size_t finish(size_t k) const noexcept {
+			k >>= detail::eytzinger_ctz(~uint64_t(k)) + 1;
+			return k ? k - 1 : count;
+		}
+
+	public:
+		using value_type = T;
+		using value_compare = Compare;
+
+		explicit eytzinger_array(const Compare& comp_ = Compare()) : comp(comp_) {}
+
+		/*********************************************************************
+		 * CONSTRUCTOR: `eytzinger_array(span<const T> sorted, comp)`
+		 *
+		 * Lays out `sorted` (ascending by `comp`; raw::vector, std::vector,
+		 * arrays...) in O(n). Duplicates are allowed; lower_bound then finds
+		 * the first of them.
+		 *
+		 * Throws: allocation failure, std::length_error past 2^63 elements.
+		 *********************************************************************/
+		explicit eytzinger_array(span<const T> sorted, const Compare& comp_ = Compare()) : comp(comp_) {
+			count = sorted.get_size();
+			if (count >= (size_t(1) << 63))
+				detail::throw_length_error("eytzinger_array is too large");
+			while ((size_t(2) << levels) <= count + 1)
+				++levels;
+			T* b = allocate_layout();
+			const T* source = sorted.begin();
+			for_each_in_order(count, [&](size_t slot, size_t rank) { b[slot] = source[rank]; });
+		}
+
+		/*********************************************************************
+		 * COPY / MOVE: constructors, assignment, `swap()`
+		 *
+		 * A copy gets its own aligned layout; a move takes the buffer.
+		 *********************************************************************/
+
+		eytzinger_array(const eytzinger_array& other) : count(other.count), levels(other.levels), comp(other.comp) {
+			T* b = allocate_layout();
+			const T* source = other.base();
+			for (size_t k = 1; k <= count; ++k)
+				b[k] = source[k];
+		}
+
+		eytzinger_array(eytzinger_array&& other) noexcept
+			: items(std::move(other.items)), pad(other.pad), count(other.count), levels(other.levels), comp(std::move(other.comp)) {
+			other.pad = other.count = 0;
+			other.levels = 0;
+		}
+
+		eytzinger_array& operator=(eytzinger_array other) noexcept {
+			swap(other);
+			return *this;
+		}
+
+		void swap(eytzinger_array& other) noexcept {
+			items.swap(other.items);
+			std::swap(pad, other.pad);
+			std::swap(count, other.count);
+			std::swap(levels, other.levels);
+			std::swap(comp, other.comp);
+		}
+
+		/*********************************************************************
+		 * LOOKUP: `lower_bound(key)`, `contains(key)`
+		 *
+		 * `lower_bound` returns the slot of the first element not less than
+		 * `key`, or `get_size()` if there is none. `key` may be any type
+		 * `comp(element, key)` accepts.
+		 *********************************************************************/
+
+		template<typename K>
+		size_t lower_bound(const K& key) const {
+			if (RAW_UNLIKELY(count == 0))
+				return 0;
+			const T* b = base();
+			size_t k = 1;
+			for (unsigned level = 0; level < levels; ++level) {
+				prefetch_descendants(b, k);
+				k = 2 * k + static_cast<size_t>(comp(b[k], key));
+			}
+			// The last level may be partial; slot 0 stands in where it has no node.
+			const size_t last = k <= count ? k : 0;
+			const size_t stepped = 2 * k + static_cast<size_t>(comp(b[last], key));
+			return finish(last ? stepped : k);
+		}
+
+		template<typename K>
+		bool contains(const K& key) const {
+			const size_t slot = lower_bound(key);
+			return slot < count && !comp(key, (*this)[slot]);
+		}
+
+		/*********************************************************************
+		 * BATCHED LOOKUP: `lower_bound_batch(keys, out)`, `lower_bound_batch(keys)`
+		 *
+		 * `out[i] = lower_bound(keys[i])`. Groups of 16 searches advance one
+		 * level at a time together, so up to 16 cache misses are in flight.
+		 *
+		 * Throws: std::invalid_argument if `out` is shorter than `keys`;
+		 *         allocation failure (second overload).
+		 *********************************************************************/
+
+		void lower_bound_batch(span<const T> keys, span<size_t> out) const {
+			const size_t n = keys.get_size();
+			if (out.get_size() < n)
+				detail::throw_invalid_argument("lower_bound_batch: output is shorter than the keys");
+			const T* b = base();
+			const T* key = keys.begin();
+			size_t* result = out.begin();
+			size_t i = 0;
+			for (; count != 0 && i + batch_lanes <= n; i += batch_lanes) {
+				size_t k[batch_lanes];
+				RAW_UNROLL
+				for (size_t lane = 0; lane < batch_lanes; ++lane)
+					k[lane] = 1;
+				for (unsigned level = 0; level < levels; ++level) {
+					RAW_UNROLL
+					for (size_t lane = 0; lane < batch_lanes; ++lane)
+						k[lane] = 2 * k[lane] + static_cast<size_t>(comp(b[k[lane]], key[i + lane]));
+				}
+				RAW_UNROLL
+				for (size_t lane = 0; lane < batch_lanes; ++lane) {
+					const size_t last = k[lane] <= count ? k[lane] : 0;
+					const size_t stepped = 2 * k[lane] + static_cast<size_t>(comp(b[last], key[i + lane]));
+					result[i + lane] = finish(last ? stepped : k[lane]);
+				}
+			}
+			for (; i < n; ++i)
+				result[i] = lower_bound(key[i]);
+		}
+
+		vector<size_t> lower_bound_batch(span<const T> keys) const {
+			vector<size_t> out(keys.get_size());
+			lower_bound_batch(keys, span<size_t>(out));
+			return out;
+		}
+
+		/*********************************************************************
+		 * PAYLOADS: `permute(sorted_values)`
+		 *
+		 * Returns `sorted_values` (one per element, in the sorted order the
+		 * array was built from) rearranged into slot order, so a slot from
+		 * `lower_bound` indexes it directly.
+		 *
+		 * Throws: std::invalid_argument if the sizes differ, allocation failure.
+		 *********************************************************************/
+
+		template<typename V>
+		vector<V> permute(span<const V> sorted_values) const {
+			if (sorted_values.get_size() != count)
+				detail::throw_invalid_argument("permute: payload size differs from the array");
+			vector<V> out(count);
+			const V* source = sorted_values.begin();
+			for_each_in_order(count, [&](size_t slot, size_t rank) { out[slot - 1] = source[rank]; });
+			return out;
+		}
+
+		/*********************************************************************
+		 * ACCESS: `operator[](slot)`, `get_data()`, `get_size()`, `empty()`
+		 *
+		 * Elements in slot order. No bounds checking.
+		 *********************************************************************/
+
+		const T& operator [] (size_t slot) const noexcept { return base()[slot + 1]; }
+		const T* get_data() const noexcept { return base() + 1; }
+		size_t get_size() const noexcept { return count; }
+		bool empty() const noexcept { return count == 0; }
+	};
+}
@@ -0,0 +1,289 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+#include "RawNamespace/span/RawSpan.hpp"
+
+/************************************************************************
+* raw::slot_map<T> - dense storage addressed by generational handles.
+*
+* The elements live packed in one raw::vector (`values`), so iterating
+* them is a plain array walk. A handle names a *slot*, not a position:
+*
+*     slots:  [ {dense index | next free, generation} ... ]
+*     values: [ v0 v1 v2 ... ]        owner: [ slot of v0, slot of v1, ... ]
+*
+* Lookup follows `slots[handle.index].index` into `values`, O(1). Erase
+* moves the last element into the hole (swap-and-pop) and patches the
+* moved element's slot through `owner`, O(1). The freed slot goes to the
+* back of a FIFO free list and its generation is bumped, so handles to
+* the erased element stop resolving even after the slot is reused.
+*
+* Generations are odd while a slot is occupied and even while it is free.
+* A slot whose generation would wrap around is retired instead of reused.
+*
+* Handles stay valid until their element is erased. Pointers, references
+* and dense positions are invalidated by any insert and by erasing any
+* element, because the last element moves.
+***********************************************************************/
+
+namespace raw {
+	/*********************************************************************
+	 * STRUCT: `slot_handle`
+	 *
+	 * Stable name of a slot_map element: the slot index plus the generation
+	 * the slot had when the element was inserted. A default-constructed
+	 * handle never resolves.
+	 *********************************************************************/
+	struct slot_handle {
+		uint32_t index = std::numeric_limits<uint32_t>::max();
+		uint32_t generation = 0;
+
+		friend constexpr bool operator ==(const slot_handle& a, const slot_handle& b) noexcept {
+			return a.index == b.index && a.generation == b.generation;
+		}
+		friend constexpr bool operator !=(const slot_handle& a, const slot_handle& b) noexcept { return !(a == b); }
+	};
+
+	template<typename T>
+	class slot_map {
+	private:
+		struct slot_entry {
+			uint32_t index;
+			uint32_t generation;
+		};
+
+		static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+		/// Parked generation for slots that ran out of generations; even, so never matches a handle.
+		static constexpr uint32_t retired = npos - 1;
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `values`    - The elements, dense.
+		 * `owner`     - `owner[i]` is the slot that points at `values[i]`.
+		 * `slots`     - One entry per slot ever handed out. Occupied: dense index of the element.
+		 *               Free: next slot in the free list (`npos` at the tail).
+		 * `free_head` - Oldest free slot, reused first; `npos` if none.
+		 * `free_tail` - Newest free slot; `npos` if none.
+		 *************************************************************************************************/
+		vector<T> values;
+		vector_triv<uint32_t> owner;
+		vector_triv<slot_entry> slots;
+		uint32_t free_head = npos;
+		uint32_t free_tail = npos;
+
+		const slot_entry* resolve(slot_handle h) const noexcept {
+			if (h.index >= slots.get_size())
+				return nullptr;
+			const slot_entry& s = slots[h.index];
+			return (s.generation == h.generation && (s.generation & 1u)) ? &s : nullptr;
+		}
+
+		void push_free(uint32_t slot) noexcept {
+			slots[slot].index = npos;
+			if (free_tail == npos)
+				free_head = slot;
+			else
+				slots[free_tail].index = slot;
+			free_tail = slot;
+		}
+
+		/// Bumps the generation of an occupied slot and returns it to the free list.
+		void release_slot(uint32_t slot) noexcept {
+			slot_entry& s = slots[slot];
+			if (RAW_UNLIKELY(++s.generation == 0)) {
+				s.generation = retired;
+				return;
+			}
+			push_free(slot);
+		}
+
+		/*************************************************************************************
+		 * PRIVATE FUNCTION: `insert_value(Arg&&)`
+		 *
+		 * Makes sure a free slot exists, appends to `owner` and then to `values`,
+		 * and only then takes the slot off the free list. A throw at any step
+		 * leaves the map as it was (a freshly added slot just stays free).
+		 *************************************************************************************/
+		template<typename Arg>
+		slot_handle insert_value(Arg&& arg) {
+			if (free_head == npos) {
+				if (RAW_UNLIKELY(slots.get_size() >= retired))
+					detail::throw_length_error("slot_map: out of slot indices");
+				slots.push_back(slot_entry{ npos, 0 });
+				push_free(static_cast<uint32_t>(slots.get_size() - 1));
+			}
+			const uint32_t slot = free_head;
+			owner.push_back(slot);
+			RAW_TRY {
+				values.push_back(std::forward<Arg>(arg));
+			}
+			RAW_CATCH_ALL {
+				owner.pop_back();
+				RAW_RETHROW;
+			}
+			slot_entry& s = slots[slot];
+			free_head = s.index;
+			if (free_head == npos)
+				free_tail = npos;
+			s.index = static_cast<uint32_t>(values.get_size() - 1);
+			++s.generation;
+			return slot_handle{ slot, s.generation };
+		}
+
+	public:
+		using value_type = T;
+		using handle = slot_handle;
+		using iterator = typename vector<T>::Iterator;
+		using const_iterator = typename vector<T>::const_iterator;
+
+		slot_map() = default;
+
+		/*********************************************************************
+		 * SIZE FUNCTIONS: `get_size()`, `empty()`, `slot_count()`, `reserve(n)`
+		 *
+		 * `slot_count()` - slots ever handed out, occupied or free.
+		 * `reserve(n)`   - room for `n` elements without reallocating.
+		 *
+		 * Throws: allocation failure.
+		 *********************************************************************/
+
+		size_t get_size() const noexcept { return values.get_size(); }
+		bool empty() const noexcept { return values.get_size() == 0; }
+		size_t slot_count() const noexcept { return slots.get_size(); }
+
+		void reserve(size_t n) {
+			values.reserve(n);
+			owner.reserve(n);
+			slots.reserve(n);
+		}
+
+		/*********************************************************************
+		 * INSERT FUNCTIONS: `insert(value)`, `emplace(args...)`
+		 *
+		 * Appends the element to the dense array and returns its handle.
+		 * Reuses the oldest free slot if there is one. Amortized O(1).
+		 *
+		 * Throws: allocation failure, std::length_error once 2^32 - 1 slots
+		 *         exist, exceptions from T's constructor. The map is unchanged
+		 *         if anything throws.
+		 *********************************************************************/
+
+		slot_handle insert(const T& value) { return insert_value(value); }
+		slot_handle insert(T&& value) { return insert_value(std::move(value)); }
+
+		template<typename... Args>
+		slot_handle emplace(Args&&... args) { return insert_value(T(std::forward<Args>(args)...)); }
+
+		/*********************************************************************
+		 * ERASE FUNCTIONS: `erase(handle)`, `clear()`
+		 *
+		 * `erase(handle)` - moves the last element into the erased one's place
+		 *                   and pops the back. Returns false (and does nothing)
+		 *                   if the handle is stale. O(1).
+		 * `clear()`       - erases everything; every outstanding handle goes stale.
+		 *
+		 * Throws: exceptions from T's move assignment (the map is then
+		 *         unchanged apart from the moved-from element).
+		 *********************************************************************/
+
+		bool erase(slot_handle h) {
+			const slot_entry* s = resolve(h);
+			if (!s)
+				return false;
+			const uint32_t pos = s->index;
+			const uint32_t last = static_cast<uint32_t>(values.get_size() - 1);
+			if (pos != last) {
+				values[pos] = std::move(values[last]);
+				owner[pos] = owner[last];
+				slots[owner[pos]].index = pos;
+			}
+			values.pop_back();
+			owner.pop_back();
+			release_slot(h.index);
+			return true;
+		}
+
+		void clear() {
+			for (size_t i = 0; i < owner.get_size(); ++i)
+				release_slot(owner[i]);
+			values.clear();
+			owner.clear();
+		}
+
+		/*********************************************************************
+		 * LOOKUP FUNCTIONS: `get(handle)`, `contains(handle)`, `at(handle)`, `operator[](handle)`
+		 *
+		 * `get()`        - pointer to the element, nullptr if the handle is stale.
+		 * `at()`         - reference, throws std::out_of_range if the handle is stale.
+		 * `operator[]`   - no check; the handle must be live.
+		 *********************************************************************/
+
+		T* get(slot_handle h) noexcept {
+			const slot_entry* s = resolve(h);
+			return s ? values.get_data() + s->index : nullptr;
+		}
+
+		const T* get(slot_handle h) const noexcept {
+			const slot_entry* s = resolve(h);
+			return s ? values.get_data() + s->index : nullptr;
+		}
+
+		bool contains(slot_handle h) const noexcept { return resolve(h) != nullptr; }
+
+		T& at(slot_handle h) {
+			T* p = get(h);
+			if (!p)
+				detail::throw_out_of_range("Stale slot_map handle");
+			return *p;
+		}
+
+		const T& at(slot_handle h) const {
+			const T* p = get(h);
+			if (!p)
+				detail::throw_out_of_range("Stale slot_map handle");
+			return *p;
+		}
+
+		T& operator [] (slot_handle h) noexcept { return values[slots[h.index].index]; }
+		const T& operator [] (slot_handle h) const noexcept { return values[slots[h.index].index]; }
+
+		/*********************************************************************
+		 * DENSE ACCESS: `begin()`, `end()`, `get_data()`, `values_span()`, `handle_at(pos)`
+		 *
+		 * The elements in dense order, which is insertion order until the
+		 * first erase. `handle_at(pos)` is the handle of the element at dense
+		 * position `pos` (no bounds check).
+		 *********************************************************************/
+
+		iterator begin() noexcept { return values.begin(); }
+		iterator end() noexcept { return values.end(); }
+		const_iterator begin() const noexcept { return values.begin(); }
+		const_iterator end() const noexcept { return values.end(); }
+
+		T* get_data() noexcept { return values.get_data(); }
+		const T* get_data() const noexcept { return values.get_data(); }
+
+		span<T> values_span() noexcept { return span<T>(values.get_data(), values.get_size()); }
+		span<const T> values_span() const noexcept { return span<const T>(values.get_data(), values.get_size()); }
+
+		slot_handle handle_at(size_t pos) const noexcept {
+			const uint32_t slot = owner[pos];
+			return slot_handle{ slot, slots[slot].generation };
+		}
+
+		void swap(slot_map& other) noexcept {
+			values.swap(other.values);
+			owner.swap(other.owner);
+			slots.swap(other.slots);
+			std::swap(free_head, other.free_head);
+			std::swap(free_tail, other.free_tail);
+		}
+	};
+}
@@ -0,0 +1,408 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawParallel.hpp"
+#include "RawNamespace/vector/memory_ops.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+#include "RawNamespace/span/RawSpan.hpp"
+
+/************************************************************************
+* LSD radix sort for trivially copyable elements.
+*
+*     raw::vector<float> v = ...;
+*     raw::radix_sort(v);                                   // ascending
+*     raw::radix_sort_by_key(records, [](const rec& r) { return r.id; });
+*     raw::vector<uint32_t> order = raw::argsort(scores);  // stable
+*
+* Keys are integers or float/double. Each key is mapped to an unsigned
+* integer with the same order (sign bit flipped for signed types; for
+* floating point negative values are inverted), then sorted one digit at
+* a time from the lowest. A single read of the input builds the histogram
+* of every digit; a digit that is the same for every key costs no pass,
+* and already sorted input returns after one scan. Up to 64 plain keys
+* go through a sorting network instead.
+*
+* Floating point order is the IEEE total order: -NaN < -inf < ... < -0.0
+* < +0.0 < ... < +inf < +NaN. Sorting takes one scratch buffer of the
+* input's size (std::bad_alloc, or the alloc-failure handler, if it
+* cannot be had).
+***********************************************************************/
+
+namespace raw {
+	/*********************************************************************
+	 * OPTIONS: `radix_options`
+	 *
+	 * `digit_bits` - 1..16 bits per pass; 0 picks 8, or 11 for 4M+ keys of
+	 *                32/64 bits (fewer passes over memory that no longer
+	 *                fits in cache), or 16 for 1M+ keys of 16 bits (one pass).
+	 * `threads`    - worker threads for large inputs; 0 uses every hardware
+	 *                thread. Each pass then counts and scatters one slice of
+	 *                the buffer per thread. Inputs below 64K elements always
+	 *                run on the calling thread.
+	 *********************************************************************/
+	struct radix_options {
+		unsigned digit_bits = 0;
+		unsigned threads = 1;
+	};
+
+	namespace detail {
+		/*********************************************************************
+		 * KEY ENCODING: `radix_key<K>`
+		 *
+		 * `encode(k)` - unsigned integer with the same order as `k`.
+		 * `decode(u)` - the inverse, used by the sorting-network path.
+		 *********************************************************************/
+		template<typename K, typename = void>
+		struct radix_key;
+
+		template<typename K>
+		struct radix_key<K, std::enable_if_t<std::is_integral<K>::value && !std::is_same<K, bool>::value>> {
+			using bits = std::make_unsigned_t<K>;
+			static constexpr bits flip = std::is_signed<K>::value ? bits(bits(1) << (sizeof(K) * 8 - 1)) : bits(0);
+			static bits encode(K k) noexcept { return bits(bits(k) ^ flip); }
+			static K decode(bits u) noexcept { return K(bits(u ^ flip)); }
+		};
+
+		template<typename K>
+		struct radix_key<K, std::enable_if_t<std::is_floating_point<K>::value>> {
+			static_assert(sizeof(K) == 4 || sizeof(K) == 8, "radix sort supports float and double keys");
+			using bits = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+			static constexpr unsigned top = sizeof(K) * 8 - 1;
+			static constexpr bits sign = bits(1) << top;
+			static bits encode(K k) noexcept {
+				bits u;
+				std::memcpy(&u, &k, sizeof(u));
+				return u ^ ((bits(0) - (u >> top)) | sign);
+			}
+			static K decode(bits u) noexcept {
+				u ^= (u >> top) ? sign : ~bits(0);
+				K k;
+				std::memcpy(&k, &u, sizeof(k));
+				return k;
+			}
+		};
+
+		template<typename K>
+		using radix_bits_t = typename radix_key<std::remove_cv_t<K>>::bits;
+
+		/// Uninitialized buffer of trivially copyable elements, freed on scope exit.
+		template<typename T>
+		class radix_scratch {
+		private:
+			T* ptr;
+			size_t count;
+		public:
+			explicit radix_scratch(size_t count_) : ptr(allocate<T>(count_)), count(count_) {
+				if (!ptr && count_)
+					alloc_failure(count_ * sizeof(T));
+			}
+			radix_scratch(const radix_scratch&) = delete;
+			radix_scratch& operator=(const radix_scratch&) = delete;
+			~radix_scratch() { deallocate(ptr, count); }
+			T* get() const noexcept { return ptr; }
+		};
+
+		inline unsigned radix_digit_bits(unsigned requested, size_t n, size_t key_bytes) {
+			if (requested > 16)
+				throw_invalid_argument("radix_options::digit_bits must be 0..16");
+			if (requested)
+				return requested;
+			if (key_bytes == 2 && n >= (size_t(1) << 20))
+				return 16;
+			if (key_bytes >= 4 && n >= (size_t(1) << 22))
+				return 11;
+			return 8;
+		}
+
+		constexpr size_t radix_parallel_min = size_t(1) << 16;
+		constexpr size_t radix_items_per_thread = radix_parallel_min / 4;
+
+		/*********************************************************************
+		 * SMALL SORTS: `network_sort<N>()`, `insertion_sort_by_key()`
+		 *
+		 * `network_sort` - bitonic network over N encoded keys (N a power of
+		 *                  two). Every stage is unrolled at compile time and
+		 *                  compares two contiguous runs of constant length
+		 *                  with min/max and no branches, so the wide stages
+		 *                  become vector min/max. Not stable, which is fine
+		 *                  for plain keys.
+		 * `insertion_sort_by_key` - the stable fallback for records.
+		 *********************************************************************/
+		template<size_t J, typename U>
+		void compare_exchange_run(U* lo, U* hi) noexcept {
+			for (size_t t = 0; t < J; ++t) {
+				U a = lo[t], b = hi[t];
+				lo[t] = a < b ? a : b;
+				hi[t] = a < b ? b : a;
+			}
+		}
+
+		/// Stage (K, J) of the bitonic network: runs of J compared with the run J
+		/// further on, descending where bit K of the position is set.
+		template<size_t N, size_t K, size_t J, typename U>
+		void bitonic_stage(U* v) noexcept {
+			for (size_t base = 0; base < N; base += 2 * J) {
+				if ((base & K) == 0)
+					compare_exchange_run<J>(v + base, v + base + J);
+				else
+					compare_exchange_run<J>(v + base + J, v + base);
+			}
+			if constexpr (J > 1)
+				bitonic_stage<N, K, J / 2>(v);
+			else if constexpr (K < N)
+				bitonic_stage<N, K * 2, K>(v);
+		}
+
+		template<size_t N, typename U>
+		void network_sort(U* v) noexcept { bitonic_stage<N, 2, 1>(v); }
+
+		constexpr size_t radix_network_max = 64;
+
+		template<typename K>
+		void small_sort_keys(K* data, size_t n) noexcept {
+			using U = radix_bits_t<K>;
+			U buffer[radix_network_max];
+			for (size_t i = 0; i < n; ++i)
+				buffer[i] = radix_key<K>::encode(data[i]);
+			size_t width = 4;
+			while (width < n)
+				width <<= 1;
+			for (size_t i = n; i < width; ++i)
+				buffer[i] = std::numeric_limits<U>::max();
+			switch (width) {
+			case 4: network_sort<4>(buffer); break;
+			case 8: network_sort<8>(buffer); break;
+			case 16: network_sort<16>(buffer); break;
+			case 32: network_sort<32>(buffer); break;
+			default: network_sort<64>(buffer); break;
+			}
+			for (size_t i = 0; i < n; ++i)
+				data[i] = radix_key<K>::decode(buffer[i]);
+		}
+
+		template<typename T, typename KeyFn>
+		void insertion_sort_by_key(T* data, size_t n, const KeyFn& key) {
+			for (size_t i = 1; i < n; ++i) {
+				T item = data[i];
+				auto k = key(item);
+				size_t j = i;
+				for (; j > 0 && k < key(data[j - 1]); --j)
+					data[j] = data[j - 1];
+				data[j] = item;
+			}
+		}
+
+		/*********************************************************************
+		 * ENGINE: `lsd_sort(data, n, key, options)`
+		 *
+		 * `key(item)` returns the encoded unsigned key. Stable. Input that
+		 * is already in order is detected by a scan that stops at the first
+		 * descent. Single threaded, one histogram read then gives every
+		 * digit's counts up front; with threads each pass counts its digit
+		 * per slice, then every slice scatters into its own offsets.
+		 *
+		 * `lsd_passes<Bits>` is instantiated for the usual 8/11/16-bit
+		 * digits so shifts, masks and the pass count are constants;
+		 * `Bits == 0` takes them from `bits` at run time.
+		 *********************************************************************/
+		template<unsigned Bits, typename T, typename KeyFn>
+		void lsd_passes(T* data, T* scratch, size_t n, const KeyFn& key, unsigned runtime_bits, unsigned threads) {
+			using U = std::decay_t<decltype(key(*data))>;
+			constexpr unsigned key_bits = sizeof(U) * 8;
+			const unsigned bits = Bits ? Bits : runtime_bits;
+			const unsigned passes = (key_bits + bits - 1) / bits;
+			const size_t radix = size_t(1) << bits;
+			const U mask = U(radix - 1);
+
+			radix_scratch<size_t> counts(size_t(threads > 1 ? threads : passes) * radix);
+			T* src = data;
+			T* dst = scratch;
+
+			if (threads == 1) {
+				size_t* table = counts.get();
+				std::memset(table, 0, sizeof(size_t) * passes * radix);
+				for (size_t i = 0; i < n; ++i) {
+					const U k = key(data[i]);
+					RAW_UNROLL
+					for (unsigned p = 0; p < passes; ++p)
+						++table[p * radix + ((k >> (p * bits)) & mask)];
+				}
+				for (unsigned p = 0; p < passes; ++p) {
+					size_t* offsets = table + p * radix;
+					const unsigned shift = p * bits;
+					if (offsets[(key(src[0]) >> shift) & mask] == n)
+						continue;
+					size_t running = 0;
+					for (size_t b = 0; b < radix; ++b) {
+						size_t c = offsets[b];
+						offsets[b] = running;
+						running += c;
+					}
+					for (size_t i = 0; i < n; ++i) {
+						const T& item = src[i];
+						dst[offsets[(key(item) >> shift) & mask]++] = item;
+					}
+					std::swap(src, dst);
+				}
+			}
+			else {
+				const size_t slice = (n + threads - 1) / threads;
+				for (unsigned p = 0; p < passes; ++p) {
+					const unsigned shift = p * bits;
+					parallel_run(threads, [&](unsigned t) {
+						size_t* table = counts.get() + t * radix;
+						std::memset(table, 0, sizeof(size_t) * radix);
+						const size_t begin = t * slice, end = begin + slice < n ? begin + slice : n;
+						for (size_t i = begin; i < end; ++i)
+							++table[(key(src[i]) >> shift) & mask];
+					});
+					const size_t first_digit = (key(src[0]) >> shift) & mask;
+					size_t same = 0;
+					for (unsigned t = 0; t < threads; ++t)
+						same += counts.get()[t * radix + first_digit];
+					if (same == n)
+						continue;
+					size_t running = 0;
+					for (size_t b = 0; b < radix; ++b) {
+						for (unsigned t = 0; t < threads; ++t) {
+							size_t& slot = counts.get()[t * radix + b];
+							size_t c = slot;
+							slot = running;
+							running += c;
+						}
+					}
+					parallel_run(threads, [&](unsigned t) {
+						size_t* offsets = counts.get() + t * radix;
+						const size_t begin = t * slice, end = begin + slice < n ? begin + slice : n;
+						for (size_t i = begin; i < end; ++i) {
+							const T& item = src[i];
+							dst[offsets[(key(item) >> shift) & mask]++] = item;
+						}
+					});
+					std::swap(src, dst);
+				}
+			}
+			if (src != data)
+				std::memcpy(static_cast<void*>(data), src, n * sizeof(T));
+		}
+
+		template<typename T, typename KeyFn>
+		void lsd_sort(T* data, size_t n, const KeyFn& key, const radix_options& options) {
+			using U = std::decay_t<decltype(key(*data))>;
+			static_assert(std::is_unsigned<U>::value, "encoded keys are unsigned");
+			static_assert(std::is_trivially_copyable<T>::value, "radix sort moves elements with memcpy");
+			const unsigned bits = radix_digit_bits(options.digit_bits, n, sizeof(U));
+			size_t i = 1;
+			while (i < n && !(key(data[i]) < key(data[i - 1])))
+				++i;
+			if (i >= n)
+				return;
+
+			const unsigned threads = parallel_thread_count(options.threads, n, radix_parallel_min, radix_items_per_thread);
+			radix_scratch<T> scratch(n);
+			switch (bits) {
+			case 8: lsd_passes<8>(data, scratch.get(), n, key, bits, threads); break;
+			case 11: lsd_passes<11>(data, scratch.get(), n, key, bits, threads); break;
+			case 16: lsd_passes<16>(data, scratch.get(), n, key, bits, threads); break;
+			default: lsd_passes<0>(data, scratch.get(), n, key, bits, threads); break;
+			}
+		}
+
+		template<typename R>
+		using radix_span_t = decltype(span(std::declval<R&>()));
+
+		template<typename R, typename = void>
+		struct is_radix_range : std::false_type {};
+		template<typename R>
+		struct is_radix_range<R, std::void_t<radix_span_t<R>>> : std::true_type {};
+	}
+
+	/*********************************************************************
+	 * FUNCTION: `radix_sort(range, options = {})`
+	 *
+	 * Sorts integer or float/double keys ascending in place. `range` is
+	 * anything raw::span binds to: raw::vector, raw::inplace_vector, a
+	 * span, a std container.
+	 *
+	 * Throws: std::invalid_argument for `digit_bits` > 16,
+	 *         std::bad_alloc if the scratch buffer cannot be allocated.
+	 *********************************************************************/
+	template<typename R, typename = std::enable_if_t<detail::is_radix_range<R>::value>>
+	void radix_sort(R&& range, const radix_options& options = {}) {
+		auto keys = span(range);
+		using K = typename decltype(keys)::value_type;
+		using codec = detail::radix_key<K>;
+		if (keys.get_size() <= detail::radix_network_max) {
+			detail::small_sort_keys(keys.get_data(), keys.get_size());
+			return;
+		}
+		detail::lsd_sort(keys.get_data(), keys.get_size(), [](const K& k) noexcept { return codec::encode(k); }, options);
+	}
+
+	/*********************************************************************
+	 * FUNCTION: `radix_sort_by_key(range, key, options = {})`
+	 *
+	 * Stable sort of trivially copyable records by `key(record)`, which
+	 * returns an integer or float/double. `key` is called several times
+	 * per record and should be a cheap field read.
+	 *
+	 * Throws: as `radix_sort`.
+	 *********************************************************************/
+	template<typename R, typename KeyFn, typename = std::enable_if_t<detail::is_radix_range<R>::value>>
+	void radix_sort_by_key(R&& range, KeyFn key, const radix_options& options = {}) {
+		auto items = span(range);
+		using T = typename decltype(items)::value_type;
+		using K = std::decay_t<decltype(key(std::declval<const T&>()))>;
+		using codec = detail::radix_key<K>;
+		auto encoded = [&key](const T& item) { return codec::encode(key(item)); };
+		if (items.get_size() <= detail::radix_network_max) {
+			detail::insertion_sort_by_key(items.get_data(), items.get_size(), encoded);
+			return;
+		}
+		detail::lsd_sort(items.get_data(), items.get_size(), encoded, options);
+	}
+
+	/*********************************************************************
+	 * FUNCTION: `argsort<Index = uint32_t>(range, options = {})`
+	 *
+	 * Returns the permutation that sorts `range`: `keys[order[0]]` is the
+	 * smallest. Stable, so equal keys keep their input order. The keys are
+	 * not modified.
+	 *
+	 * Throws: std::length_error if the size does not fit in `Index`,
+	 *         otherwise as `radix_sort`.
+	 *********************************************************************/
+	template<typename Index = uint32_t, typename R, typename = std::enable_if_t<detail::is_radix_range<R>::value>>
+	vector<Index> argsort(R&& range, const radix_options& options = {}) {
+		static_assert(std::is_integral<Index>::value && std::is_unsigned<Index>::value, "argsort indices are unsigned integers");
+		auto keys = span(range);
+		using K = std::remove_cv_t<typename decltype(keys)::value_type>;
+		using U = detail::radix_bits_t<K>;
+		const size_t n = keys.get_size();
+		if (n > size_t(std::numeric_limits<Index>::max()))
+			detail::throw_length_error("argsort: size does not fit the index type");
+
+		struct entry {
+			U key;
+			Index index;
+		};
+		detail::radix_scratch<entry> entries(n);
+		for (size_t i = 0; i < n; ++i)
+			entries.get()[i] = entry{ detail::radix_key<K>::encode(keys[i]), Index(i) };
+		auto key = [](const entry& e) noexcept { return e.key; };
+		if (n <= detail::radix_network_max)
+			detail::insertion_sort_by_key(entries.get(), n, key);
+		else
+			detail::lsd_sort(entries.get(), n, key, options);
+
+		vector<Index> order(n);
+		for (size_t i = 0; i < n; ++i)
+			order[i] = entries.get()[i].index;
+		return order;
+	}
+}
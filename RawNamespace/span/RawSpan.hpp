@@ -0,0 +1,311 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+
+/************************************************************************
+* raw::span<T> - non-owning view of contiguous elements.
+*
+* A pointer and a length, nothing else. raw::vector, raw::inplace_vector
+* and contiguous std containers convert to it implicitly without copying,
+* so a function taking `raw::span<const T>` accepts all of them, and
+* `subspan`/`first`/`last` hand out sub-ranges without allocating.
+*
+*     void sum_part(raw::span<const int> part);
+*     raw::vector<int> v = ...;
+*     for (raw::span<int> chunk : raw::span<int>(v).chunks(4096))
+*         pool.run([chunk] { sum_part(chunk); });
+*
+* `strided(step)` views every step-th element, `chunks(n)` splits the span
+* into consecutive pieces of `n` elements for partitioning work across
+* threads. Any edit that reallocates the underlying container invalidates
+* the views into it.
+***********************************************************************/
+
+namespace raw {
+	namespace detail {
+		/// `C` exposes `get_data()`/`get_size()` (raw containers) or `data()`/`size()` (std containers).
+		template<typename C, typename = void>
+		struct has_raw_data : std::false_type {};
+		template<typename C>
+		struct has_raw_data<C, std::void_t<decltype(std::declval<C&>().get_data()), decltype(std::declval<C&>().get_size())>> : std::true_type {};
+
+		template<typename C, typename = void>
+		struct has_std_data : std::false_type {};
+		template<typename C>
+		struct has_std_data<C, std::void_t<decltype(std::declval<C&>().data()), decltype(std::declval<C&>().size())>> : std::true_type {};
+
+		template<typename C, bool Raw = has_raw_data<C>::value>
+		struct contiguous_access {
+			static constexpr auto data(C& c) { return c.get_data(); }
+			static constexpr size_t size(C& c) { return c.get_size(); }
+		};
+		template<typename C>
+		struct contiguous_access<C, false> {
+			static constexpr auto data(C& c) { return c.data(); }
+			static constexpr size_t size(C& c) { return c.size(); }
+		};
+
+		/// Containers whose element pointer converts to `T*` without slicing (`U*` -> `const U*` is fine).
+		template<typename C, typename T, typename = void>
+		struct is_span_source : std::false_type {};
+		template<typename C, typename T>
+		struct is_span_source<C, T, std::enable_if_t<has_raw_data<C>::value || has_std_data<C>::value>>
+			: std::is_convertible<std::remove_pointer_t<decltype(contiguous_access<C>::data(std::declval<C&>()))>(*)[], T(*)[]> {};
+	}
+
+	template<typename T> class strided_span;
+	template<typename T> class span_chunks;
+
+	template<typename T>
+	class span {
+	private:
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `ptr`   - First viewed element.
+		 * `count` - Number of viewed elements.
+		 *************************************************************************************************/
+		T* ptr = nullptr;
+		size_t count = 0;
+
+	public:
+		using element_type = T;
+		using value_type = std::remove_cv_t<T>;
+		using iterator = T*;
+		static constexpr size_t npos = size_t(-1);
+
+		/*********************************************************************
+		 * CONSTRUCTORS: `span()`, `span(ptr, count)`, `span(first, last)`, `span(array)`, `span(container)`
+		 *
+		 * `span(container)` binds to raw::vector, raw::inplace_vector, another
+		 * span, or anything with `data()`/`size()`; implicit, and `span<const T>`
+		 * accepts mutable containers. Nothing is copied.
+		 *********************************************************************/
+
+		constexpr span() noexcept = default;
+		constexpr span(T* ptr_, size_t count_) noexcept : ptr(ptr_), count(count_) {}
+		constexpr span(T* first, T* last) noexcept : ptr(first), count(size_t(last - first)) {}
+
+		template<size_t N>
+		constexpr span(T (&array)[N]) noexcept : ptr(array), count(N) {}
+
+		template<typename C, typename = std::enable_if_t<detail::is_span_source<C, T>::value>>
+		constexpr span(C& container) noexcept
+			: ptr(detail::contiguous_access<C>::data(container)), count(detail::contiguous_access<C>::size(container)) {}
+
+		template<typename C, typename = std::enable_if_t<detail::is_span_source<const C, T>::value>>
+		constexpr span(const C& container) noexcept
+			: ptr(detail::contiguous_access<const C>::data(container)), count(detail::contiguous_access<const C>::size(container)) {}
+
+		/*********************************************************************
+		 * GETTER FUNCTIONS: `get_data()`, `get_size()`, `size_bytes()`, `empty()`
+		 *********************************************************************/
+
+		constexpr T* get_data() const noexcept { return ptr; }
+		constexpr size_t get_size() const noexcept { return count; }
+		constexpr size_t size_bytes() const noexcept { return count * sizeof(T); }
+		constexpr bool empty() const noexcept { return count == 0; }
+
+		/*********************************************************************
+		 * INDEXING FUNCTIONS: `at()`, `operator[]`, `front()`, `back()`
+		 *
+		 * `at()` - with bounds checking, throws `std::out_of_range`.
+		 * The others are unchecked.
+		 *********************************************************************/
+
+		constexpr T& at(size_t index) const {
+			if (index >= count)
+				detail::throw_out_of_range("Index out of range");
+			return ptr[index];
+		}
+
+		constexpr T& operator [] (size_t index) const noexcept { return ptr[index]; }
+		constexpr T& front() const noexcept { return ptr[0]; }
+		constexpr T& back() const noexcept { return ptr[count - 1]; }
+
+		constexpr iterator begin() const noexcept { return ptr; }
+		constexpr iterator end() const noexcept { return ptr + count; }
+
+		/*********************************************************************
+		 * SLICING FUNCTIONS: `first(n)`, `last(n)`, `subspan(offset, n)`
+		 *
+		 * Views of a part of this span; O(1), nothing is copied.
+		 * `subspan(offset)` runs to the end.
+		 *
+		 * Throws: std::out_of_range if the requested part is not inside the span.
+		 *********************************************************************/
+
+		constexpr span first(size_t n) const {
+			if (n > count)
+				detail::throw_out_of_range("Index out of range");
+			return span(ptr, n);
+		}
+
+		constexpr span last(size_t n) const {
+			if (n > count)
+				detail::throw_out_of_range("Index out of range");
+			return span(ptr + (count - n), n);
+		}
+
+		constexpr span subspan(size_t offset, size_t n = npos) const {
+			if (offset > count)
+				detail::throw_out_of_range("Index out of range");
+			if (n == npos)
+				n = count - offset;
+			else if (n > count - offset)
+				detail::throw_out_of_range("Index out of range");
+			return span(ptr + offset, n);
+		}
+
+		/*********************************************************************
+		 * VIEW FUNCTIONS: `strided(step, offset)`, `chunks(n)`
+		 *
+		 * `strided` - every `step`-th element starting at `offset`.
+		 * `chunks`  - consecutive spans of `n` elements, the last one may be
+		 *             shorter. Meant for splitting work across threads.
+		 *
+		 * Throws: std::invalid_argument if `step` or `n` is 0,
+		 *         std::out_of_range if `offset` > get_size().
+		 *********************************************************************/
+
+		constexpr strided_span<T> strided(size_t step, size_t offset = 0) const {
+			if (step == 0)
+				detail::throw_invalid_argument("stride must be positive");
+			if (offset > count)
+				detail::throw_out_of_range("Index out of range");
+			return strided_span<T>(ptr + offset, (count - offset + step - 1) / step, step);
+		}
+
+		constexpr span_chunks<T> chunks(size_t n) const {
+			if (n == 0)
+				detail::throw_invalid_argument("chunk size must be positive");
+			return span_chunks<T>(*this, n);
+		}
+	};
+
+	template<typename T>
+	class strided_span {
+	private:
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `ptr`    - First viewed element.
+		 * `count`  - Number of viewed elements.
+		 * `stride` - Distance between two viewed elements, in elements.
+		 *************************************************************************************************/
+		T* ptr = nullptr;
+		size_t count = 0;
+		size_t stride = 1;
+
+	public:
+		using element_type = T;
+		using value_type = std::remove_cv_t<T>;
+
+		// Walks by index, so no pointer is ever formed past the last viewed element.
+		class iterator {
+		private:
+			T* base;
+			size_t index;
+			size_t step;
+		public:
+			constexpr iterator(T* base_, size_t index_, size_t step_) noexcept : base(base_), index(index_), step(step_) {}
+			constexpr T& operator *() const noexcept { return base[index * step]; }
+			constexpr T* operator ->() const noexcept { return base + index * step; }
+			constexpr iterator& operator ++() noexcept { ++index; return *this; }
+			constexpr iterator operator ++(int) noexcept { iterator tmp = *this; ++index; return tmp; }
+			constexpr bool operator==(const iterator& other) const noexcept { return index == other.index; }
+			constexpr bool operator!=(const iterator& other) const noexcept { return index != other.index; }
+		};
+
+		constexpr strided_span() noexcept = default;
+		constexpr strided_span(T* ptr_, size_t count_, size_t stride_) noexcept : ptr(ptr_), count(count_), stride(stride_) {}
+
+		constexpr size_t get_size() const noexcept { return count; }
+		constexpr size_t get_stride() const noexcept { return stride; }
+		constexpr bool empty() const noexcept { return count == 0; }
+
+		constexpr T& at(size_t index) const {
+			if (index >= count)
+				detail::throw_out_of_range("Index out of range");
+			return ptr[index * stride];
+		}
+
+		constexpr T& operator [] (size_t index) const noexcept { return ptr[index * stride]; }
+
+		constexpr iterator begin() const noexcept { return iterator(ptr, 0, stride); }
+		constexpr iterator end() const noexcept { return iterator(ptr, count, stride); }
+
+		/// Every `step`-th element of this view.
+		constexpr strided_span strided(size_t step) const {
+			if (step == 0)
+				detail::throw_invalid_argument("stride must be positive");
+			return strided_span(ptr, (count + step - 1) / step, stride * step);
+		}
+	};
+
+	template<typename T>
+	class span_chunks {
+	private:
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `whole` - The span being split.
+		 * `chunk` - Elements per chunk; the last chunk holds the remainder.
+		 *************************************************************************************************/
+		span<T> whole;
+		size_t chunk = 1;
+
+	public:
+		class iterator {
+		private:
+			T* p;
+			T* last;
+			size_t chunk;
+		public:
+			constexpr iterator(T* p_, T* last_, size_t chunk_) noexcept : p(p_), last(last_), chunk(chunk_) {}
+			constexpr span<T> operator *() const noexcept {
+				return span<T>(p, size_t(last - p) < chunk ? size_t(last - p) : chunk);
+			}
+			constexpr iterator& operator ++() noexcept {
+				p += size_t(last - p) < chunk ? size_t(last - p) : chunk;
+				return *this;
+			}
+			constexpr iterator operator ++(int) noexcept { iterator tmp = *this; ++*this; return tmp; }
+			constexpr bool operator==(const iterator& other) const noexcept { return p == other.p; }
+			constexpr bool operator!=(const iterator& other) const noexcept { return p != other.p; }
+		};
+
+		constexpr span_chunks(span<T> whole_, size_t chunk_) noexcept : whole(whole_), chunk(chunk_) {}
+
+		/// Number of chunks, rounded up.
+		constexpr size_t get_size() const noexcept { return (whole.get_size() + chunk - 1) / chunk; }
+		constexpr bool empty() const noexcept { return whole.empty(); }
+
+		/// Chunk `index`, unchecked.
+		constexpr span<T> operator [] (size_t index) const noexcept {
+			size_t offset = index * chunk;
+			size_t left = whole.get_size() - offset;
+			return span<T>(whole.get_data() + offset, left < chunk ? left : chunk);
+		}
+
+		constexpr iterator begin() const noexcept { return iterator(whole.begin(), whole.end(), chunk); }
+		constexpr iterator end() const noexcept { return iterator(whole.end(), whole.end(), chunk); }
+	};
+
+	/*********************************************************************
+	 * DEDUCTION GUIDES
+	 *
+	 * `raw::span s(v);` picks the element type of `v`, const for const `v`.
+	 *********************************************************************/
+	template<typename T, size_t N> span(T (&)[N]) -> span<T>;
+	template<typename C, typename = std::enable_if_t<detail::has_raw_data<C>::value || detail::has_std_data<C>::value>>
+	span(C&) -> span<std::remove_pointer_t<decltype(detail::contiguous_access<C>::data(std::declval<C&>()))>>;
+	template<typename C, typename = std::enable_if_t<detail::has_raw_data<const C>::value || detail::has_std_data<const C>::value>>
+	span(const C&) -> span<std::remove_pointer_t<decltype(detail::contiguous_access<const C>::data(std::declval<const C&>()))>>;
+}
@@ -0,0 +1,366 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* raw::basic_string_vector<Offset> - a vector of strings whose
+* characters all live in one buffer.
+*
+*     chars:   [ a p p l e b a n a n a c h e r r y ]
+*     entries: [ {0,5} {5,11} {11,17} ]
+*
+* `raw::vector<std::string>` holds one std::string (32 bytes) per
+* element plus, past the SSO limit, one heap block each; growth moves
+* every string. Here a string costs its characters plus one
+* {begin, end} pair of `Offset`s, appends are a memcpy into
+* `vector_triv<char>`, and growth is two reallocs however many strings
+* there are. `string_vector` uses 64-bit offsets, `string_vector32`
+* 32-bit ones (at most 4 GiB of characters, 8 bytes per string).
+*
+* Elements are read as std::string_view; views stay valid until the
+* character buffer reallocates (any append) or `compact()`.
+*
+* Entries are (begin, end) pairs rather than prefix sums so that
+* `sort()` can reorder strings by permuting entries alone. Characters
+* then stop being in element order, and erased strings leave their
+* bytes behind; `compact()` rewrites the buffer in element order.
+***********************************************************************/
+
+namespace raw {
+	template<typename Offset>
+	class basic_string_vector {
+		static_assert(std::is_same<Offset, uint32_t>::value || std::is_same<Offset, uint64_t>::value,
+			"string_vector offsets are uint32_t or uint64_t");
+
+	public:
+		struct entry {
+			Offset begin;
+			Offset end;
+		};
+
+	private:
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `chars`   - Character storage; strings are not NUL-terminated.
+		 * `entries` - `[begin, end)` into `chars` per string, in element order.
+		 *************************************************************************************************/
+		vector_triv<char> chars;
+		vector_triv<entry> entries;
+
+		/// Below this many strings, sort() compares the strings directly.
+		static constexpr size_t keyed_sort_from = 64;
+
+		std::string_view view(const entry& e) const noexcept {
+			return std::string_view(chars.get_data() + e.begin, static_cast<size_t>(e.end - e.begin));
+		}
+
+		void check_room(size_t extra_chars) const {
+			if (extra_chars > std::numeric_limits<Offset>::max() - chars.get_size())
+				detail::throw_length_error("string_vector: characters exceed the offset type");
+		}
+
+		/// Copies `[src, src + n)` to the end of `chars`, returning where it went. `src` may
+		/// point into `chars`: it is rebased after the buffer grows.
+		char* append_chars(const char* src, size_t n) {
+			const uintptr_t at = reinterpret_cast<uintptr_t>(src);
+			const uintptr_t base = reinterpret_cast<uintptr_t>(chars.get_data());
+			const bool inside = at >= base && at < base + chars.get_size();
+			chars.reserve_spare(n);
+			if (inside)
+				src = chars.get_data() + (at - base);
+			char* out = chars.spare_data();
+			std::memcpy(out, src, n);
+			chars.commit_spare(n);
+			return out;
+		}
+
+		/// First 8 bytes as a big-endian integer, zero padded: orders like memcmp on those bytes.
+		static uint64_t prefix_key(const char* p, size_t n) noexcept {
+			unsigned char bytes[8] = {};
+			std::memcpy(bytes, p, n < 8 ? n : 8);
+			uint64_t key = 0;
+			for (int i = 0; i < 8; ++i)
+				key = (key << 8) | bytes[i];
+			return key;
+		}
+
+	public:
+		using value_type = std::string_view;
+		using offset_type = Offset;
+
+		basic_string_vector() = default;
+
+		/// Tags both internal vectors for the allocation profiler.
+		explicit basic_string_vector(alloc_tag tag) : chars(tag), entries(tag) {}
+
+		/*********************************************************************
+		 * INSERT FUNCTIONS: `push_back(s)`, `append_delimited(buffer, delimiter)`
+		 *
+		 * `push_back` copies `s` to the end of the character buffer.
+		 * `append_delimited` adds every `delimiter`-terminated piece of
+		 * `buffer` (a last piece without one included) with a single copy of
+		 * the whole buffer; the delimiters stay in the character buffer
+		 * between strings. Returns the number of strings added. Both accept
+		 * views into this vector's own characters (`v.push_back(v[0])`).
+		 *
+		 * Throws: allocation failure, std::length_error if the characters
+		 *         would not fit in `Offset`.
+		 *********************************************************************/
+
+		void push_back(std::string_view s) {
+			check_room(s.size());
+			const Offset begin = static_cast<Offset>(chars.get_size());
+			if (!s.empty())
+				append_chars(s.data(), s.size());
+			entries.push_back(entry{ begin, static_cast<Offset>(begin + s.size()) });
+		}
+
+		size_t append_delimited(std::string_view buffer, char delimiter = '\n') {
+			if (buffer.empty())
+				return 0;
+			check_room(buffer.size());
+			const size_t base = chars.get_size();
+			const char* out = append_chars(buffer.data(), buffer.size());
+
+			const size_t before = entries.get_size();
+			const char* p = out;
+			const char* end = out + buffer.size();
+			while (p < end) {
+				const char* stop = static_cast<const char*>(std::memchr(p, delimiter, static_cast<size_t>(end - p)));
+				if (!stop)
+					stop = end;
+				entries.push_back(entry{ static_cast<Offset>(base + (p - out)), static_cast<Offset>(base + (stop - out)) });
+				p = stop + 1;
+			}
+			return entries.get_size() - before;
+		}
+
+		/*********************************************************************
+		 * REMOVAL: `pop_back()`, `erase(i)`, `clear()`
+		 *
+		 * `erase` shifts the following entries down; the removed characters
+		 * stay in the buffer until `compact()`, except after the last string,
+		 * which `pop_back` and `erase` give back.
+		 *
+		 * Throws: std::out_of_range (`pop_back` on empty, `erase` past the end).
+		 *********************************************************************/
+
+		void pop_back() {
+			if (entries.get_size() == 0)
+				detail::throw_out_of_range("string_vector is empty");
+			erase(entries.get_size() - 1);
+		}
+
+		void erase(size_t i) {
+			if (i >= entries.get_size())
+				detail::throw_out_of_range("Index out of range");
+			const entry e = entries[i];
+			entries.erase(i);
+			if (e.end == chars.get_size())
+				chars.resize(e.begin);
+		}
+
+		void clear() {
+			chars.clear();
+			entries.clear();
+		}
+
+		/*********************************************************************
+		 * ACCESS: `operator[]`, `at()`, `front()`, `back()`, `entry_at()`
+		 *
+		 * Views into the character buffer. `at()` throws std::out_of_range;
+		 * the rest do no bounds checking.
+		 *********************************************************************/
+
+		std::string_view operator [] (size_t i) const noexcept { return view(entries[i]); }
+
+		std::string_view at(size_t i) const {
+			if (i >= entries.get_size())
+				detail::throw_out_of_range("Index out of range");
+			return view(entries[i]);
+		}
+
+		std::string_view front() const noexcept { return view(entries.front()); }
+		std::string_view back() const noexcept { return view(entries.back()); }
+		entry entry_at(size_t i) const noexcept { return entries[i]; }
+
+		/*********************************************************************
+		 * SORTING: `sort()`, `sort(comp)`
+		 *
+		 * Reorders the strings by permuting their entries; no character moves.
+		 * `sort()` orders bytewise like std::string: it sorts entries keyed by
+		 * their first 8 bytes and compares the rest only on a tie, so most
+		 * comparisons never touch the character buffer. `sort(comp)` takes a
+		 * strict weak order on std::string_view. Neither is stable.
+		 *
+		 * Throws: allocation failure (`sort()` on 64+ strings), exceptions from `comp`.
+		 *********************************************************************/
+
+		void sort() {
+			const size_t n = entries.get_size();
+			if (n < keyed_sort_from) {
+				sort(std::less<std::string_view>());
+				return;
+			}
+			struct keyed {
+				uint64_t key;
+				entry e;
+			};
+			vector_triv<keyed> keys;
+			keys.reserve(n);
+			const char* data = chars.get_data();
+			for (size_t i = 0; i < n; ++i) {
+				const entry e = entries[i];
+				keys.push_back(keyed{ prefix_key(data + e.begin, static_cast<size_t>(e.end - e.begin)), e });
+			}
+			std::sort(keys.begin(), keys.end(), [data](const keyed& a, const keyed& b) {
+				if (a.key != b.key)
+					return a.key < b.key;
+				const size_t la = static_cast<size_t>(a.e.end - a.e.begin);
+				const size_t lb = static_cast<size_t>(b.e.end - b.e.begin);
+				if (la <= 8 || lb <= 8)
+					return la < lb;
+				return std::string_view(data + a.e.begin + 8, la - 8) < std::string_view(data + b.e.begin + 8, lb - 8);
+			});
+			for (size_t i = 0; i < n; ++i)
+				entries[i] = keys[i].e;
+		}
+
+		template<typename Compare>
+		void sort(Compare comp) {
+			std::sort(entries.begin(), entries.end(), [this, &comp](const entry& a, const entry& b) {
+				return comp(view(a), view(b));
+			});
+		}
+
+		/*********************************************************************
+		 * MEMORY: `reserve(strings, characters)`, `compact()`, `shrink_to_fit()`
+		 *
+		 * `compact()` rewrites the characters in element order without gaps
+		 * (after `sort()`, this restores locality for sequential scans; after
+		 * `erase()`, it drops the erased bytes and delimiters kept by
+		 * `append_delimited`).
+		 *
+		 * Throws: allocation failure.
+		 *********************************************************************/
+
+		void reserve(size_t strings, size_t characters) {
+			entries.reserve(strings);
+			chars.reserve(characters);
+		}
+
+		void compact() {
+			vector_triv<char> packed;
+			const size_t total = get_char_count_referenced();
+			if (total)
+				packed.reserve_spare(total);
+			Offset next = 0;
+			for (size_t i = 0; i < entries.get_size(); ++i) {
+				entry& e = entries[i];
+				const size_t length = static_cast<size_t>(e.end - e.begin);
+				if (length) {
+					std::memcpy(packed.spare_data(), chars.get_data() + e.begin, length);
+					packed.commit_spare(length);
+				}
+				e = entry{ next, static_cast<Offset>(next + length) };
+				next = e.end;
+			}
+			chars.swap(packed);
+		}
+
+		void shrink_to_fit() {
+			chars.shrink_to_fit();
+			entries.shrink_to_fit();
+		}
+
+		/*********************************************************************
+		 * SIZE FUNCTIONS: `get_size()`, `empty()`, `get_char_count()`,
+		 *                 `get_char_count_referenced()`, `get_memory_bytes()`
+		 *
+		 * `get_char_count()`            - bytes in the character buffer.
+		 * `get_char_count_referenced()` - bytes in the strings themselves.
+		 * `get_memory_bytes()`          - heap bytes held (capacities).
+		 *********************************************************************/
+
+		size_t get_size() const noexcept { return entries.get_size(); }
+		bool empty() const noexcept { return entries.get_size() == 0; }
+		size_t get_char_count() const noexcept { return chars.get_size(); }
+
+		size_t get_char_count_referenced() const noexcept {
+			size_t total = 0;
+			for (size_t i = 0; i < entries.get_size(); ++i)
+				total += static_cast<size_t>(entries[i].end - entries[i].begin);
+			return total;
+		}
+
+		size_t get_memory_bytes() const noexcept {
+			return (chars.get_data() ? chars.get_capacity() : 0) + (entries.get_data() ? entries.get_capacity() * sizeof(entry) : 0);
+		}
+
+		const char* get_char_data() const noexcept { return chars.get_data(); }
+
+		void swap(basic_string_vector& other) noexcept {
+			chars.swap(other.chars);
+			entries.swap(other.entries);
+		}
+
+		/*********************************************************************
+		 * ITERATOR: `const_iterator`
+		 *
+		 * Random access over the strings as std::string_view values.
+		 *********************************************************************/
+		class const_iterator {
+		private:
+			const basic_string_vector* owner = nullptr;
+			size_t index = 0;
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = std::string_view;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = std::string_view;
+
+			const_iterator() noexcept = default;
+			const_iterator(const basic_string_vector* owner_, size_t index_) noexcept : owner(owner_), index(index_) {}
+
+			std::string_view operator *() const noexcept { return (*owner)[index]; }
+			std::string_view operator [](difference_type n) const noexcept { return (*owner)[index + n]; }
+
+			const_iterator& operator ++() noexcept { ++index; return *this; }
+			const_iterator operator ++(int) noexcept { const_iterator tmp = *this; ++index; return tmp; }
+			const_iterator& operator --() noexcept { --index; return *this; }
+			const_iterator operator --(int) noexcept { const_iterator tmp = *this; --index; return tmp; }
+			const_iterator& operator +=(difference_type n) noexcept { index += n; return *this; }
+			const_iterator& operator -=(difference_type n) noexcept { index -= n; return *this; }
+			friend const_iterator operator +(const_iterator a, difference_type n) noexcept { return a += n; }
+			friend const_iterator operator +(difference_type n, const_iterator a) noexcept { return a += n; }
+			friend const_iterator operator -(const_iterator a, difference_type n) noexcept { return a -= n; }
+			friend difference_type operator -(const const_iterator& a, const const_iterator& b) noexcept {
+				return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+			}
+
+			friend bool operator ==(const const_iterator& a, const const_iterator& b) noexcept { return a.index == b.index; }
+			friend bool operator !=(const const_iterator& a, const const_iterator& b) noexcept { return a.index != b.index; }
+			friend bool operator < (const const_iterator& a, const const_iterator& b) noexcept { return a.index < b.index; }
+			friend bool operator > (const const_iterator& a, const const_iterator& b) noexcept { return a.index > b.index; }
+			friend bool operator <=(const const_iterator& a, const const_iterator& b) noexcept { return a.index <= b.index; }
+			friend bool operator >=(const const_iterator& a, const const_iterator& b) noexcept { return a.index >= b.index; }
+		};
+
+		const_iterator begin() const noexcept { return const_iterator(this, 0); }
+		const_iterator end() const noexcept { return const_iterator(this, entries.get_size()); }
+	};
+
+	using string_vector = basic_string_vector<uint64_t>;
+	using string_vector32 = basic_string_vector<uint32_t>;
+}
@@ -2,11 +2,75 @@
 #include <iostream>
 #include <cstdlib>
 #include <algorithm>
-#include "RawNamespace\vector\trivial_check.hpp"
-#include "RawNamespace\RawBase.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/vector/alloc_profiler.hpp"
+#include "RawNamespace/vector/memory_ops.hpp"
 
 
 namespace raw {
+	/*********************************************************************
+	 * STRUCT: `shrink_policy`
+	 *
+	 * When a vector gives memory back as its size drops (pop_back, erase,
+	 * resize, clear). With `shrink_divisor` d != 0 the buffer shrinks once
+	 * size < capacity / d, to max(2 * size, min_capacity); the gap between
+	 * d and 2 keeps push/pop cycles at a boundary from reallocating.
+	 * The default never shrinks: capacity is kept until `trim()`,
+	 * `shrink_to_fit()` or `release()`.
+	 *********************************************************************/
+	struct shrink_policy {
+		uint32_t shrink_divisor = 0;
+		uint32_t min_capacity = 0;
+
+		/// Never shrink implicitly (default).
+		static constexpr shrink_policy keep() { return shrink_policy{ 0, 0 }; }
+		/// Halve once size drops below a quarter of capacity, keeping at least `min_capacity` slots.
+		static constexpr shrink_policy quarter(uint32_t min_capacity = 16) { return shrink_policy{ 4, min_capacity }; }
+	};
+
+	/*********************************************************************
+	 * STRUCT: `buffer_deleter`
+	 *
+	 * How to free a buffer the vector did not allocate (see `adopt()`):
+	 * `fn(ptr, capacity, context)`, where `capacity` is in elements. A null
+	 * `fn` means the buffer is the vector's own and is freed with std::free.
+	 *     raw::buffer_deleter d{ [](void* p, size_t, void*) { av_free(p); }, nullptr };
+	 *********************************************************************/
+	struct buffer_deleter {
+		void (*fn)(void* ptr, size_t capacity, void* context) = nullptr;
+		void* context = nullptr;
+	};
+
+	/*********************************************************************
+	 * STRUCT: `detached_buffer<T>`
+	 *
+	 * A buffer handed out by `vector_base::detach()`: the first `size`
+	 * elements are live, `capacity` were allocated. The receiver owns it
+	 * and frees it with `dispose()` (after destroying the elements, for
+	 * non-trivial T) or passes it to another vector's `adopt()`.
+	 *********************************************************************/
+	template<typename T>
+	struct detached_buffer {
+		T* data = nullptr;
+		size_t size = 0;
+		size_t capacity = 0;
+		buffer_deleter deleter;
+
+		void dispose() noexcept {
+			if (deleter.fn)
+				deleter.fn(data, capacity, deleter.context);
+			else
+				std::free(data);
+			*this = detached_buffer();
+		}
+	};
+
 	template<typename T>
 	class vector_base {
 	private:
@@ -14,18 +78,152 @@ namespace raw {
 		T* data = nullptr;
 		size_t size = 0;
 		size_t capacity = 0;
+		shrink_policy policy;
+		/// Set while `data` is an adopted buffer that std::free must not release.
+		buffer_deleter deleter;
 
 		virtual T* normalize_capacity() = 0;
 
+		/// Capacity the shrink policy asks for at the current size, 0 to keep the buffer.
+		RAW_CONSTEXPR20 size_t shrink_target() const noexcept {
+			if (RAW_LIKELY(policy.shrink_divisor == 0) || !data || size >= capacity / policy.shrink_divisor)
+				return 0;
+			size_t target = size * 2 > policy.min_capacity ? size * 2 : policy.min_capacity;
+			if (target == 0)
+				target = 1;
+			return target < capacity ? target : 0;
+		}
+
+		/// Frees `data` (nullptr is fine) the way it was obtained and forgets the deleter; fields are left stale.
+		RAW_CONSTEXPR20 void free_buffer() noexcept {
+			if (RAW_UNLIKELY(deleter.fn != nullptr)) {
+				deleter.fn(data, capacity, deleter.context);
+				deleter = buffer_deleter();
+			}
+			else if (data)
+				detail::deallocate(data, capacity);
+		}
+
+		/// Capacity `trim()` shrinks to: the size, but not below the policy's minimum (and at least 1).
+		RAW_CONSTEXPR20 size_t trim_target() const noexcept {
+			size_t target = size > policy.min_capacity ? size : policy.min_capacity;
+			return target ? target : 1;
+		}
+
+		/*************************************************************************************
+		 * PROFILING HOOKS: `track_buffer()`, `track_release()`, `retrack()`
+		 *
+		 * Called by the specializations whenever the buffer changes. They compare the
+		 * current `capacity * sizeof(T)` with the bytes recorded last time.
+		 * `track_buffer(moved)` - after malloc/realloc/free, counts the event, the new
+		 *                         size in the histogram and `moved` relocated bytes.
+		 * `track_release()`     - right after the buffer was freed (data/capacity still stale).
+		 * `retrack()`           - after a buffer changed owner (move, swap); only live bytes.
+		 * All three are empty without RAW_VECTOR_PROFILING and skipped during constant evaluation.
+		 *************************************************************************************/
+#ifdef RAW_VECTOR_PROFILING
+		profiling::tag_stats* stats = nullptr;
+		size_t tracked_bytes = 0;
+		profiling::vector_node node;
+
+		static size_t slack_of(const void* self) {
+			auto v = static_cast<const vector_base*>(self);
+			return v->data && v->capacity > v->size ? (v->capacity - v->size) * sizeof(T) : 0;
+		}
+
+		size_t buffer_bytes() const { return data ? capacity * sizeof(T) : 0; }
+
+		RAW_CONSTEXPR20 void track_buffer(size_t moved_bytes = 0) {
+			if (detail::is_constant_evaluated())
+				return;
+			size_t current = buffer_bytes();
+			if (current == 0 && tracked_bytes == 0)
+				return;
+			if (tracked_bytes == 0)
+				stats->allocations.fetch_add(1, std::memory_order_relaxed);
+			else if (current == 0)
+				stats->frees.fetch_add(1, std::memory_order_relaxed);
+			else
+				stats->reallocations.fetch_add(1, std::memory_order_relaxed);
+			if (current)
+				stats->record_size(current);
+			if (moved_bytes) {
+				stats->relocations.fetch_add(1, std::memory_order_relaxed);
+				stats->bytes_moved.fetch_add(moved_bytes, std::memory_order_relaxed);
+			}
+			stats->sub_live(tracked_bytes);
+			stats->add_live(current);
+			tracked_bytes = current;
+		}
+
+		RAW_CONSTEXPR20 void track_release() {
+			if (detail::is_constant_evaluated() || tracked_bytes == 0)
+				return;
+			stats->frees.fetch_add(1, std::memory_order_relaxed);
+			stats->sub_live(tracked_bytes);
+			tracked_bytes = 0;
+		}
+
+		RAW_CONSTEXPR20 void retrack() {
+			if (detail::is_constant_evaluated())
+				return;
+			size_t current = buffer_bytes();
+			stats->sub_live(tracked_bytes);
+			stats->add_live(current);
+			tracked_bytes = current;
+		}
+
+		RAW_CONSTEXPR20 void link_profiler() {
+			if (detail::is_constant_evaluated())
+				return;
+			node.owner = this;
+			node.slack = &slack_of;
+			node.stats = stats;
+			profiling::registry::instance().link(&node);
+		}
+#else
+		RAW_CONSTEXPR20 void track_buffer(size_t = 0) {}
+		RAW_CONSTEXPR20 void track_release() {}
+		RAW_CONSTEXPR20 void retrack() {}
+		RAW_CONSTEXPR20 void link_profiler() {}
+#endif
+
 		friend class vector_triv<T>;
 		friend class vector_non_triv<T>;
 	public:
 
-		vector_base() : data(nullptr), size(0), capacity(1) {}
-		virtual ~vector_base() {
-			std::cout << "Freeing memory at address: " << static_cast<void*>(data) << " | ";
-			if (data) { free(data); }
-			std::cout << "vector_base Object Destroyed with size: " << size << " and with capacity: " << capacity << std::endl;
+		using value_type = T;
+
+		RAW_CONSTEXPR20 vector_base() : data(nullptr), size(0), capacity(1) {
+#ifdef RAW_VECTOR_PROFILING
+			if (!detail::is_constant_evaluated())
+				stats = alloc_tag().stats;
+#endif
+			link_profiler();
+		}
+		RAW_CONSTEXPR20 explicit vector_base(alloc_tag tag) : data(nullptr), size(0), capacity(1) {
+#ifdef RAW_VECTOR_PROFILING
+			stats = tag.stats;
+#else
+			(void)tag;
+#endif
+			link_profiler();
+		}
+		RAW_CONSTEXPR20 virtual ~vector_base() {
+#ifdef RAW_VECTOR_VERBOSE
+			if (!detail::is_constant_evaluated())
+				std::cout << "Freeing memory at address: " << static_cast<void*>(data) << " | ";
+#endif
+			free_buffer();
+			track_release();
+#ifdef RAW_VECTOR_PROFILING
+			if (!detail::is_constant_evaluated())
+				profiling::registry::instance().unlink(&node);
+#endif
+#ifdef RAW_VECTOR_VERBOSE
+			if (!detail::is_constant_evaluated())
+				std::cout << "vector_base Object Destroyed with size: " << size << " and with capacity: " << capacity << std::endl;
+#endif
 		}
 
 		virtual void push_back(const T& elem) = 0;
@@ -36,109 +234,190 @@ namespace raw {
 		virtual T& operator [] (const size_t index) = 0;
 		virtual const T& operator [] (const size_t index) const = 0;
 
-		size_t get_size() const { return size; }
-		size_t get_capacity() const { return capacity; }
-		bool is_trivial() const { return is_trivial_v; }
+		RAW_CONSTEXPR20 size_t get_size() const { return size; }
+		RAW_CONSTEXPR20 size_t get_capacity() const { return capacity; }
+		/// Pointer to the first element (nullptr before anything was allocated); what raw::span binds to.
+		RAW_CONSTEXPR20 T* get_data() noexcept { return data; }
+		RAW_CONSTEXPR20 const T* get_data() const noexcept { return data; }
+		RAW_CONSTEXPR20 bool is_trivial() const { return is_trivial_v; }
+
+		/*********************************************************************
+		 * SHRINK POLICY: `set_shrink_policy()`, `get_shrink_policy()`
+		 *
+		 * See `shrink_policy`. Copy and move construction inherit the policy,
+		 * assignment keeps the target's own.
+		 *********************************************************************/
+		RAW_CONSTEXPR20 void set_shrink_policy(shrink_policy new_policy) noexcept { policy = new_policy; }
+		RAW_CONSTEXPR20 shrink_policy get_shrink_policy() const noexcept { return policy; }
+
+		/*********************************************************************
+		 * ALLOCATION TAG: `get_alloc_tag()`
+		 *
+		 * Tag this vector is accounted under. Copies and moves inherit it.
+		 *********************************************************************/
+		RAW_CONSTEXPR20 alloc_tag get_alloc_tag() const {
+#ifdef RAW_VECTOR_PROFILING
+			alloc_tag tag;
+			tag.stats = stats;
+			return tag;
+#else
+			return alloc_tag();
+#endif
+		}
+
+		/*********************************************************************
+		 * BUFFER OWNERSHIP: `adopt(ptr, size, capacity[, deleter])`, `detach()`,
+		 *                   `has_custom_deleter()`
+		 *
+		 * `adopt`  - drops the current contents and takes `ptr` as the buffer:
+		 *            `size` live elements, room for `capacity`. Without a
+		 *            deleter `ptr` must come from malloc/calloc/realloc and
+		 *            is handled like the vector's own buffer (grown with
+		 *            realloc for trivial T). With one, the vector calls it
+		 *            when it lets go of `ptr` (destruction, assignment,
+		 *            `release()`, or the first reallocation, which moves the
+		 *            elements to a malloc'd buffer).
+		 * `detach` - hands the buffer out without freeing it (unlike
+		 *            `release()`); the vector is left empty with capacity 0.
+		 *            The deleter, if any, comes along.
+		 * Under RAW_VECTOR_PROFILING, an adopted buffer counts as an
+		 * allocation of this vector's tag and a detached one as a free.
+		 *
+		 * Throws: std::invalid_argument (`adopt`) if `size > capacity`, if a
+		 *         non-null `ptr` has capacity 0 or a null one has a size, or if
+		 *         `ptr` is the current buffer. The vector and `ptr` are then
+		 *         untouched.
+		 *********************************************************************/
+		void adopt(T* ptr, size_t new_size, size_t new_capacity, buffer_deleter new_deleter = buffer_deleter()) {
+			if (new_size > new_capacity || (ptr && new_capacity == 0) || (!ptr && new_size != 0))
+				detail::throw_invalid_argument("adopt: size and capacity do not describe a buffer");
+			if (ptr && ptr == data)
+				detail::throw_invalid_argument("adopt: the vector already owns this buffer");
+			release();
+			data = ptr;
+			size = new_size;
+			capacity = ptr ? new_capacity : 0;
+			deleter = ptr ? new_deleter : buffer_deleter();
+			track_buffer();
+		}
+
+		detached_buffer<T> detach() noexcept {
+			detached_buffer<T> out;
+			out.data = data;
+			out.size = size;
+			out.capacity = data ? capacity : 0;
+			out.deleter = deleter;
+			track_release();
+			data = nullptr;
+			size = 0;
+			capacity = 0;
+			deleter = buffer_deleter();
+			return out;
+		}
+
+		bool has_custom_deleter() const noexcept { return deleter.fn != nullptr; }
 
 		virtual void resize(size_t new_size) = 0;
 		virtual void reserve(size_t reserve_size) = 0;
 		virtual void clear() = 0;
 		virtual void shrink_to_fit() = 0;
 		virtual void pop_back() = 0;
-
+		virtual void trim() = 0;
+		virtual void release() noexcept = 0;
+
+		virtual status try_push_back(const T& elem) = 0;
+		virtual status try_push_back(T&& elem) = 0;
+		virtual status try_reserve(size_t reserve_size) = 0;
+		virtual status try_resize(size_t new_size) = 0;
+		virtual status try_insert(size_t index, const T& value) = 0;
+		virtual status try_insert(size_t index, T&& value) = 0;
+
+		/*********************************************************************
+		 * ITERATORS: `IteratorBase<iter>`, `ReverseIterator<iter>`
+		 *
+		 * `IteratorBase` is a wrapped pointer that models a contiguous iterator:
+		 * random access with signed `difference_type`, `operator[]`, the C++20
+		 * `iterator_concept` tag, and `std::to_address` through `operator->`.
+		 * `IteratorBase<T>` converts to `IteratorBase<const T>`. The reverse
+		 * iterators are plain `std::reverse_iterator`s over it.
+		 *********************************************************************/
 		template <typename iter>
 		class IteratorBase {
 		private:
-			iter* ptr;
+			iter* ptr = nullptr;
 		public:
-
-			IteratorBase(iter* ptr_) : ptr(ptr_) {};
-
-			iter& operator *() const { return *ptr; }
-			iter* operator ->() const { return ptr; }
-
-			IteratorBase& operator +=(size_t n) { ptr += n; return *this; }
-			IteratorBase& operator -=(size_t n) { ptr -= n; return *this; }
-
-			IteratorBase operator +(size_t n) const { return IteratorBase(ptr + n); }
-			friend IteratorBase operator+(size_t n, const IteratorBase& it) { return IteratorBase(it + n); }
-
-			IteratorBase operator -(size_t n) const { return IteratorBase(ptr - n); }
-			size_t operator -(IteratorBase iter) const { return size_t(ptr - iter.ptr); }
-
-			IteratorBase& operator ++() { ++ptr; return *this; }
-			IteratorBase operator ++(int) { IteratorBase tmp = *this; ++ptr; return tmp; }
-
-			IteratorBase& operator --() { --ptr; return *this; }
-			IteratorBase operator --(int) { IteratorBase tmp = *this; ++ptr; return tmp; }
-
-			bool operator==(const IteratorBase& other) const { return ptr == other.ptr; }
-			bool operator!=(const IteratorBase& other) const { return ptr != other.ptr; }
-			bool operator< (const IteratorBase& other) const { return ptr < other.ptr; }
-			bool operator> (const IteratorBase& other) const { return ptr > other.ptr; }
-			bool operator<=(const IteratorBase& other) const { return ptr <= other.ptr; }
-			bool operator>=(const IteratorBase& other) const { return ptr >= other.ptr; }
+			using iterator_category = std::random_access_iterator_tag;
+#ifdef __cpp_lib_concepts
+			using iterator_concept = std::contiguous_iterator_tag;
+#endif
+			using value_type = std::remove_cv_t<iter>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = iter*;
+			using reference = iter&;
+
+			constexpr IteratorBase() noexcept = default;
+			constexpr IteratorBase(iter* ptr_) noexcept : ptr(ptr_) {}
+
+			template <typename other, typename = std::enable_if_t<!std::is_same<other, iter>::value && std::is_convertible<other*, iter*>::value>>
+			constexpr IteratorBase(const IteratorBase<other>& it) noexcept : ptr(it.operator->()) {}
+
+			constexpr iter& operator *() const noexcept { return *ptr; }
+			constexpr iter* operator ->() const noexcept { return ptr; }
+			constexpr iter& operator [](difference_type n) const noexcept { return ptr[n]; }
+
+			constexpr IteratorBase& operator +=(difference_type n) noexcept { ptr += n; return *this; }
+			constexpr IteratorBase& operator -=(difference_type n) noexcept { ptr -= n; return *this; }
+
+			friend constexpr IteratorBase operator +(IteratorBase it, difference_type n) noexcept { return it += n; }
+			friend constexpr IteratorBase operator +(difference_type n, IteratorBase it) noexcept { return it += n; }
+			friend constexpr IteratorBase operator -(IteratorBase it, difference_type n) noexcept { return it -= n; }
+			friend constexpr difference_type operator -(const IteratorBase& a, const IteratorBase& b) noexcept { return a.ptr - b.ptr; }
+
+			constexpr IteratorBase& operator ++() noexcept { ++ptr; return *this; }
+			constexpr IteratorBase operator ++(int) noexcept { IteratorBase tmp = *this; ++ptr; return tmp; }
+
+			constexpr IteratorBase& operator --() noexcept { --ptr; return *this; }
+			constexpr IteratorBase operator --(int) noexcept { IteratorBase tmp = *this; --ptr; return tmp; }
+
+			friend constexpr bool operator ==(const IteratorBase& a, const IteratorBase& b) noexcept { return a.ptr == b.ptr; }
+			friend constexpr bool operator !=(const IteratorBase& a, const IteratorBase& b) noexcept { return a.ptr != b.ptr; }
+			friend constexpr bool operator < (const IteratorBase& a, const IteratorBase& b) noexcept { return a.ptr < b.ptr; }
+			friend constexpr bool operator > (const IteratorBase& a, const IteratorBase& b) noexcept { return a.ptr > b.ptr; }
+			friend constexpr bool operator <=(const IteratorBase& a, const IteratorBase& b) noexcept { return a.ptr <= b.ptr; }
+			friend constexpr bool operator >=(const IteratorBase& a, const IteratorBase& b) noexcept { return a.ptr >= b.ptr; }
 		};
 
 		template <typename iter>
-		class ReverseIterator {
-		private:
-			iter* it;
-		public:
-			ReverseIterator(iter* it_) : it(it_) {}
-
-			iter& operator *() const { return *it; }
-			iter* operator ->() const { return it; }
-
-			ReverseIterator& operator +=(size_t n) { it -= n; return *this; }
-			ReverseIterator& operator -=(size_t n) { it += n; return *this; }
-
-			ReverseIterator operator +(size_t n) const { return ReverseIterator(it - n); }
-			friend ReverseIterator operator+(size_t n, const ReverseIterator& it) { return ReverseIterator(it - n); }
-
-			ReverseIterator operator -(size_t n) const { return ReverseIterator(it + n); }
-			size_t operator -(ReverseIterator iter_) const { return size_t(iter_.it - it); }
-
-			ReverseIterator& operator ++() { --it; return *this; }
-			ReverseIterator operator ++(int) { ReverseIterator tmp = *this; --it; return tmp; }
-
-			ReverseIterator& operator --() { ++it; return *this; }
-			ReverseIterator operator --(int) { ReverseIterator tmp = *this; ++it; return tmp; }
-
-			bool operator==(const ReverseIterator& other) const { return it == other.it; }
-			bool operator!=(const ReverseIterator& other) const { return it != other.it; }
-			bool operator< (const ReverseIterator& other) const { return it > other.it; }
-			bool operator> (const ReverseIterator& other) const { return it < other.it; }
-			bool operator<=(const ReverseIterator& other) const { return it >= other.it; }
-			bool operator>=(const ReverseIterator& other) const { return it <= other.it; }
-		};
+		using ReverseIterator = std::reverse_iterator<IteratorBase<iter>>;
 
 		using Iterator = IteratorBase<T>;
 		using const_iterator = IteratorBase<const T>;
 		using reverse_iterator = ReverseIterator<T>;
 		using const_reverse_iterator = ReverseIterator<const T>;
 
-		Iterator begin() { return Iterator(data); }
-		Iterator end() { return Iterator(data + size); }
-		reverse_iterator rbegin() { return size > 0 ? reverse_iterator(data + size - 1) : reverse_iterator(data); }
-		reverse_iterator rend() { return reverse_iterator(data - 1); }
+		RAW_CONSTEXPR20 Iterator begin() { return Iterator(data); }
+		RAW_CONSTEXPR20 Iterator end() { return Iterator(data + size); }
+		RAW_CONSTEXPR20 reverse_iterator rbegin() { return reverse_iterator(end()); }
+		RAW_CONSTEXPR20 reverse_iterator rend() { return reverse_iterator(begin()); }
 
-		Iterator data_get() { return begin(); }
+		RAW_CONSTEXPR20 Iterator data_get() { return begin(); }
 
-		T& front() { return *begin(); }
-		T& back() { return *rbegin(); }
+		RAW_CONSTEXPR20 T& front() { return data[0]; }
+		RAW_CONSTEXPR20 T& back() { return data[size - 1]; }
 
-		const_iterator begin() const { return const_iterator(data); }
-		const_iterator end() const { return const_iterator(data + size); }
-		const_iterator cbegin() const { return const_iterator(data); }
-		const_iterator cend() const { return const_iterator(data + size); }
-		const_reverse_iterator crbegin() const { return size > 0 ? const_reverse_iterator(data + size - 1) : const_reverse_iterator(data); }
-		const_reverse_iterator crend() const { return const_reverse_iterator(data - 1); }
+		RAW_CONSTEXPR20 const_iterator begin() const { return const_iterator(data); }
+		RAW_CONSTEXPR20 const_iterator end() const { return const_iterator(data + size); }
+		RAW_CONSTEXPR20 const_iterator cbegin() const { return const_iterator(data); }
+		RAW_CONSTEXPR20 const_iterator cend() const { return const_iterator(data + size); }
+		RAW_CONSTEXPR20 const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+		RAW_CONSTEXPR20 const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+		RAW_CONSTEXPR20 const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+		RAW_CONSTEXPR20 const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
 
-		const_iterator data_get() const { return cbegin(); }
+		RAW_CONSTEXPR20 const_iterator data_get() const { return cbegin(); }
 
-		const T& back() const { return *crbegin(); }
-		const T& front() const { return *cbegin(); }
+		RAW_CONSTEXPR20 const T& back() const { return data[size - 1]; }
+		RAW_CONSTEXPR20 const T& front() const { return data[0]; }
 
 
 		virtual void insert(size_t index, const T& value) = 0;
@@ -148,6 +427,7 @@ namespace raw {
 
 		virtual void erase(size_t index) = 0;
 		virtual Iterator erase(Iterator pos) = 0;
+		virtual void erase_unordered(size_t index) = 0;
 
 		virtual void swap(vector_base<T>& other) noexcept = 0;
 
@@ -0,0 +1,280 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/************************************************************************
+* Allocation profiler for raw::vector.
+*
+* Define RAW_VECTOR_PROFILING before including any raw header (or pass
+* -DRAW_VECTOR_PROFILING) to turn it on. Without it `alloc_tag` is an empty
+* type and every hook in `vector_base` is an empty inline function, so the
+* containers keep their exact size and code.
+***********************************************************************/
+
+#ifdef RAW_VECTOR_PROFILING
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#endif
+
+namespace raw {
+	namespace profiling {
+		/// Allocation sizes are bucketed by power of two: bucket `i` holds sizes in [2^i, 2^(i+1)).
+		static constexpr size_t histogram_buckets = 64;
+
+		inline size_t histogram_bucket(size_t bytes) {
+			size_t bucket = 0;
+			while (bytes >>= 1) ++bucket;
+			return bucket;
+		}
+
+#ifdef RAW_VECTOR_PROFILING
+		/*********************************************************************
+		 * STRUCT: `tag_stats`
+		 *
+		 * Counters shared by every vector carrying the same tag.
+		 * Updated with relaxed atomics, so vectors on different threads can
+		 * share a tag.
+		 *********************************************************************/
+		struct tag_stats {
+			std::string name;
+			std::atomic<uint64_t> live_bytes{ 0 };
+			std::atomic<uint64_t> peak_bytes{ 0 };
+			std::atomic<uint64_t> allocations{ 0 };
+			std::atomic<uint64_t> reallocations{ 0 };
+			std::atomic<uint64_t> frees{ 0 };
+			std::atomic<uint64_t> relocations{ 0 };
+			std::atomic<uint64_t> bytes_moved{ 0 };
+			std::atomic<uint64_t> histogram[histogram_buckets] = {};
+
+			explicit tag_stats(std::string name_) : name(std::move(name_)) {}
+
+			void add_live(uint64_t bytes) {
+				uint64_t live = live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+				uint64_t peak = peak_bytes.load(std::memory_order_relaxed);
+				while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+			}
+			void sub_live(uint64_t bytes) { live_bytes.fetch_sub(bytes, std::memory_order_relaxed); }
+			void record_size(size_t bytes) { histogram[histogram_bucket(bytes)].fetch_add(1, std::memory_order_relaxed); }
+		};
+
+		/*********************************************************************
+		 * STRUCT: `tag_snapshot`
+		 *
+		 * Plain copy of a tag's counters taken by `registry::snapshot()`.
+		 * `slack_bytes` is the unused capacity of every live vector of the tag.
+		 *********************************************************************/
+		struct tag_snapshot {
+			std::string name;
+			uint64_t live_bytes = 0;
+			uint64_t peak_bytes = 0;
+			uint64_t slack_bytes = 0;
+			uint64_t live_vectors = 0;
+			uint64_t allocations = 0;
+			uint64_t reallocations = 0;
+			uint64_t frees = 0;
+			uint64_t relocations = 0;
+			uint64_t bytes_moved = 0;
+			uint64_t histogram[histogram_buckets] = {};
+		};
+
+		/// Intrusive list node every instrumented vector registers, used to compute slack.
+		struct vector_node {
+			const void* owner = nullptr;
+			size_t(*slack)(const void*) = nullptr;
+			tag_stats* stats = nullptr;
+			vector_node* prev = nullptr;
+			vector_node* next = nullptr;
+		};
+
+		/*********************************************************************
+		 * CLASS: `registry`
+		 *
+		 * Process wide owner of all tags and the live vector list.
+		 * `intern()` returns a stable pointer, so tags are resolved once per
+		 * vector and hooks never touch the map or the mutex.
+		 *********************************************************************/
+		class registry {
+		private:
+			std::mutex mutex;
+			std::map<std::string, std::unique_ptr<tag_stats>> tags;
+			vector_node* head = nullptr;
+
+			registry() = default;
+
+		public:
+			registry(const registry&) = delete;
+			registry& operator=(const registry&) = delete;
+
+			static registry& instance() {
+				static registry reg;
+				return reg;
+			}
+
+			tag_stats* intern(const char* name) {
+				std::lock_guard<std::mutex> lock(mutex);
+				auto& slot = tags[name ? name : "untagged"];
+				if (!slot) slot.reset(new tag_stats(name ? name : "untagged"));
+				return slot.get();
+			}
+
+			void link(vector_node* node) {
+				std::lock_guard<std::mutex> lock(mutex);
+				node->prev = nullptr;
+				node->next = head;
+				if (head) head->prev = node;
+				head = node;
+			}
+
+			void unlink(vector_node* node) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (node->prev) node->prev->next = node->next;
+				else head = node->next;
+				if (node->next) node->next->prev = node->prev;
+				node->prev = node->next = nullptr;
+			}
+
+			/*************************************************************************************
+			 * SNAPSHOT FUNCTION: `snapshot()`
+			 *
+			 * Copies every tag's counters and walks the live vectors to sum their slack.
+			 * Reads the size and capacity of live vectors, so it must not run while another
+			 * thread is modifying one of them.
+			 *************************************************************************************/
+			std::vector<tag_snapshot> snapshot() {
+				std::lock_guard<std::mutex> lock(mutex);
+				std::vector<tag_snapshot> result;
+				std::map<const tag_stats*, size_t> index;
+				for (auto& entry : tags) {
+					const tag_stats& s = *entry.second;
+					tag_snapshot snap;
+					snap.name = s.name;
+					snap.live_bytes = s.live_bytes.load(std::memory_order_relaxed);
+					snap.peak_bytes = s.peak_bytes.load(std::memory_order_relaxed);
+					snap.allocations = s.allocations.load(std::memory_order_relaxed);
+					snap.reallocations = s.reallocations.load(std::memory_order_relaxed);
+					snap.frees = s.frees.load(std::memory_order_relaxed);
+					snap.relocations = s.relocations.load(std::memory_order_relaxed);
+					snap.bytes_moved = s.bytes_moved.load(std::memory_order_relaxed);
+					for (size_t i = 0; i < histogram_buckets; ++i)
+						snap.histogram[i] = s.histogram[i].load(std::memory_order_relaxed);
+					index[&s] = result.size();
+					result.push_back(snap);
+				}
+				for (vector_node* node = head; node; node = node->next) {
+					tag_snapshot& snap = result[index[node->stats]];
+					snap.slack_bytes += node->slack(node->owner);
+					++snap.live_vectors;
+				}
+				return result;
+			}
+
+			tag_snapshot snapshot(const char* name) {
+				for (auto& snap : snapshot())
+					if (snap.name == name) return snap;
+				tag_snapshot empty;
+				empty.name = name;
+				return empty;
+			}
+
+			/// Zeroes the event counters of every tag. Live bytes stay, they describe memory still held.
+			void reset_counters() {
+				std::lock_guard<std::mutex> lock(mutex);
+				for (auto& entry : tags) {
+					tag_stats& s = *entry.second;
+					s.peak_bytes.store(s.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+					s.allocations.store(0, std::memory_order_relaxed);
+					s.reallocations.store(0, std::memory_order_relaxed);
+					s.frees.store(0, std::memory_order_relaxed);
+					s.relocations.store(0, std::memory_order_relaxed);
+					s.bytes_moved.store(0, std::memory_order_relaxed);
+					for (auto& bucket : s.histogram) bucket.store(0, std::memory_order_relaxed);
+				}
+			}
+
+			/*************************************************************************************
+			 * JSON FUNCTIONS: `dump_json(std::ostream&)`, `to_json()`
+			 *
+			 * Writes `{"tags":[{...}, ...]}` with one object per tag. The histogram is
+			 * emitted sparsely as `{"<bucket lower bound>": count}`.
+			 *************************************************************************************/
+			void dump_json(std::ostream& os) {
+				auto snaps = snapshot();
+				os << "{\"tags\":[";
+				for (size_t t = 0; t < snaps.size(); ++t) {
+					const tag_snapshot& s = snaps[t];
+					if (t) os << ',';
+					os << "{\"name\":\"";
+					for (char c : s.name) {
+						if (c == '"' || c == '\\') os << '\\';
+						os << c;
+					}
+					os << "\",\"live_bytes\":" << s.live_bytes
+						<< ",\"peak_bytes\":" << s.peak_bytes
+						<< ",\"slack_bytes\":" << s.slack_bytes
+						<< ",\"live_vectors\":" << s.live_vectors
+						<< ",\"allocations\":" << s.allocations
+						<< ",\"reallocations\":" << s.reallocations
+						<< ",\"frees\":" << s.frees
+						<< ",\"relocations\":" << s.relocations
+						<< ",\"bytes_moved\":" << s.bytes_moved
+						<< ",\"histogram\":{";
+					bool first = true;
+					for (size_t i = 0; i < histogram_buckets; ++i) {
+						if (!s.histogram[i]) continue;
+						if (!first) os << ',';
+						first = false;
+						os << '"' << (uint64_t(1) << i) << "\":" << s.histogram[i];
+					}
+					os << "}}";
+				}
+				os << "]}";
+			}
+
+			std::string to_json() {
+				std::ostringstream os;
+				dump_json(os);
+				return os.str();
+			}
+		};
+
+		inline std::vector<tag_snapshot> snapshot() { return registry::instance().snapshot(); }
+		inline tag_snapshot snapshot(const char* name) { return registry::instance().snapshot(name); }
+		inline std::string to_json() { return registry::instance().to_json(); }
+		inline void dump_json(std::ostream& os) { registry::instance().dump_json(os); }
+		inline void reset_counters() { registry::instance().reset_counters(); }
+#endif
+	}
+
+	/*********************************************************************
+	 * STRUCT: `alloc_tag`
+	 *
+	 * Names the accounting bucket of a vector, passed to a constructor:
+	 *     raw::vector<int> v(raw::alloc_tag("index"));
+	 * Resolving a name takes the registry lock, so hot code should build the
+	 * tag once and reuse it. Empty when profiling is disabled.
+	 *********************************************************************/
+#ifdef RAW_VECTOR_PROFILING
+	struct alloc_tag {
+		profiling::tag_stats* stats;
+		alloc_tag() : stats(untagged()) {}
+		explicit alloc_tag(const char* name) : stats(profiling::registry::instance().intern(name)) {}
+
+	private:
+		static profiling::tag_stats* untagged() {
+			static profiling::tag_stats* stats = profiling::registry::instance().intern("untagged");
+			return stats;
+		}
+	};
+#else
+	struct alloc_tag {
+		constexpr alloc_tag() noexcept {}
+		constexpr explicit alloc_tag(const char*) noexcept {}
+	};
+#endif
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+/************************************************************************
+* Hooks for the lazy element-wise expressions in RawNamespace/expr.
+*
+* vector_triv accepts any expression on construction and assignment, but
+* it must not depend on the expression header itself. Expressions derive
+* from `expression_tag`; `assign_expression` is defined in RawExpr.hpp,
+* which every caller that builds an expression has already included.
+***********************************************************************/
+
+namespace raw {
+	namespace detail {
+		struct expression_tag {};
+
+		template<typename Vector, typename Expr>
+		void assign_expression(Vector& dst, const Expr& expr);
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include "RawNamespace/RawErrors.hpp"
+
+/************************************************************************
+* Compile-time tables built with raw::vector (C++20 only).
+*
+* A vector filled during constant evaluation has to release its buffer
+* before evaluation ends, so it cannot be stored in a constexpr variable
+* itself. `freeze` runs the builder at compile time and copies the
+* result into a `std::array` of exactly the right length:
+*
+*     constexpr raw::vector<uint32_t> make_crc_table() { ... }
+*     static constexpr auto crc_table = raw::freeze<make_crc_table>();
+*
+* The table lives in read-only data; nothing runs at startup.
+***********************************************************************/
+
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+namespace raw {
+	/*********************************************************************
+	 * FUNCTION: `freeze<Make>()`
+	 *
+	 * `Make` is a constexpr function (or captureless lambda) returning a
+	 * raw::vector. Returns `std::array<value_type, Make().get_size()>`
+	 * holding the same elements. `value_type` must be default constructible.
+	 *********************************************************************/
+	template<auto Make>
+	consteval auto freeze() {
+		using vector_type = decltype(Make());
+		using value_type = typename vector_type::value_type;
+		constexpr size_t count = Make().get_size();
+
+		std::array<value_type, count> table{};
+		vector_type built = Make();
+		for (size_t i = 0; i < count; ++i)
+			table[i] = built[i];
+		return table;
+	}
+}
+#endif
@@ -0,0 +1,216 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+
+/************************************************************************
+* Raw memory and element helpers used by the vector specializations.
+*
+* At runtime they are the plain C calls (malloc, realloc, free, memcpy,
+* memmove, memset) and placement new. While a vector is evaluated at
+* compile time (C++20), the same calls go through `std::allocator` and
+* `std::construct_at`, which are the only operations a constant
+* expression may use. Buffers never cross between the two worlds: a
+* compile-time allocation has to be freed before evaluation ends.
+***********************************************************************/
+
+namespace raw {
+	namespace detail {
+		/*********************************************************************
+		 * ALLOCATION: `allocate<T>(n)`, `deallocate(p, n)`, `reallocate(p, old_n, live, new_n)`
+		 *
+		 * `allocate`   - storage for `n` elements, nothing constructed. nullptr on failure.
+		 * `deallocate` - frees storage from `allocate`/`reallocate`; `n` must be the
+		 *                element count it was allocated with.
+		 * `reallocate` - resizes a buffer of trivially copyable elements keeping the
+		 *                first `live` ones. nullptr on failure, `p` stays valid.
+		 *********************************************************************/
+		template<typename T>
+		RAW_CONSTEXPR20 T* allocate(size_t n) noexcept {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			if (std::is_constant_evaluated())
+				return std::allocator<T>().allocate(n);
+#endif
+			return static_cast<T*>(std::malloc(n * sizeof(T)));
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 void deallocate(T* p, size_t n) noexcept {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			if (std::is_constant_evaluated()) {
+				std::allocator<T>().deallocate(p, n);
+				return;
+			}
+#endif
+			(void)n;
+			std::free(p);
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 T* reallocate(T* p, size_t old_n, size_t live, size_t new_n) noexcept {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			if (std::is_constant_evaluated()) {
+				T* fresh = std::allocator<T>().allocate(new_n);
+				for (size_t i = 0; i < live && i < new_n; ++i)
+					std::construct_at(fresh + i, p[i]);
+				if (p)
+					std::allocator<T>().deallocate(p, old_n);
+				return fresh;
+			}
+#endif
+			(void)old_n; (void)live;
+			return static_cast<T*>(std::realloc(p, new_n * sizeof(T)));
+		}
+
+		/*********************************************************************
+		 * ELEMENT CONSTRUCTION: `construct(p, args...)`, `destroy(p)`
+		 *
+		 * Placement new and explicit destructor call, constexpr in C++20.
+		 *********************************************************************/
+		template<typename T, typename... Args>
+		RAW_CONSTEXPR20 T* construct(T* p, Args&&... args) {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			return std::construct_at(p, std::forward<Args>(args)...);
+#else
+			return ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+#endif
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 void destroy(T* p) noexcept {
+			p->~T();
+		}
+
+		/*********************************************************************
+		 * TRIVIAL ELEMENT OPERATIONS: `put()`, `copy_elements()`, `move_elements()`, `zero_elements()`
+		 *
+		 * For trivially copyable `T` only. At runtime these are a plain store,
+		 * memcpy, memmove and memset; at compile time each written slot is
+		 * (re)constructed so that it is a live object afterwards.
+		 *********************************************************************/
+		template<typename T>
+		RAW_CONSTEXPR20 void put(T* p, const T& value) noexcept {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			if (std::is_constant_evaluated()) {
+				std::construct_at(p, value);
+				return;
+			}
+#endif
+			*p = value;
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 void copy_elements(T* dst, const T* src, size_t n) noexcept {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			if (std::is_constant_evaluated()) {
+				for (size_t i = 0; i < n; ++i)
+					std::construct_at(dst + i, src[i]);
+				return;
+			}
+#endif
+			if (n) std::memcpy(dst, src, n * sizeof(T));
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 void move_elements(T* dst, const T* src, size_t n) noexcept {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			if (std::is_constant_evaluated()) {
+				if (dst < src) {
+					for (size_t i = 0; i < n; ++i)
+						std::construct_at(dst + i, src[i]);
+				}
+				else {
+					for (size_t i = n; i > 0; --i)
+						std::construct_at(dst + i - 1, src[i - 1]);
+				}
+				return;
+			}
+#endif
+			if (n) std::memmove(dst, src, n * sizeof(T));
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 void zero_elements(T* p, size_t n) noexcept {
+#ifdef RAW_HAS_CONSTEXPR_VECTOR
+			if (std::is_constant_evaluated()) {
+				for (size_t i = 0; i < n; ++i)
+					std::construct_at(p + i);
+				return;
+			}
+#endif
+			if (n) std::memset(p, 0, n * sizeof(T));
+		}
+
+		/*********************************************************************
+		 * RELOCATION: `destroy_elements()`, `copy_construct_elements()`,
+		 *             `move_construct_elements()`, `relocate_elements()`
+		 *
+		 * `destroy_elements(p, n)`             - destroys `n` elements.
+		 * `copy_construct_elements(dst, src, n)` - copies into uninitialized `dst`.
+		 * `move_construct_elements(dst, src, n)` - the same with `std::move_if_noexcept`;
+		 *                                        `src` stays alive (moved from).
+		 * `relocate_elements(dst, src, n)`     - moves, then destroys `src`.
+		 *
+		 * If a constructor throws, the elements built in `dst` are destroyed
+		 * and `src` is left intact: types whose move may throw are copied, so
+		 * growth keeps the strong guarantee. Trivially copyable `T` is a memcpy.
+		 *********************************************************************/
+		template<typename T>
+		RAW_CONSTEXPR20 void destroy_elements(T* p, size_t n) noexcept {
+			if constexpr (!myis_trivial<T>::value) {
+				for (size_t i = 0; i < n; ++i)
+					destroy(p + i);
+			}
+			else {
+				(void)p; (void)n;
+			}
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 void copy_construct_elements(T* dst, const T* src, size_t n) {
+			if constexpr (myis_trivial<T>::value) {
+				copy_elements(dst, src, n);
+			}
+			else {
+				size_t built = 0;
+				RAW_TRY {
+					for (; built < n; ++built)
+						construct(dst + built, src[built]);
+				}
+				RAW_CATCH_ALL {
+					destroy_elements(dst, built);
+					RAW_RETHROW;
+				}
+			}
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 void move_construct_elements(T* dst, T* src, size_t n) {
+			if constexpr (myis_trivial<T>::value) {
+				copy_elements(dst, src, n);
+			}
+			else {
+				size_t built = 0;
+				RAW_TRY {
+					for (; built < n; ++built)
+						construct(dst + built, std::move_if_noexcept(src[built]));
+				}
+				RAW_CATCH_ALL {
+					destroy_elements(dst, built);
+					RAW_RETHROW;
+				}
+			}
+		}
+
+		template<typename T>
+		RAW_CONSTEXPR20 void relocate_elements(T* dst, T* src, size_t n) {
+			move_construct_elements(dst, src, n);
+			destroy_elements(src, n);
+		}
+	}
+}
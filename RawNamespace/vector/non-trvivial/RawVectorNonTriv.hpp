@@ -4,7 +4,11 @@
 #include <cstdlib>
 #include <algorithm>
 #include <memory>
-#include "RawNamespace\vector\RawVector.hpp"
+#include <limits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/vector/memory_ops.hpp"
+#include "RawNamespace/vector/RawVector.hpp"
 
 
 namespace raw {
@@ -23,78 +27,130 @@ namespace raw {
 		 * Throws: std::bad_alloc on allocation failure.
 		 *************************************************************************************/
 
-		T* normalize_capacity() {
-			while (size >= capacity) capacity *= 2;
-
-			void* raw = malloc(sizeof(T) * capacity);
-			if (!raw) throw std::bad_alloc();
-
-			T* new_data = static_cast<T*>(raw);
-
-			for (size_t i = 0; i < size; ++i) {
-				new (new_data + i) T(std::move(data[i]));
-				data[i].~T();
-			}
-			T* old_data = data;
-			data = new_data;
-			free(old_data);
-
-			return new_data;
+		RAW_CONSTEXPR20 T* normalize_capacity() override {
+			detail::raise_if(try_grow(size), (size + 1) * sizeof(T));
+			return data;
 		}
 
 		/*************************************************************************************
-		 * PRIVATE FUNCTION: `normalize_capacity(size_t size_)`
+		 * PRIVATE FUNCTIONS: `grown_capacity()`, `relocate()`, `try_grow()`
 		 *
-		 * Reallocates `data` with doubled capacity to fit `size_`.
-		 * Constructs new elements in new memory using move semantics.
-		 * Destroys old elements.
-		 * Returns pointer to the new `data`.
+		 * `grown_capacity(current, required)` - doubles `current` until it exceeds `required`,
+		 *                                       returns 0 if that would pass `max_size()`.
+		 * `relocate(new_capacity)`            - moves the elements into a new buffer of
+		 *                                       `new_capacity`, leaves the vector untouched
+		 *                                       if the allocation or an element copy fails.
+		 * `try_grow(required)`                - makes `capacity > required` with doubling growth.
 		 *
-		 * Throws: std::bad_alloc on allocation failure.
+		 * Allocation failures come back as `status`, never as exceptions.
 		 *************************************************************************************/
 
-		T* normalize_capacity(size_t size_) {
-			if (std::numeric_limits<size_t>::max() / 2 < size_) throw std::bad_alloc();
-			if (capacity == 0) capacity = 1;
-			while (size_ >= capacity) capacity *= 2;
-
-			void* raw = malloc(sizeof(T) * capacity);
-			if (!raw) throw std::bad_alloc();
-
-			T* new_data = static_cast<T*>(raw);
+		static RAW_CONSTEXPR20 size_t grown_capacity(size_t current, size_t required) noexcept {
+			size_t new_capacity = current ? current : 1;
+			while (required >= new_capacity) {
+				if (new_capacity > max_size() / 2)
+					return required < max_size() ? max_size() : 0;
+				new_capacity *= 2;
+			}
+			return new_capacity;
+		}
 
-			for (size_t i = 0; i < size; ++i) {
-				new (new_data + i) T(std::move(data[i]));
-				data[i].~T();
+		RAW_CONSTEXPR20 status relocate(size_t new_capacity) {
+			if (new_capacity > max_size())
+				return status::length_error;
+			T* new_data = detail::allocate<T>(new_capacity);
+			if (!new_data)
+				return status::out_of_memory;
+			RAW_TRY {
+				detail::relocate_elements(new_data, data, size);
+			}
+			RAW_CATCH_ALL {
+				detail::deallocate(new_data, new_capacity);
+				RAW_RETHROW;
 			}
-			T* old_data = data;
+			this->free_buffer();
 			data = new_data;
-			free(old_data);
+			capacity = new_capacity;
+			this->track_buffer(size * sizeof(T));
+			return status::ok;
+		}
 
-			return new_data;
+		RAW_CONSTEXPR20 status try_grow(size_t required) {
+			if (RAW_LIKELY(data && required < capacity))
+				return status::ok;
+			size_t new_capacity = grown_capacity(capacity, required);
+			if (!new_capacity)
+				return status::length_error;
+			return relocate(new_capacity);
 		}
 
 		/*************************************************************************************
-		 * PRIVATE FUNCTION: `reserve_space()`
+		 * PRIVATE FUNCTION: `grow_and_append(Arg&& arg)`
 		 *
-		 * Reserves memory for `capacity` elements.
-		 * Constructs default-initialized elements in the reserved space.
-		 * Returns pointer to the new `data`.
-		 *
-		 * Throws: std::bad_alloc on allocation failure.
+		 * Growth path of push_back, kept out of line. The new element is built in the new
+		 * buffer before the old elements move, so `arg` may refer into this vector.
 		 *************************************************************************************/
 
-		T* reserve_space() {
-			while (size >= capacity) capacity *= 2;
+		template<typename Arg>
+		RAW_COLD RAW_CONSTEXPR20 status grow_and_append(Arg&& arg) {
+			size_t new_capacity = grown_capacity(capacity, size);
+			if (!new_capacity)
+				return status::length_error;
+			T* new_data = detail::allocate<T>(new_capacity);
+			if (!new_data)
+				return status::out_of_memory;
+			RAW_TRY {
+				detail::construct(new_data + size, std::forward<Arg>(arg));
+			}
+			RAW_CATCH_ALL {
+				detail::deallocate(new_data, new_capacity);
+				RAW_RETHROW;
+			}
+			RAW_TRY {
+				detail::relocate_elements(new_data, data, size);
+			}
+			RAW_CATCH_ALL {
+				detail::destroy(new_data + size);
+				detail::deallocate(new_data, new_capacity);
+				RAW_RETHROW;
+			}
+			this->free_buffer();
+			data = new_data;
+			capacity = new_capacity;
+			this->track_buffer(size * sizeof(T));
+			++size;
+			return status::ok;
+		}
 
-			void* raw = malloc(sizeof(T) * capacity);
-			if (!raw) throw std::bad_alloc();
+		/// Applies the shrink policy after `size` dropped; keeps the buffer if allocation fails.
+		RAW_CONSTEXPR20 void apply_shrink_policy() {
+			size_t target = this->shrink_target();
+			if (RAW_UNLIKELY(target != 0))
+				(void)relocate(target);
+		}
 
-			T* new_data = static_cast<T*>(raw);
-			for (size_t i = 0; i < size; ++i)
-				new (new_data + i) T();
-			return new_data;
+		/// Shifts `[index, size)` one slot right and moves `value` into the gap; `index < size`.
+		/// `value` must not refer into this vector, since growing relocates it. If a move
+		/// assignment throws, the new last element is destroyed and the size stays the same.
+		RAW_CONSTEXPR20 status insert_value(size_t index, T&& value) {
+			status result = try_grow(size);
+			if (result != status::ok)
+				return result;
+			detail::construct(data + size, std::move(data[size - 1]));
+			RAW_TRY {
+				for (size_t i = size - 1; i > index; --i) {
+					data[i] = std::move(data[i - 1]);
+				}
+				data[index] = std::move(value);
+			}
+			RAW_CATCH_ALL {
+				detail::destroy(data + size);
+				RAW_RETHROW;
+			}
+			++size;
+			return status::ok;
 		}
+
 	protected:
 		using vector_base<T>::data;
 		using vector_base<T>::size;
@@ -108,16 +164,20 @@ namespace raw {
 		 * DEFAULT CONSTRUCTOR: `vector_non_triv()`
 		 *
 		 * Initializes with capacity 1 and default-constructs one element.
+		 * The `alloc_tag` overloads name the profiling bucket (see alloc_profiler.hpp).
 		 *
 		 * Throws: std::bad_alloc on allocation failure, exceptions from T's constructor.
 		 *********************************************************************/
 
-		vector_non_triv() {
+		RAW_CONSTEXPR20 vector_non_triv() : vector_non_triv(alloc_tag()) {}
+
+		RAW_CONSTEXPR20 explicit vector_non_triv(alloc_tag tag) : vector_base<T>(tag) {
 			size = 0;
 			capacity = 1;
-			T* raw_memory = (T*)malloc(sizeof(T));
-			if (!raw_memory) throw std::bad_alloc();
+			T* raw_memory = detail::allocate<T>(1);
+			if (!raw_memory) detail::alloc_failure(sizeof(T));
 			data = raw_memory;
+			this->track_buffer();
 		}
 
 		/*********************************************************************
@@ -129,21 +189,12 @@ namespace raw {
 		 * Throws: std::bad_alloc on allocation failure, exceptions from T's constructor.
 		 *********************************************************************/
 
-		vector_non_triv(size_t size_) {
-			size = size_;
-			capacity = 1;
-			try {
-				data = reserve_space();
-			}
-			catch (const std::bad_alloc& e) {
-				if (data) {
-					for (size_t i = 0; i < size; ++i)
-						data[i].~T();
-					free(data);
-				}
-				std::cerr << e.what() << std::endl;
-				throw;
-			}
+		RAW_CONSTEXPR20 vector_non_triv(size_t size_) : vector_non_triv(size_, alloc_tag()) {}
+
+		RAW_CONSTEXPR20 vector_non_triv(size_t size_, alloc_tag tag) : vector_base<T>(tag) {
+			capacity = 0;
+			detail::raise_if(try_grow(size_), size_ * sizeof(T));
+			detail::raise_if(try_resize(size_), size_ * sizeof(T));
 		}
 
 		/**************************************************************************************
@@ -155,111 +206,102 @@ namespace raw {
 		 * Throws: std::bad_alloc on allocation failure, exceptions from T's copy constructor.
 		 **************************************************************************************/
 
-		vector_non_triv(const vector_non_triv& other) {
-			size = other.size;
-			capacity = other.capacity;
-			try {
-				data = (T*)malloc(sizeof(T) * capacity);
-				for (size_t i = 0; i < size; ++i)
-					new (data + i) T(other.data[i]);
+		RAW_CONSTEXPR20 vector_non_triv(const vector_non_triv& other) : vector_base<T>(other.get_alloc_tag()) {
+			size_t new_capacity = other.capacity ? other.capacity : 1;
+			T* new_data = detail::allocate<T>(new_capacity);
+			if (!new_data) detail::alloc_failure(sizeof(T) * new_capacity);
+			RAW_TRY {
+				detail::copy_construct_elements(new_data, other.data, other.size);
 			}
-			catch (const std::bad_alloc& e) {
-				if (data) {
-					for (size_t i = 0; i < size; ++i)
-						data[i].~T();
-					free(data);
-				}
-				std::cerr << e.what() << std::endl;
-				throw;
+			RAW_CATCH_ALL {
+				detail::deallocate(new_data, new_capacity);
+				RAW_RETHROW;
 			}
+			data = new_data;
+			size = other.size;
+			capacity = new_capacity;
+			this->policy = other.policy;
+			this->track_buffer();
 		}
 
 		/*************************************************************************************
 		 * MOVE CONSTRUCTOR: `vector_non_triv(vector_non_triv&& other) noexcept`
 		 *
-		 * Move resources from `other`.
-		 * Transfers size, capacity, and move-constructs elements from `other`.
-		 * `other` becomes empty.
+		 * Takes over `other`'s buffer in O(1); no element is touched.
+		 * `other` becomes empty with capacity 0.
 		 *************************************************************************************/
 
-		vector_non_triv(vector_non_triv&& other) noexcept {
+		RAW_CONSTEXPR20 vector_non_triv(vector_non_triv&& other) noexcept : vector_base<T>(other.get_alloc_tag()) {
+			data = other.data;
 			size = other.size;
 			capacity = other.capacity;
-			data = (T*)malloc(sizeof(T) * capacity);
-			for (size_t i = 0; i < size; ++i){
-				new (data + i) T(std::move(other.data[i]));
-				other.data[i].~T();
-			}
+			this->policy = other.policy;
+			this->deleter = other.deleter;
+
+			other.data = nullptr;
 			other.size = 0;
 			other.capacity = 0;
-			free(other.data);
-			other.data = nullptr;
+			other.deleter = buffer_deleter();
+			other.retrack();
+			this->retrack();
 		}
 
 		/*************************************************************************************
 		 * COPY ASSIGNMENT: `operator=(const vector_non_triv& other)`
 		 *
 		 * Deep copy assignment from `other`.
-		 * Frees current data, then copies size, capacity, and copy-constructs elements.
+		 * Copy-constructs `other`'s elements into a new buffer, then frees the current one,
+		 * so a throwing copy leaves this vector unchanged.
 		 *
 		 * Throws: std::bad_alloc on allocation failure, exceptions from T's copy constructor.
 		 *************************************************************************************/
 
-		vector_non_triv& operator=(const vector_non_triv& other) {
+		RAW_CONSTEXPR20 vector_non_triv& operator=(const vector_non_triv& other) {
 			if (data == other.data)
 				return *this;
-			size_t free_cap = size;
+			size_t new_capacity = other.capacity ? other.capacity : 1;
+			T* new_data = detail::allocate<T>(new_capacity);
+			if (!new_data) detail::alloc_failure(sizeof(T) * new_capacity);
+			RAW_TRY {
+				detail::copy_construct_elements(new_data, other.data, other.size);
+			}
+			RAW_CATCH_ALL {
+				detail::deallocate(new_data, new_capacity);
+				RAW_RETHROW;
+			}
+			detail::destroy_elements(data, size);
+			this->free_buffer();
+			this->track_release();
+			data = new_data;
 			size = other.size;
-			capacity = other.capacity;
-			try {
-				for (size_t i = 0; i < free_cap; ++i)
-					data[i].~T();
-				free(data);
-				data = (T*)malloc(sizeof(T) * capacity);
-				for (size_t i = 0; i < other.size; ++i) {
-					new (data + i) T(other.data[i]);
-				}
-			}
-
-			catch (const std::bad_alloc& e) {
-				if (data) {
-					for (size_t i = 0; i < size; ++i)
-						data[i].~T();
-					free(data);
-				}
-				std::cerr << e.what() << std::endl;
-				throw;
-			}
+			capacity = new_capacity;
+			this->track_buffer();
 			return *this;
 		}
 
 		/*************************************************************************************
 		 * MOVE ASSIGNMENT: `operator=(vector_non_triv&& other) noexcept`
 		 *
-		 * Move assignment from `other`.
-		 * Frees current data, then moves size, capacity, and move-constructs elements.
-		 * `other` becomes empty.
+		 * Destroys the current elements and frees the buffer, then takes over
+		 * `other`'s buffer in O(1). `other` becomes empty with capacity 0.
 		 *************************************************************************************/
 
-		vector_non_triv& operator=(vector_non_triv&& other) noexcept {
-			if (data == other.data)
-				return *this;
-			size_t free_cap = size;
-			size = other.size;
-			capacity = other.capacity;
-			for (size_t i = 0; i < free_cap; ++i)
-				data[i].~T();
-			free(data);
-			data = (T*)malloc(sizeof(T) * capacity);
-			for (size_t i = 0; i < other.size; ++i) {
-				new (data + i) T(std::move(other.data[i]));
-				other.data[i].~T();
+		RAW_CONSTEXPR20 vector_non_triv& operator=(vector_non_triv&& other) noexcept {
+			if (this != &other) {
+				detail::destroy_elements(data, size);
+				this->free_buffer();
+				this->track_release();
+				data = other.data;
+				size = other.size;
+				capacity = other.capacity;
+				this->deleter = other.deleter;
+				other.data = nullptr;
+				other.size = 0;
+				other.capacity = 0;
+				other.deleter = buffer_deleter();
+				other.retrack();
+				this->retrack();
 			}
-
-			free(other.data);
-			other.size = 0;
-			other.capacity = 0;
-			other.data = nullptr;
 			return *this;
 		}
 
@@ -267,27 +309,100 @@ namespace raw {
 		 * PUSH_BACK FUNCTIONS: `push_back(const T& elem)`, `push_back(T&& elem)`
 		 *
 		 * Appends element `elem` to the end.
-		 * Reallocates memory if needed (using `normalize_capacity`).
+		 * Reallocates memory if `capacity` is full (out of line, see `grow_and_append`).
 		 * Overloads for copy and move semantics.
 		 *
-		 * Throws: std::bad_alloc on allocation failure, exceptions from T's constructors.
+		 * Throws: std::bad_alloc on allocation failure (through the alloc failure handler),
+		 *         exceptions from T's constructors.
 		 *********************************************************************/
 
-		void push_back(const T& elem) override {
-			if (size >= capacity) {
-				data = normalize_capacity();
+		RAW_CONSTEXPR20 void push_back(const T& elem) override {
+			if (RAW_UNLIKELY(size >= capacity)) {
+				detail::raise_if(grow_and_append(elem), (size + 1) * sizeof(T));
+				return;
 			}
-			new (data + size) T(elem);
+			detail::construct(data + size, elem);
 			++size;
 		};
-		void push_back(T&& elem) override {
-			if (size >= capacity) {
-				data = normalize_capacity();
+		RAW_CONSTEXPR20 void push_back(T&& elem) override {
+			if (RAW_UNLIKELY(size >= capacity)) {
+				detail::raise_if(grow_and_append(std::move(elem)), (size + 1) * sizeof(T));
+				return;
 			}
-			new (data + size) T(std::move(elem));
+			detail::construct(data + size, std::move(elem));
 			++size;
 		};
 
+		/*********************************************************************
+		 * NON-THROWING FUNCTIONS: `try_push_back()`, `try_reserve()`, `try_resize()`, `try_insert()`
+		 *
+		 * Same effect as the throwing versions, but allocation failures and bad
+		 * indices are reported through `raw::status` and never reach the
+		 * allocation failure handler. On failure the vector is unchanged.
+		 * Exceptions thrown by T's constructors still propagate.
+		 *********************************************************************/
+
+		RAW_CONSTEXPR20 status try_push_back(const T& elem) override {
+			if (RAW_UNLIKELY(size >= capacity))
+				return grow_and_append(elem);
+			detail::construct(data + size, elem);
+			++size;
+			return status::ok;
+		}
+
+		RAW_CONSTEXPR20 status try_push_back(T&& elem) override {
+			if (RAW_UNLIKELY(size >= capacity))
+				return grow_and_append(std::move(elem));
+			detail::construct(data + size, std::move(elem));
+			++size;
+			return status::ok;
+		}
+
+		RAW_CONSTEXPR20 status try_reserve(size_t reserve_size) override {
+			if (reserve_size <= capacity && data)
+				return status::ok;
+			return relocate(reserve_size ? reserve_size : 1);
+		}
+
+		RAW_CONSTEXPR20 status try_resize(size_t new_size) override {
+			if (new_size <= size) {
+				detail::destroy_elements(data + new_size, size - new_size);
+				size = new_size;
+				apply_shrink_policy();
+				return status::ok;
+			}
+			status result = try_grow(new_size);
+			if (result != status::ok)
+				return result;
+			size_t constructed = size;
+			RAW_TRY {
+				for (; constructed < new_size; ++constructed)
+					detail::construct(data + constructed);
+			}
+			RAW_CATCH_ALL {
+				detail::destroy_elements(data + size, constructed - size);
+				RAW_RETHROW;
+			}
+			size = new_size;
+			return status::ok;
+		}
+
+		RAW_CONSTEXPR20 status try_insert(size_t index, const T& value) override {
+			if (index > size)
+				return status::out_of_range;
+			if (index == size)
+				return try_push_back(value);
+			return insert_value(index, T(value));
+		}
+
+		RAW_CONSTEXPR20 status try_insert(size_t index, T&& value) override {
+			if (index > size)
+				return status::out_of_range;
+			if (index == size)
+				return try_push_back(std::move(value));
+			return insert_value(index, std::move(value));
+		}
+
 		/*********************************************************************
 		 * INDEXING FUNCTIONS: `at()`, `operator[]` (const and non-const)
 		 *
@@ -296,95 +411,99 @@ namespace raw {
 		 * `operator[]` - no bounds checking.
 		 *********************************************************************/
 
-		T& at(const size_t index) override {
+		RAW_CONSTEXPR20 T& at(const size_t index) override {
 			if (index >= size) {
-				throw std::out_of_range("Index out of range");
+				detail::throw_out_of_range("Index out of range");
 			}
 			return data[index];
 		}
-		const T& at(const size_t index) const override {
+		RAW_CONSTEXPR20 const T& at(const size_t index) const override {
 			if (index >= size) {
-				throw std::out_of_range("Index out of range");
+				detail::throw_out_of_range("Index out of range");
 			}
 			return data[index];
 		};
 
-		T& operator [] (const size_t index) override {
+		RAW_CONSTEXPR20 T& operator [] (const size_t index) override {
 			return data[index];
 		};
-		const T& operator [] (const size_t index) const override {
+		RAW_CONSTEXPR20 const T& operator [] (const size_t index) const override {
 			return data[index];
 		};
 
+		/// Largest element count whose byte size still fits in `ptrdiff_t`.
+		static constexpr size_t max_size() noexcept {
+			return size_t(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(T);
+		}
+
 		/*********************************************************************
 		 * RESIZE FUNCTION: `resize(size_t new_size)`
 		 *
 		 * Changes vector size to `new_size`.
-		 * Reallocates if needed, default-constructs new elements.
+		 * Reallocates if `new_size` does not fit, default-constructs new elements.
 		 *
 		 * Throws: std::bad_alloc on allocation failure, exceptions from T's constructor.
 		 *********************************************************************/
 
-		void resize(size_t new_size) override {
-			if (new_size < size) {
-				for (size_t i = new_size; i < size; ++i)
-					data[i].~T();
-				size = new_size;
-			}
-			else {
-				while (new_size >= capacity) capacity *= 2;
-
-				T* new_data = (T*)malloc(sizeof(T) * capacity);
-				if (!new_data) throw std::bad_alloc();
-
-				for (size_t i = 0; i < size; ++i) {
-					new (new_data + i) T(std::move(data[i]));
-					data[i].~T();
-				}
-
-				for(size_t i = size; i < new_size; ++i)
-					new (new_data + i) T();
-				free(data);
-				size = new_size;
-				data = new_data;
-			}
+		RAW_CONSTEXPR20 void resize(size_t new_size) override {
+			detail::raise_if(try_resize(new_size), new_size * sizeof(T));
 		}
 
 		/*********************************************************************
 		 * RESERVE FUNCTION: `reserve(size_t reserve_size)`
 		 *
 		 * Reserves memory for at least `reserve_size` elements.
-		 * Does not change `size`.
-		 * Default-constructs elements in reserved space.
+		 * Does not change `size` and constructs nothing.
 		 *
 		 * Throws: std::bad_alloc on allocation failure, exceptions from T's constructor.
 		 *********************************************************************/
 
-		void reserve(size_t reserve_size) override {
-			if (reserve_size < capacity)
+		RAW_CONSTEXPR20 void reserve(size_t reserve_size) override {
+			if (reserve_size <= capacity)
 				return;
-			try {
-				data = normalize_capacity(reserve_size);
-			}
-			catch (const std::bad_alloc& e) { std::cerr << e.what() << std::endl; throw; }
+			detail::raise_if(try_reserve(reserve_size), reserve_size * sizeof(T));
 		}
 
 		/*********************************************************************
 		 * CLEAR FUNCTION: `clear()`
 		 *
-		 * Removes all elements, destroys them, and frees memory.
-		 * Resets to initial state (capacity 1, one default-constructed element).
+		 * Destroys all elements. Keeps the buffer unless the shrink policy
+		 * says otherwise, so clear-and-refill loops do not reallocate.
 		 *
-		 * Throws: std::bad_alloc on allocation failure, exceptions from T's constructor/destructor.
+		 * Throws: exceptions from T's destructor.
 		 *********************************************************************/
 
-		void clear() override {
-			for (size_t i = 0; i < size; ++i)
-				data[i].~T();
-			free(data);
+		RAW_CONSTEXPR20 void clear() override {
+			detail::destroy_elements(data, size);
 			size = 0;
-			capacity = 1;
-			data = (T*)malloc(sizeof(T));
+			apply_shrink_policy();
+		}
+
+		/*********************************************************************
+		 * MEMORY RETURN: `trim()`, `release()`
+		 *
+		 * `trim()`    - moves the elements into a buffer of max(size, policy
+		 *               min_capacity) now, ignoring the policy's threshold.
+		 *               Keeps the buffer if the allocation fails.
+		 * `release()` - destroys all elements and frees the buffer; capacity
+		 *               becomes 0 and the next insertion allocates again.
+		 *
+		 * Throws: exceptions from T's move constructor (`trim`).
+		 *********************************************************************/
+
+		RAW_CONSTEXPR20 void trim() override {
+			size_t target = this->trim_target();
+			if (data && target < capacity)
+				(void)relocate(target);
+		}
+
+		RAW_CONSTEXPR20 void release() noexcept override {
+			detail::destroy_elements(data, size);
+			this->free_buffer();
+			data = nullptr;
+			size = 0;
+			capacity = 0;
+			this->track_buffer();
 		}
 
 		/**************************************************************************************
@@ -393,42 +512,44 @@ namespace raw {
 		 * Reduces capacity to match `size`, minimizing memory.
 		 * Destroys elements beyond `size`.
 		 * Can be inefficient if called frequently.
-		 *
-		 * Throws: std::bad_alloc on allocation failure, exceptions from T's destructor.
+		 * Keeps the current buffer if the allocation fails.
 		 **************************************************************************************/
 
-		void shrink_to_fit() override {
+		RAW_CONSTEXPR20 void shrink_to_fit() override {
 			if (size == capacity || size == 0)
 				return;
-			void* raw = malloc(sizeof(T) * size);
-			if (!raw) throw std::bad_alloc();
-
-			T* new_data = static_cast<T*>(raw);
+			T* new_data = detail::allocate<T>(size);
+			if (!new_data) return; // keep the larger buffer
 
-			for (size_t i = 0; i < size; ++i) {
-				new (new_data + i) T(std::move(data[i]));
-				data[i].~T();
+			RAW_TRY {
+				detail::relocate_elements(new_data, data, size);
+			}
+			RAW_CATCH_ALL {
+				detail::deallocate(new_data, size);
+				RAW_RETHROW;
 			}
 
-			free(data);
+			this->free_buffer();
 			data = new_data;
 			capacity = size;
+			this->track_buffer(size * sizeof(T));
 		}
 
 		/*********************************************************************
 		 * POP_BACK FUNCTION: `pop_back()`
 		 *
-		 * Removes the last element (decrements `size`), destroying it if needed.
-		 * Frees memory and resets if the vector becomes empty.
+		 * Removes and destroys the last element.
+		 * Memory is only returned if the shrink policy asks for it.
 		 *
 		 * Throws: std::out_of_range if vector is empty, exceptions from T's destructor.
 		 *********************************************************************/
 
-		void pop_back() override {
+		RAW_CONSTEXPR20 void pop_back() override {
 			if (size == 0)
-				throw std::out_of_range("Index out of range");
+				detail::throw_out_of_range("Index out of range");
 			--size;
-			data[size].~T();
+			detail::destroy(data + size);
+			apply_shrink_policy();
 		}
 
 		/*********************************************************************
@@ -442,120 +563,62 @@ namespace raw {
 		 * Throws: std::out_of_range, std::bad_alloc, exceptions from T's constructors.
 		 *********************************************************************/
 
-		void insert(size_t index, const T& value) override {
-			if (index > size) {
-				throw std::out_of_range("Index out of range");
-			}
-			if (index == size){
-				push_back(value);
-				return;
-			}
-			if (size == capacity) {
-				data = normalize_capacity();
-			}
-			new (data + size) T(std::move(data[size - 1]));
-			for (size_t i = size - 1; i > index; --i) {
-				data[i] = std::move(data[i - 1]);
-			}
-			data[index] = value;
-			++size;
+		RAW_CONSTEXPR20 void insert(size_t index, const T& value) override {
+			detail::raise_if(try_insert(index, value), (size + 1) * sizeof(T));
 		}
-		void insert(size_t index, T&& value) override {
-			if (index > size) {
-				throw std::out_of_range("Index out of range");
-			}
-			if (index == size) {
-				push_back(std::move(value));
-				return;
-			}
-				
-			if (size == capacity) {
-				data = normalize_capacity();
-			}
-			new (data + size) T(std::move(data[size - 1]));
-			for (size_t i = size - 1; i > index; --i) {
-				data[i] = std::move(data[i - 1]);
-			}
-			data[index] = std::move(value);
-			++size;
+		RAW_CONSTEXPR20 void insert(size_t index, T&& value) override {
+			detail::raise_if(try_insert(index, std::move(value)), (size + 1) * sizeof(T));
 		}
-		Iterator insert(Iterator pos, const T& value) override {
+		RAW_CONSTEXPR20 Iterator insert(Iterator pos, const T& value) override {
 			size_t insert_index = pos - Iterator(data);
-			if (insert_index > size) {
-				throw std::out_of_range("Index out of range");
-			}
-			if (insert_index == size) {
-				push_back(value);
-				return Iterator(data + insert_index);
-			}
-				
-			if (size == capacity) {
-				data = normalize_capacity();
-			}
-			new (data + size) T(std::move(data[size - 1]));
-			for (size_t i = size - 1; i > insert_index; --i) {
-				data[i] = std::move(data[i - 1]);
-			}
-			data[insert_index] = value;
-			++size;
+			detail::raise_if(try_insert(insert_index, value), (size + 1) * sizeof(T));
 			return Iterator(data + insert_index);
 		}
-		Iterator insert(Iterator pos, T&& value) override {
+		RAW_CONSTEXPR20 Iterator insert(Iterator pos, T&& value) override {
 			size_t insert_index = pos - Iterator(data);
-			if (insert_index > size) {
-				throw std::out_of_range("Index out of range");
-			}
-			if (insert_index == size){
-				push_back(std::move(value));
-				return Iterator(data + insert_index);
-			}
-			if (size == capacity) {
-				data = normalize_capacity();
-			}
-			new (data + size) T(std::move(data[size - 1]));
-			for (size_t i = size - 1; i > insert_index; --i) {
-				data[i] = std::move(data[i - 1]);
-			}
-			data[insert_index] = std::move(value);
-			++size;
+			detail::raise_if(try_insert(insert_index, std::move(value)), (size + 1) * sizeof(T));
 			return Iterator(data + insert_index);
 		}
 
 		/*********************************************************************
-		 * ERASE FUNCTIONS: `erase()` overloads
+		 * ERASE FUNCTIONS: `erase()` overloads, `erase_unordered()`
 		 *
-		 * Erases element at given index/iterator, destroying it.
-		 * Shifts subsequent elements using move semantics.
-		 * Overloads for index and iterator position.
+		 * `erase()`           - move-assigns every later element one slot down,
+		 *                       then destroys the last one. Keeps the order.
+		 * `erase_unordered()` - move-assigns the last element into `index` and
+		 *                       destroys the last one. O(1), does not keep the order.
+		 * To remove many elements, use `raw::erase_if` (one pass).
 		 *
-		 * Throws: std::out_of_range, exceptions from T's destructor.
+		 * Throws: std::out_of_range, exceptions from T's move assignment or destructor.
 		 *********************************************************************/
 
-		void erase(size_t index) override {
+		RAW_CONSTEXPR20 void erase(size_t index) override {
 			if (index >= size) {
-				throw std::out_of_range("Index out of range");
+				detail::throw_out_of_range("Index out of range");
 			}
-			data[index].~T();
-			for (size_t i = index; i < size - 1; ++i) {
+			for (size_t i = index; i + 1 < size; ++i) {
 				data[i] = std::move(data[i + 1]);
 			}
 			--size;
-			data[size].~T();
+			detail::destroy(data + size);
+			apply_shrink_policy();
 		}
 
-		Iterator erase(Iterator pos) override {
+		RAW_CONSTEXPR20 Iterator erase(Iterator pos) override {
 			size_t erase_index = pos - Iterator(data);
+			erase(erase_index);
+			return Iterator(data + erase_index);
+		}
 
-			if (erase_index >= size) {
-				throw std::out_of_range("Index out of range");
-			}
-			data[erase_index].~T();
-			for (size_t i = erase_index; i < size - 1; ++i) {
-				data[i] = std::move(data[i + 1]);
+		RAW_CONSTEXPR20 void erase_unordered(size_t index) override {
+			if (index >= size) {
+				detail::throw_out_of_range("Index out of range");
 			}
+			if (index + 1 != size)
+				data[index] = std::move(data[size - 1]);
 			--size;
-			data[size].~T();
-			return pos;
+			detail::destroy(data + size);
+			apply_shrink_policy();
 		}
 
 		/************************************************************
@@ -565,10 +628,13 @@ namespace raw {
 		 * Fast, no element operations.
 		 *************************************************************/
 
-		void swap(vector_base<T>& other) noexcept {
+		RAW_CONSTEXPR20 void swap(vector_base<T>& other) noexcept {
 			std::swap(size, other.size);
 			std::swap(capacity, other.capacity);
 			std::swap(data, other.data);
+			std::swap(this->deleter, other.deleter);
+			this->retrack();
+			other.retrack();
 		};
 
 		/// CHECKS IF OBJECT IS EMPTY, IF SIZE VARIABLE ISN'T HANDELED GOOD ENOUGH, CAN CAUSE CRUSH
@@ -577,12 +643,18 @@ namespace raw {
 		/*********************************************************************
 		 * DESTRUCTOR: `~vector_non_triv()`
 		 *
-		 * Destroys all constructed elements and prints a message.
-		 * Frees allocated memory.
+		 * Destroys all constructed elements and prints a message when built
+		 * with RAW_VECTOR_VERBOSE. Frees allocated memory.
 		 *
 		 * Throws: exceptions from T's destructor.
 		 *********************************************************************/
 
-		~vector_non_triv() override { for (size_t i = 0; i < size; ++i) data[i].~T(); std::cout << "Destryed objects in vector_non_triv, next comes memory freeing" << std::endl; }
+		RAW_CONSTEXPR20 ~vector_non_triv() override {
+			for (size_t i = 0; i < size; ++i) detail::destroy(data + i);
+#ifdef RAW_VECTOR_VERBOSE
+			if (!detail::is_constant_evaluated())
+				std::cout << "Destryed objects in vector_non_triv, next comes memory freeing" << std::endl;
+#endif
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+
+/************************************************************************
+* Moving buffers between raw::vector and std::vector.
+*
+* std::vector<T> cannot give up or take over a buffer, so conversions
+* with it copy. `std::vector<T, raw::malloc_allocator<T>>` gets its
+* buffers from malloc like raw::vector, so one direction is free for
+* trivially copyable `T`:
+*
+*     raw::malloc_vector<float> produced = produce(...);
+*     raw::vector<float> mine = raw::from_std_vector(std::move(produced));    // O(1)
+*     raw::malloc_vector<float> theirs = raw::to_std_vector(std::move(mine)); // one copy
+*
+* `from_std_vector` moves the std::vector into a temporary, catches the
+* buffer in a thread-local slot as the temporary frees it, and adopts
+* it. `to_std_vector` copies once: a std::vector only holds elements it
+* constructed itself, and constructing them over the bytes already in
+* a handed-in buffer would leave their values indeterminate.
+***********************************************************************/
+
+namespace raw {
+	namespace detail {
+		/// Buffer freed by a malloc_vector on this thread while `capture` is set.
+		struct std_handoff {
+			void* data = nullptr;
+			size_t capacity = 0;
+			bool capture = false;
+		};
+
+		inline std_handoff& handoff_slot() noexcept {
+			thread_local std_handoff slot;
+			return slot;
+		}
+	}
+
+	/*********************************************************************
+	 * ALLOCATOR: `malloc_allocator<T>`
+	 *
+	 * Stateless std allocator on malloc/free; all instances compare equal.
+	 * Elements are value-initialized, as with std::allocator.
+	 *
+	 * Throws: std::bad_alloc on allocation failure.
+	 *********************************************************************/
+	template<typename T>
+	class malloc_allocator {
+	public:
+		using value_type = T;
+		using is_always_equal = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+
+		malloc_allocator() noexcept = default;
+		template<typename U>
+		malloc_allocator(const malloc_allocator<U>&) noexcept {}
+
+		T* allocate(size_t n) {
+			if (n > static_cast<size_t>(-1) / sizeof(T))
+				detail::alloc_failure(static_cast<size_t>(-1));
+			void* p = std::malloc(n ? n * sizeof(T) : 1);
+			if (!p) detail::alloc_failure(n * sizeof(T));
+			return static_cast<T*>(p);
+		}
+
+		void deallocate(T* p, size_t n) noexcept {
+			detail::std_handoff& slot = detail::handoff_slot();
+			if (RAW_UNLIKELY(slot.capture)) {
+				slot.data = p;
+				slot.capacity = n;
+				slot.capture = false;
+				return;
+			}
+			std::free(p);
+		}
+
+		template<typename U>
+		friend bool operator==(const malloc_allocator&, const malloc_allocator<U>&) noexcept { return true; }
+		template<typename U>
+		friend bool operator!=(const malloc_allocator&, const malloc_allocator<U>&) noexcept { return false; }
+	};
+
+	template<typename T>
+	using malloc_vector = std::vector<T, malloc_allocator<T>>;
+
+	/*********************************************************************
+	 * FUNCTION: `to_std_vector(vector<T>&& v)`
+	 *
+	 * Returns a malloc_vector holding a copy of `v`'s elements (one pass
+	 * over the buffer, see above), then frees `v`'s buffer; `v` is left
+	 * empty with capacity 0. Trivially copyable `T` only.
+	 *
+	 * Throws: std::bad_alloc (`v` is unchanged then).
+	 *********************************************************************/
+	template<typename T>
+	malloc_vector<T> to_std_vector(vector_triv<T>&& v) {
+		static_assert(myis_trivial<T>::value, "to_std_vector copies raw bytes: T must be trivially copyable");
+		malloc_vector<T> out(v.get_data(), v.get_data() + v.get_size());
+		v.release();
+		return out;
+	}
+
+	/*********************************************************************
+	 * FUNCTION: `from_std_vector(malloc_vector<T>&& v)`, `from_std_vector(const std::vector<T, A>& v)`
+	 *
+	 * The first takes over `v`'s buffer in O(1) (trivially copyable `T`);
+	 * `v` is left empty. The second copies the elements of any std::vector.
+	 *
+	 * Throws: std::bad_alloc (copy), exceptions from T's copy constructor.
+	 *********************************************************************/
+	template<typename T>
+	vector<T> from_std_vector(malloc_vector<T>&& v) {
+		static_assert(myis_trivial<T>::value, "from_std_vector hands over raw bytes: T must be trivially copyable");
+		vector<T> out;
+		if (v.capacity() == 0)
+			return out;
+		const size_t count = v.size();
+		detail::std_handoff& slot = detail::handoff_slot();
+		slot.capture = true;
+		{
+			malloc_vector<T> dying(std::move(v));
+		}
+		T* data = static_cast<T*>(slot.data);
+		const size_t capacity = slot.capacity;
+		slot = detail::std_handoff();
+		out.adopt(data, count, capacity);
+		return out;
+	}
+
+	template<typename T, typename A>
+	vector<T> from_std_vector(const std::vector<T, A>& v) {
+		vector<T> out;
+		out.reserve(v.size());
+		for (const T& value : v)
+			out.push_back(value);
+		return out;
+	}
+}
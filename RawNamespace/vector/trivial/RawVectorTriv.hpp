@@ -4,7 +4,12 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
-#include "RawNamespace\vector\RawVector.hpp"
+#include <limits>
+#include <type_traits>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/vector/memory_ops.hpp"
+#include "RawNamespace/vector/RawVector.hpp"
+#include "RawNamespace/vector/expression_fwd.hpp"
 
 namespace raw {
 	template<typename T>
@@ -30,14 +35,78 @@ namespace raw {
 		  *
 		  * Throws: std::bad_alloc on allocation failure.
 		  *************************************************************************************************/
-		T* normalize_capacity() override {
-			while (size >= capacity) capacity *= 2;
-			T* new_data = (T*)realloc(data, sizeof(T) * capacity);
-			if (new_data) {
-				data = new_data;
-				return data;
+		RAW_CONSTEXPR20 T* normalize_capacity() override {
+			detail::raise_if(try_grow(size), (size + 1) * sizeof(T));
+			return data;
+		}
+
+		/*************************************************************************************************
+		 * PRIVATE FUNCTIONS: `grown_capacity()`, `reallocate()`, `try_grow()`
+		 *
+		 * `grown_capacity(current, required)` - doubles `current` until it exceeds `required`,
+		 *                                       returns 0 if that would pass `max_size()`.
+		 * `reallocate(new_capacity)`          - reallocs `data`, leaves the vector untouched on failure.
+		 * `try_grow(required)`                - makes `capacity > required` with doubling growth.
+		 *
+		 * None of them throw; failures come back as `status`.
+		 *************************************************************************************************/
+
+		static RAW_CONSTEXPR20 size_t grown_capacity(size_t current, size_t required) noexcept {
+			size_t new_capacity = current ? current : 1;
+			while (required >= new_capacity) {
+				if (new_capacity > max_size() / 2)
+					return required < max_size() ? max_size() : 0;
+				new_capacity *= 2;
 			}
-			throw std::bad_alloc();
+			return new_capacity;
+		}
+
+		RAW_CONSTEXPR20 status reallocate(size_t new_capacity) noexcept {
+			if (new_capacity > max_size())
+				return status::length_error;
+			size_t old_bytes = data ? capacity * sizeof(T) : 0;
+			T* new_data;
+			if (RAW_UNLIKELY(this->deleter.fn != nullptr)) {
+				// An adopted buffer cannot be realloc'd: copy into our own and hand it back.
+				new_data = detail::allocate<T>(new_capacity);
+				if (!new_data)
+					return status::out_of_memory;
+				detail::copy_elements(new_data, data, size < new_capacity ? size : new_capacity);
+				this->free_buffer();
+			}
+			else {
+				new_data = detail::reallocate(data, capacity, size, new_capacity);
+				if (!new_data)
+					return status::out_of_memory;
+			}
+			bool moved = data && new_data != data;
+			data = new_data;
+			capacity = new_capacity;
+			this->track_buffer(moved ? old_bytes : 0);
+			return status::ok;
+		}
+
+		RAW_CONSTEXPR20 status try_grow(size_t required) noexcept {
+			if (RAW_LIKELY(data && required < capacity))
+				return status::ok;
+			size_t new_capacity = grown_capacity(capacity, required);
+			if (!new_capacity)
+				return status::length_error;
+			return reallocate(new_capacity);
+		}
+
+		/// Applies the shrink policy after `size` dropped; keeps the buffer if realloc fails.
+		RAW_CONSTEXPR20 void apply_shrink_policy() noexcept {
+			size_t target = this->shrink_target();
+			if (RAW_UNLIKELY(target != 0))
+				(void)reallocate(target);
+		}
+
+		/// Growth path of push_back, kept out of line so the fast path inlines into the caller's loop.
+		RAW_COLD RAW_CONSTEXPR20 void push_back_slow(T elem) {
+			detail::raise_if(try_grow(size), (size + 1) * sizeof(T));
+			detail::put(data + size, elem);
+			++size;
 		}
 
 	protected:
@@ -53,11 +122,20 @@ namespace raw {
 		 * DEFAULT CONSTRUCTOR: `vector_triv()`
 		 *
 		 * Initializes with capacity for 1 element.
+		 * The `alloc_tag` overloads name the profiling bucket (see alloc_profiler.hpp).
 		 *********************************************************************/
-		vector_triv() {
-			data = (T*)malloc(sizeof(T));
+		RAW_CONSTEXPR20 vector_triv() {
+			data = detail::allocate<T>(1);
+			if (!data) detail::alloc_failure(sizeof(T));
+			this->track_buffer();
 		};
 
+		RAW_CONSTEXPR20 explicit vector_triv(alloc_tag tag) : vector_base<T>(tag) {
+			data = detail::allocate<T>(1);
+			if (!data) detail::alloc_failure(sizeof(T));
+			this->track_buffer();
+		}
+
 		/*********************************************************************
 		 * SIZE CONSTRUCTOR: `vector_triv(size_t size_)`
 		 *
@@ -66,18 +144,13 @@ namespace raw {
 		 *
 		 * Throws: std::bad_alloc on allocation failure.
 		 *********************************************************************/
-		vector_triv(size_t size_) {
+		RAW_CONSTEXPR20 vector_triv(size_t size_) : vector_triv(size_, alloc_tag()) {}
+
+		RAW_CONSTEXPR20 vector_triv(size_t size_, alloc_tag tag) : vector_base<T>(tag) {
+			capacity = 0;
+			detail::raise_if(try_grow(size_), size_ * sizeof(T));
+			detail::zero_elements(data, size_);
 			size = size_;
-			capacity = 1;
-			try {
-				normalize_capacity();
-				std::memset(data, 0, size_ * sizeof(T));
-			}
-			catch (std::bad_alloc& e) {
-				std::cerr << e.what() << std::endl;
-				free(data);
-				throw;
-			}
 		};
 
 		/**************************************************************************************
@@ -89,22 +162,15 @@ namespace raw {
 		 * Throws: std::bad_alloc on allocation failure.
 		 **************************************************************************************/
 
-		vector_triv(const vector_triv& other) {
+		RAW_CONSTEXPR20 vector_triv(const vector_triv& other) : vector_base<T>(other.get_alloc_tag()) {
+			T* newData = detail::allocate<T>(other.capacity ? other.capacity : 1);
+			if (!newData) detail::alloc_failure(other.capacity * sizeof(T));
+			detail::copy_elements(newData, other.data, other.size);
+			data = newData;
 			size = other.size;
-			capacity = other.capacity;
-			try {
-				T* newData = (T*)calloc(capacity, sizeof(T));
-				if (!newData) {
-					throw std::bad_alloc();
-				}
-				std::memcpy(newData, other.data, size * sizeof(T));
-				free(data);
-				data = newData;
-			}
-			catch (std::bad_alloc& e) {
-				std::cerr << e.what() << std::endl;
-				throw;
-			}
+			capacity = other.capacity ? other.capacity : 1;
+			this->policy = other.policy;
+			this->track_buffer();
 		}
 
 		/*************************************************************************************
@@ -114,14 +180,19 @@ namespace raw {
 		 * Transfers data, size, and capacity. `other` becomes empty.
 		 *************************************************************************************/
 
-		vector_triv(vector_triv&& other) noexcept {
+		RAW_CONSTEXPR20 vector_triv(vector_triv&& other) noexcept : vector_base<T>(other.get_alloc_tag()) {
 			data = other.data;
 			size = other.size;
 			capacity = other.capacity;
+			this->policy = other.policy;
+			this->deleter = other.deleter;
 
 			other.data = nullptr;
 			other.size = 0;
 			other.capacity = 0;
+			other.deleter = buffer_deleter();
+			other.retrack();
+			this->retrack();
 		}
 
 		/*************************************************************************************
@@ -133,25 +204,19 @@ namespace raw {
 		 * Throws: std::bad_alloc on allocation failure.
 		 *************************************************************************************/
 
-		vector_triv& operator=(const vector_triv& other) {
+		RAW_CONSTEXPR20 vector_triv& operator=(const vector_triv& other) {
 			if (this == &other) {
 				return *this;
 			}
-			try {
-				T* newData = (T*)calloc(other.capacity, sizeof(T));
-				if (!newData) {
-					throw std::bad_alloc();
-				}
-				std::memcpy(newData, other.data, other.size * sizeof(T));
-				free(data);
-				data = newData;
-				size = other.size;
-				capacity = other.capacity;
-			}
-			catch (std::bad_alloc& e) {
-				std::cerr << e.what() << std::endl;
-				throw;
-			}
+			T* newData = detail::allocate<T>(other.capacity ? other.capacity : 1);
+			if (!newData) detail::alloc_failure(other.capacity * sizeof(T));
+			detail::copy_elements(newData, other.data, other.size);
+			this->free_buffer();
+			this->track_release();
+			data = newData;
+			size = other.size;
+			capacity = other.capacity ? other.capacity : 1;
+			this->track_buffer();
 			return *this;
 		}
 
@@ -163,72 +228,132 @@ namespace raw {
 		 * `other` becomes empty.
 		 *************************************************************************************/
 
-		vector_triv& operator=(vector_triv&& other) noexcept {
+		RAW_CONSTEXPR20 vector_triv& operator=(vector_triv&& other) noexcept {
 			if (this != &other) {
-				free(data);
+				this->free_buffer();
+				this->track_release();
 				data = other.data;
 				size = other.size;
 				capacity = other.capacity;
+				this->deleter = other.deleter;
 				other.data = nullptr;
 				other.size = 0;
 				other.capacity = 0;
+				other.deleter = buffer_deleter();
+				other.retrack();
+				this->retrack();
 			}
 			return *this;
 		}
 
+		/*************************************************************************************
+		 * EXPRESSION ASSIGNMENT: `vector_triv(const Expr& expr)`, `operator=(const Expr& expr)`
+		 *
+		 * Evaluates a lazy element-wise expression (see RawNamespace/expr/RawExpr.hpp)
+		 * in one pass, resizing the vector to the expression's length. Operands that
+		 * overlap this vector at an offset are handled through a temporary.
+		 *
+		 * Throws: std::bad_alloc on allocation failure.
+		 *************************************************************************************/
+
+		template<typename Expr, typename = std::enable_if_t<std::is_base_of<detail::expression_tag, Expr>::value>>
+		vector_triv(const Expr& expr) : vector_triv() {
+			detail::assign_expression(*this, expr);
+		}
+
+		template<typename Expr, typename = std::enable_if_t<std::is_base_of<detail::expression_tag, Expr>::value>>
+		vector_triv& operator=(const Expr& expr) {
+			detail::assign_expression(*this, expr);
+			return *this;
+		}
+
 		/*************************************************************************************
 		 * PUSH_BACK FUNCTIONS: `push_back(const T& elem)`, `push_back(T&& elem)`
 		 *
 		 * Appends element `elem` to the end.
-		 * Reallocates memory if `capacity` is full (using `normalize_capacity`).
+		 * Reallocates memory if `capacity` is full (out of line, see `push_back_slow`).
 		 * Overloads for copy and move semantics.
 		 *
-		 * Throws: std::bad_alloc on allocation failure.
+		 * Throws: std::bad_alloc on allocation failure (through the alloc failure handler).
 		 *************************************************************************************/
 
-		void push_back(const T& elem) override {
-			if (!data)
-				data = (T*)malloc(sizeof(T));
-			try {
-				if (capacity <= size) {
-					capacity *= 2;
-					auto newdata = (T*)std::realloc(data, capacity * sizeof(T));
-					if (!newdata) {
-						std::cerr << "Couldn't reserve that much space ERR" << std::endl;
-						free(data);
-						throw std::bad_alloc();
-					}
-					data = newdata;
-				}
-				if (data)
-					data[size] = elem;
-				++size;
-			}
-			catch (...) {
-				std::cerr << "Something happened in push_back" << std::endl;
-				throw;
+		RAW_CONSTEXPR20 void push_back(const T& elem) override {
+			if (RAW_UNLIKELY(size >= capacity)) {
+				push_back_slow(elem);
+				return;
 			}
+			detail::put(data + size, elem);
+			++size;
 		}
 
-		void push_back(T&& elem) override {
-			if (!data)
-				data = (T*)malloc(sizeof(T));
-			try {
-				if (capacity <= size) {
-					normalize_capacity();
-				}
-				if (data) {
-					data[size] = std::move(elem);
-					++size;
-				}
-				else {
-					throw std::bad_alloc();
-				}
+		RAW_CONSTEXPR20 void push_back(T&& elem) override {
+			push_back(static_cast<const T&>(elem));
+		}
+
+		/*************************************************************************************
+		 * NON-THROWING FUNCTIONS: `try_push_back()`, `try_reserve()`, `try_resize()`, `try_insert()`
+		 *
+		 * Same effect as the throwing versions, but report failure through `raw::status`
+		 * and never call the allocation failure handler. On failure the vector is unchanged.
+		 *
+		 * Returns: status::ok, status::out_of_memory, status::length_error,
+		 *          status::out_of_range (try_insert with `index` > size).
+		 *************************************************************************************/
+
+		RAW_CONSTEXPR20 status try_push_back(const T& elem) noexcept override {
+			if (RAW_UNLIKELY(size >= capacity)) {
+				T value = elem;
+				status result = try_grow(size);
+				if (result != status::ok)
+					return result;
+				detail::put(data + size, value);
 			}
-			catch (...) {
-				std::cerr << "Something happened in push_back" << std::endl;
-				throw;
+			else {
+				detail::put(data + size, elem);
+			}
+			++size;
+			return status::ok;
+		}
+
+		RAW_CONSTEXPR20 status try_push_back(T&& elem) noexcept override {
+			return try_push_back(static_cast<const T&>(elem));
+		}
+
+		RAW_CONSTEXPR20 status try_reserve(size_t reserve_size) noexcept override {
+			if (reserve_size <= capacity && data)
+				return status::ok;
+			return reallocate(reserve_size ? reserve_size : 1);
+		}
+
+		RAW_CONSTEXPR20 status try_resize(size_t new_size) noexcept override {
+			if (new_size <= size) {
+				size = new_size;
+				apply_shrink_policy();
+				return status::ok;
 			}
+			status result = try_grow(new_size);
+			if (result != status::ok)
+				return result;
+			detail::zero_elements(data + size, new_size - size);
+			size = new_size;
+			return status::ok;
+		}
+
+		RAW_CONSTEXPR20 status try_insert(size_t index, const T& value) noexcept override {
+			if (index > size)
+				return status::out_of_range;
+			T copy = value;
+			status result = try_grow(size);
+			if (result != status::ok)
+				return result;
+			detail::move_elements(data + index + 1, data + index, size - index);
+			detail::put(data + index, copy);
+			++size;
+			return status::ok;
+		}
+
+		RAW_CONSTEXPR20 status try_insert(size_t index, T&& value) noexcept override {
+			return try_insert(index, static_cast<const T&>(value));
 		}
 
 		/*********************************************************************
@@ -239,40 +364,44 @@ namespace raw {
 		 * `operator[]` - no bounds checking.
 		 *********************************************************************/
 
-		T& at(const size_t index) override {
+		RAW_CONSTEXPR20 T& at(const size_t index) override {
 			if (index >= size || index < 0) {
-				throw std::out_of_range("Index out of range");
+				detail::throw_out_of_range("Index out of range");
 			}
 			return data[index];
 		}
 
-		const T& at(const size_t index) const override {
+		RAW_CONSTEXPR20 const T& at(const size_t index) const override {
 			if (index >= size || index < 0) {
-				throw std::out_of_range("Index out of range");
+				detail::throw_out_of_range("Index out of range");
 			}
 			return data[index];
 		}
 
-		T& operator [] (const size_t index) override {
+		RAW_CONSTEXPR20 T& operator [] (const size_t index) override {
 			return data[index];
 		}
 
-		const T& operator [] (const size_t index) const override {
+		RAW_CONSTEXPR20 const T& operator [] (const size_t index) const override {
 			return data[index];
 		}
 
 		/*********************************************************************
-		 * GETTER FUNCTIONS: `get_size()`, `get_capacity()`
+		 * GETTER FUNCTIONS: `get_size()`, `get_capacity()`, `max_size()`
 		 *
-		 * Returns current `size` and `capacity`.
+		 * Returns current `size` and `capacity`, and the largest element count
+		 * whose byte size still fits in `ptrdiff_t`.
 		 *********************************************************************/
 
-		size_t get_size() const {
+		RAW_CONSTEXPR20 size_t get_size() const {
 			return size;
 		}
-		size_t get_capacity() const {
+		RAW_CONSTEXPR20 size_t get_capacity() const {
 			return capacity;
 		}
+		static constexpr size_t max_size() noexcept {
+			return size_t(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(T);
+		}
 
 		/*************************************************************************************
 		 * RESIZE FUNCTION: `resize(size_t new_size)`
@@ -283,16 +412,8 @@ namespace raw {
 		 * Throws: std::bad_alloc on allocation failure.
 		 *************************************************************************************/
 
-		void resize(size_t new_size) override {
-			if (new_size <= size) {
-				size = new_size;
-				return;
-			}
-			size_t old_size = size;
-			size = new_size;
-			normalize_capacity();
-			if (old_size < size) { memset(data + old_size, 0, (size - old_size) * sizeof(T)); }
-
+		RAW_CONSTEXPR20 void resize(size_t new_size) override {
+			detail::raise_if(try_resize(new_size), new_size * sizeof(T));
 		}
 
 		/*************************************************************************************
@@ -304,44 +425,79 @@ namespace raw {
 		 * Throws: std::bad_alloc on allocation failure.
 		 *************************************************************************************/
 
-		void reserve(size_t reserve_size) override {
+		RAW_CONSTEXPR20 void reserve(size_t reserve_size) override {
 			if (reserve_size <= capacity) {
 				return;
 			}
-			try {
-				auto temp = (T*)realloc(data, reserve_size * sizeof(T));
-				if (!temp) {
-					std::cerr << "Couldn't reserve that much space ERR" << std::endl;
-					throw std::bad_alloc();
-				}
-				data = temp;
-				capacity = reserve_size;
-			}
-			catch (std::bad_alloc& err) {
-				std::cerr << err.what() << std::endl;
-				throw;
-			}
-			catch (...) {
-				std::cerr << "What tf happened here? P.S. -> (check reserve function)";
-				throw;
-			}
+			detail::raise_if(try_reserve(reserve_size), reserve_size * sizeof(T));
+		}
+
+		/*********************************************************************
+		 * SPARE CAPACITY: `spare_capacity()`, `spare_data()`, `reserve_spare(n)`,
+		 *                 `try_reserve_spare(n)`, `commit_spare(n)`
+		 *
+		 * For producers that write straight into the buffer (read(2), decoders):
+		 *     v.reserve_spare(4096);
+		 *     size_t produced = produce(v.spare_data(), v.spare_capacity());
+		 *     v.commit_spare(produced);
+		 * `reserve_spare(n)` grows like push_back (doubling) until at least `n`
+		 * elements fit after the end. `commit_spare(n)` appends the first `n`
+		 * spare elements as they are, without zeroing; `n` must not exceed
+		 * `spare_capacity()`.
+		 *
+		 * Throws: std::bad_alloc, std::length_error (`reserve_spare`).
+		 *********************************************************************/
+
+		RAW_CONSTEXPR20 size_t spare_capacity() const noexcept { return data ? capacity - size : 0; }
+		RAW_CONSTEXPR20 T* spare_data() noexcept { return data + size; }
+
+		RAW_CONSTEXPR20 status try_reserve_spare(size_t n) noexcept {
+			if (n == 0 || spare_capacity() >= n)
+				return status::ok;
+			if (n > max_size() - size)
+				return status::length_error;
+			return try_grow(size + n - 1);
+		}
+
+		RAW_CONSTEXPR20 void reserve_spare(size_t n) {
+			detail::raise_if(try_reserve_spare(n), (size + n) * sizeof(T));
 		}
 
+		RAW_CONSTEXPR20 void commit_spare(size_t n) noexcept { size += n; }
+
 		/*********************************************************************
 		 * CLEAR FUNCTION: `clear()`
 		 *
-		 * Removes all elements, frees memory.
-		 * Resets to initial state (capacity 1).
+		 * Removes all elements. Keeps the buffer unless the shrink policy
+		 * says otherwise, so clear-and-refill loops do not reallocate.
 		 *********************************************************************/
 
-		void clear() override {
-			if (data) {
-				free(data);
-				data = nullptr;
-			}
+		RAW_CONSTEXPR20 void clear() override {
 			size = 0;
-			capacity = 1;
-			data = (T*)malloc(sizeof(T));
+			apply_shrink_policy();
+		}
+
+		/*********************************************************************
+		 * MEMORY RETURN: `trim()`, `release()`
+		 *
+		 * `trim()`    - shrinks capacity to max(size, policy min_capacity) now,
+		 *               ignoring the policy's threshold. Keeps the buffer if realloc fails.
+		 * `release()` - drops all elements and frees the buffer; capacity becomes 0
+		 *               and the next insertion allocates again.
+		 *********************************************************************/
+
+		RAW_CONSTEXPR20 void trim() override {
+			size_t target = this->trim_target();
+			if (data && target < capacity)
+				(void)reallocate(target);
+		}
+
+		RAW_CONSTEXPR20 void release() noexcept override {
+			this->free_buffer();
+			data = nullptr;
+			size = 0;
+			capacity = 0;
+			this->track_buffer();
 		}
 
 		/**************************************************************************************
@@ -349,45 +505,43 @@ namespace raw {
 		 *
 		 * Reduces capacity to match `size`, minimizing memory.
 		 * Can be inefficient if called frequently.
-		 *
-		 * Throws: std::bad_alloc on allocation failure.
+		 * Keeps the current buffer if the shrinking realloc fails.
 		 **************************************************************************************/
 
-		void shrink_to_fit() override {
+		RAW_CONSTEXPR20 void shrink_to_fit() override {
+			if (RAW_UNLIKELY(this->deleter.fn != nullptr)) {
+				if (size != capacity && size != 0)
+					(void)reallocate(size);
+				return;
+			}
 			if (size != capacity && size != 0 && capacity != 1) {
-				try {
-					auto shrinked = (T*)realloc(data, size * sizeof(T));
-					if (!shrinked) {
-						free(data);
-						data = nullptr;
-						throw std::bad_alloc();
-					}
-					data = shrinked;
-					capacity = size;
-				}
-				catch (std::bad_alloc& err) {
-					std::cerr << err.what() << std::endl;
-					throw;
+				auto shrinked = detail::reallocate(data, capacity, size, size);
+				if (!shrinked) {
+					// the old, larger block is still valid
+					return;
 				}
+				bool moved = shrinked != data;
+				data = shrinked;
+				capacity = size;
+				this->track_buffer(moved ? size * sizeof(T) : 0);
 			}
-			else { return; }
-
 		}
 
 		/*********************************************************************
 		 * POP_BACK FUNCTION: `pop_back()`
 		 *
 		 * Removes the last element (decrements `size`).
-		 * Does not actually deallocate memory.
+		 * Memory is only returned if the shrink policy asks for it.
 		 *
 		 * Throws: std::out_of_range if vector is empty.
 		 *********************************************************************/
 
-		void pop_back() override {
+		RAW_CONSTEXPR20 void pop_back() override {
 			if (size == 0) {
-				throw std::out_of_range("Vector is empty");
+				detail::throw_out_of_range("Vector is empty");
 			}
-			if (--size == 0) { free(data); data = (T*)calloc(1, sizeof(T)); capacity = 1; }
+			--size;
+			apply_shrink_policy();
 		}
 
 		/*************************************************************************************
@@ -401,88 +555,67 @@ namespace raw {
 		 * Throws: std::out_of_range, std::bad_alloc.
 		 *************************************************************************************/
 
-		void insert(size_t index, const T& value) override {
-			if (index > size) {
-				throw std::out_of_range("Index out of range");
-			}
-			if (size == capacity) {
-				normalize_capacity();
-			}
-			std::memmove(data + index + 1, data + index, (size - index) * sizeof(T));
-			data[index] = value;
-			++size;
+		RAW_CONSTEXPR20 void insert(size_t index, const T& value) override {
+			detail::raise_if(try_insert(index, value), (size + 1) * sizeof(T));
 		}
 
-		void insert(size_t index, T&& value) override {
-			if (index > size || index < 0) {
-				throw std::out_of_range("Index out of range");
-			}
-			if (size == capacity) {
-				normalize_capacity();
-			}
-			std::memmove(data + index + 1, data + index, (size - index) * sizeof(T));
-			data[index] = std::move(value);
-			++size;
+		RAW_CONSTEXPR20 void insert(size_t index, T&& value) override {
+			detail::raise_if(try_insert(index, value), (size + 1) * sizeof(T));
 		}
 
-		Iterator insert(Iterator pos, const T& value) override {
+		RAW_CONSTEXPR20 Iterator insert(Iterator pos, const T& value) override {
 			size_t insert_index = pos - Iterator(data);
-
-			if (insert_index > size) {
-				throw std::out_of_range("Index out of range");
-			}
-			if (size == capacity) {
-				auto newData = normalize_capacity();
-			}
-			std::memmove(data + insert_index + 1, data + insert_index, (size - insert_index) * sizeof(T));
-			data[insert_index] = value;
-			++size;
+			detail::raise_if(try_insert(insert_index, value), (size + 1) * sizeof(T));
 			return Iterator(data + insert_index);
 		}
 
-		Iterator insert(Iterator pos, T&& value) override {
+		RAW_CONSTEXPR20 Iterator insert(Iterator pos, T&& value) override {
 			size_t insert_index = pos - Iterator(data);
-
-			if (insert_index > size) {
-				throw std::out_of_range("Index out of range");
-			}
-			if (size == capacity) {
-				auto newData = normalize_capacity();
-			}
-			std::memmove(data + insert_index + 1, data + insert_index, (size - insert_index) * sizeof(T));
-			data[insert_index] = std::move(value);
-			++size;
+			detail::raise_if(try_insert(insert_index, value), (size + 1) * sizeof(T));
 			return Iterator(data + insert_index);
 		}
 
 		/*********************************************************************
-		 * ERASE FUNCTIONS: `erase()` overloads
+		 * ERASE FUNCTIONS: `erase()` overloads, `erase_unordered()`
 		 *
-		 * Erases element at given index/iterator.
-		 * Shifts subsequent elements.
-		 * Overloads for index and iterator position.
+		 * `erase()`           - erases element at given index/iterator and
+		 *                       shifts subsequent elements down.
+		 * `erase_unordered()` - copies the last element into `index`. O(1),
+		 *                       does not keep the order.
+		 * To remove many elements, use `raw::erase_if` (one pass).
 		 *
 		 * Throws: std::out_of_range.
 		 *********************************************************************/
 
-		void erase(size_t index) override {
+		RAW_CONSTEXPR20 void erase(size_t index) override {
 			if (index >= size || index < 0) {
-				throw std::out_of_range("Index out of range");
+				detail::throw_out_of_range("Index out of range");
 			}
-			std::memmove(data + index, data + index + 1, (size - index - 1) * sizeof(T));
+			detail::move_elements(data + index, data + index + 1, size - index - 1);
 			--size;
+			apply_shrink_policy();
 		}
 
-		Iterator erase(Iterator pos) override {
+		RAW_CONSTEXPR20 Iterator erase(Iterator pos) override {
 			size_t erase_index = pos - Iterator(data);
 			if (erase_index >= size || erase_index < 0) {
-				throw std::out_of_range("Index out of range");
+				detail::throw_out_of_range("Index out of range");
 			}
-			std::memmove(data + erase_index, data + erase_index + 1, (size - erase_index - 1) * sizeof(T));
+			detail::move_elements(data + erase_index, data + erase_index + 1, size - erase_index - 1);
 			--size;
+			apply_shrink_policy();
 			return Iterator(data + erase_index);
 		}
 
+		RAW_CONSTEXPR20 void erase_unordered(size_t index) override {
+			if (index >= size) {
+				detail::throw_out_of_range("Index out of range");
+			}
+			data[index] = data[size - 1];
+			--size;
+			apply_shrink_policy();
+		}
+
 		/************************************************************
 		 * SWAP FUNCTION: `swap(vector_base<T>& other) noexcept`
 		 *
@@ -490,10 +623,13 @@ namespace raw {
 		 * Fast, no memory operations.
 		 *************************************************************/
 
-		void swap(vector_base<T>& other) noexcept override {
+		RAW_CONSTEXPR20 void swap(vector_base<T>& other) noexcept override {
 			std::swap(data, other.data);
 			std::swap(size, other.size);
 			std::swap(capacity, other.capacity);
+			std::swap(this->deleter, other.deleter);
+			this->retrack();
+			other.retrack();
 		}
 
 		/*************************************************************************************
@@ -503,25 +639,28 @@ namespace raw {
 		 * New vector with copied data and capacity.
 		 *************************************************************************************/
 
-		vector_triv copy() {
+		RAW_CONSTEXPR20 vector_triv copy() {
 			vector_triv<T> new_vector(size);
 			new_vector.reserve(capacity);
-			std::memcpy(new_vector.data, data, size * sizeof(T));
+			detail::copy_elements(new_vector.data, data, size);
 			return new_vector;
 		}
 
 		/// CHECKS IF OBJECT IS EMPTY, IF SIZE VARIABLE ISN'T HANDELED GOOD ENOUGH, CAN CAUSE CRUSH
-		bool empty() { return size == 0; }
+		RAW_CONSTEXPR20 bool empty() { return size == 0; }
 
 		/*********************************************************************
 		 * DESTRUCTOR: `~vector_triv()`
 		 *
-		 * Prints destruction message (for debugging).
+		 * Prints destruction message when built with RAW_VECTOR_VERBOSE (for debugging).
 		 * Memory freeing handled in base class.
 		 *********************************************************************/
 
-		~vector_triv() override {
-			std::cout << "vector_triv Object Destroyed next comes memory freeing" << std::endl;
+		RAW_CONSTEXPR20 ~vector_triv() override {
+#ifdef RAW_VECTOR_VERBOSE
+			if (!detail::is_constant_evaluated())
+				std::cout << "vector_triv Object Destroyed next comes memory freeing" << std::endl;
+#endif
 		}
 	};
 }
\ No newline at end of file
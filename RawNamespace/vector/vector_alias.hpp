@@ -1,10 +1,12 @@
 #pragma once
 #include <type_traits>
-#include "RawNamespace\vector\trivial_check.hpp"
-#include "RawNamespace\RawBase.hpp"
-#include "RawNamespace\vector\RawVector.hpp"
-#include "RawNamespace\vector\trivial\RawVectorTriv.hpp"
-#include "RawNamespace\vector\non-trvivial\RawVectorNonTriv.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/RawVector.hpp"
+#include "RawNamespace/vector/trivial/RawVectorTriv.hpp"
+#include "RawNamespace/vector/non-trvivial/RawVectorNonTriv.hpp"
+#include "RawNamespace/vector/freeze.hpp"
+#include "RawNamespace/vector/erase.hpp"
 
 namespace raw {
 	/*********************************************************************
@@ -15,4 +17,24 @@ namespace raw {
 	 *********************************************************************/
 	template <typename T>
 	using vector = std::conditional_t<myis_trivial<T>::value, vector_triv<T>, vector_non_triv<T>>;
-}
\ No newline at end of file
+
+	/*********************************************************************
+	 * TAGGED VECTOR: `tagged_vector<T, Tag>`
+	 *
+	 * `raw::vector<T>` whose allocations are accounted under `Tag::name`:
+	 *     struct index_tag { static constexpr const char* name = "index"; };
+	 *     raw::tagged_vector<int, index_tag> v;
+	 * Same object as `raw::vector<T>` when profiling is disabled.
+	 *********************************************************************/
+	template <typename T, typename Tag>
+	class tagged_vector : public vector<T> {
+	public:
+		static alloc_tag tag() {
+			static alloc_tag instance(Tag::name);
+			return instance;
+		}
+
+		tagged_vector() : vector<T>(tag()) {}
+		explicit tagged_vector(size_t size_) : vector<T>(size_, tag()) {}
+	};
+}
@@ -0,0 +1,566 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include "RawNamespace/RawErrors.hpp"
+#include "RawNamespace/RawBase.hpp"
+#include "RawNamespace/vector/trivial_check.hpp"
+#include "RawNamespace/vector/memory_ops.hpp"
+#include "RawNamespace/vector/RawVector.hpp"
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#define RAW_HAS_VM_VECTOR 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define RAW_HAS_VM_VECTOR 1
+#endif
+
+/************************************************************************
+* raw::vm_vector<T> - vector_triv that never moves its elements.
+*
+* The first growth reserves one contiguous range of address space
+* (`PROT_NONE`, no memory behind it) big enough for the vector's whole
+* life. Growing only changes page protections at the end of the
+* committed prefix:
+*
+*     [ committed, read/write | reserved, PROT_NONE ............ ]
+*       ^ data                 ^ data + capacity     ^ data + get_reserved_size()
+*
+* so `data` never changes, no element is ever copied by growth, and
+* pointers and references stay valid until the element is erased or the
+* vector is released or destroyed. Commits are rounded to whole pages and
+* grow by doubling (at least 64 KiB), so push_back makes O(log n)
+* system calls. `shrink_to_fit()` and `trim()` hand the pages past the
+* last element back to the OS (`madvise` + `PROT_NONE`); `clear()` keeps
+* them, like vector_triv.
+*
+* The reservation costs address space only: 64 GiB by default on 64-bit
+* targets, set per vector with `vm_reservation`. Going past it raises
+* std::length_error instead of relocating.
+*
+* The interface is vector_triv's, so a raw::vector<T> can be swapped for
+* a vm_vector<T>. A `shrink_policy` decommits pages instead of moving
+* to a smaller buffer. `alloc_tag` is accepted but not accounted: the
+* profiler tracks heap buffers, and these pages never come from malloc.
+*
+* POSIX uses mmap / mprotect / madvise, Windows VirtualAlloc with
+* MEM_RESERVE / MEM_COMMIT / MEM_DECOMMIT.
+***********************************************************************/
+
+#ifdef RAW_HAS_VM_VECTOR
+namespace raw {
+	/*********************************************************************
+	 * STRUCT: `vm_reservation`
+	 *
+	 * Address space a vm_vector reserves, in bytes (rounded up to pages).
+	 *     raw::vm_vector<float> v(raw::vm_reservation{ size_t(256) << 30 });
+	 *********************************************************************/
+	struct vm_reservation {
+		size_t bytes = sizeof(void*) >= 8 ? size_t(64) << 30 : size_t(256) << 20;
+	};
+
+	namespace detail {
+		/*********************************************************************
+		 * HELPER FUNCTIONS: `vm_page_size()`, `vm_reserve()`, `vm_commit()`,
+		 *                   `vm_decommit()`, `vm_release()`
+		 *
+		 * `vm_reserve(bytes)`     - inaccessible range, nullptr on failure.
+		 * `vm_commit(p, bytes)`   - makes `[p, p + bytes)` readable and writable.
+		 * `vm_prefer_huge(p, bytes)` - transparent huge page hint, where supported.
+		 * `vm_decommit(p, bytes)` - drops the pages' contents and access;
+		 *                           the range stays reserved.
+		 * `vm_release(p, bytes)`  - returns the whole reservation.
+		 * Addresses and sizes passed in are page aligned.
+		 *********************************************************************/
+		inline size_t vm_page_size() noexcept {
+			static const size_t page = [] {
+#if defined(_WIN32)
+				SYSTEM_INFO info;
+				GetSystemInfo(&info);
+				return static_cast<size_t>(info.dwPageSize);
+#else
+				long p = ::sysconf(_SC_PAGESIZE);
+				return p > 0 ? static_cast<size_t>(p) : size_t(4096);
+#endif
+			}();
+			return page;
+		}
+
+		inline void* vm_reserve(size_t bytes) noexcept {
+#if defined(_WIN32)
+			return VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+#else
+			int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+			flags |= MAP_NORESERVE;
+#endif
+			void* p = ::mmap(nullptr, bytes, PROT_NONE, flags, -1, 0);
+			return p == MAP_FAILED ? nullptr : p;
+#endif
+		}
+
+		inline bool vm_commit(void* p, size_t bytes) noexcept {
+#if defined(_WIN32)
+			return VirtualAlloc(p, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+			return ::mprotect(p, bytes, PROT_READ | PROT_WRITE) == 0;
+#endif
+		}
+
+		/// Asks for transparent huge pages on a large committed block (fewer faults and TLB misses).
+		inline void vm_prefer_huge(void* p, size_t bytes) noexcept {
+#if defined(MADV_HUGEPAGE)
+			::madvise(p, bytes, MADV_HUGEPAGE);
+#else
+			(void)p;
+			(void)bytes;
+#endif
+		}
+
+		inline void vm_decommit(void* p, size_t bytes) noexcept {
+#if defined(_WIN32)
+			VirtualFree(p, bytes, MEM_DECOMMIT);
+#else
+#if defined(MADV_DONTNEED)
+			::madvise(p, bytes, MADV_DONTNEED);
+#endif
+			::mprotect(p, bytes, PROT_NONE);
+#endif
+		}
+
+		inline void vm_release(void* p, size_t bytes) noexcept {
+#if defined(_WIN32)
+			(void)bytes;
+			VirtualFree(p, 0, MEM_RELEASE);
+#else
+			::munmap(p, bytes);
+#endif
+		}
+
+		inline size_t vm_round_up(size_t bytes, size_t page) noexcept {
+			return (bytes + page - 1) / page * page;
+		}
+	}
+
+	template<typename T>
+	class vm_vector {
+		static_assert(myis_trivial<T>::value, "raw::vm_vector holds trivially copyable, trivially destructible types");
+	private:
+
+		/*************************************************************************************************
+		 * PRIVATE MEMBERS:
+		 *
+		 * `data`           - Start of the reservation, nullptr until the first growth. Never moves.
+		 * `size`           - Number of elements.
+		 * `capacity`       - Elements that fit in the committed pages.
+		 * `committed`      - Committed bytes, a whole number of pages.
+		 * `reserved_bytes` - Size of the reservation (made on first growth), a whole number of pages.
+		 * `policy`         - When shrinking sizes decommit pages, see `shrink_policy`.
+		 *************************************************************************************************/
+		T* data = nullptr;
+		size_t size = 0;
+		size_t capacity = 0;
+		size_t committed = 0;
+		size_t reserved_bytes = 0;
+		shrink_policy policy;
+
+		/// Smallest commit step, so small vectors do not pay one system call per page.
+		static constexpr size_t min_commit = 64 * 1024;
+		/// Commits at least this large are offered transparent huge pages.
+		static constexpr size_t huge_commit = 4 * 1024 * 1024;
+
+		/*************************************************************************************
+		 * PRIVATE FUNCTIONS: `try_commit()`, `decommit_to()`
+		 *
+		 * `try_commit(required)`  - makes `capacity >= required`, reserving the range first
+		 *                           if needed. Commits max(twice the committed bytes,
+		 *                           64 KiB, what `required` needs), capped at the reservation.
+		 *                           Blocks of 4 MiB or more get the huge page hint.
+		 * `decommit_to(elements)` - returns the pages wholly past `elements` to the OS.
+		 * `apply_shrink_policy()` - after the size dropped: decommits down to
+		 *                           max(2 * size, min_capacity) once the policy says so.
+		 *************************************************************************************/
+
+		status try_commit(size_t required) noexcept {
+			if (RAW_LIKELY(required <= capacity))
+				return status::ok;
+			if (required > get_reserved_size())
+				return status::length_error;
+			if (!data) {
+				void* range = detail::vm_reserve(reserved_bytes);
+				if (!range)
+					return status::out_of_memory;
+				data = static_cast<T*>(range);
+			}
+			const size_t page = detail::vm_page_size();
+			size_t target = committed > min_commit / 2 ? committed * 2 : min_commit;
+			if (target < required * sizeof(T))
+				target = required * sizeof(T);
+			target = detail::vm_round_up(target, page);
+			if (target > reserved_bytes)
+				target = reserved_bytes;
+			char* grown = reinterpret_cast<char*>(data) + committed;
+			if (!detail::vm_commit(grown, target - committed))
+				return status::out_of_memory;
+			if (target - committed >= huge_commit)
+				detail::vm_prefer_huge(grown, target - committed);
+			committed = target;
+			capacity = committed / sizeof(T);
+			return status::ok;
+		}
+
+		void decommit_to(size_t elements) noexcept {
+			if (!data)
+				return;
+			const size_t keep = detail::vm_round_up(elements * sizeof(T), detail::vm_page_size());
+			if (keep >= committed)
+				return;
+			detail::vm_decommit(reinterpret_cast<char*>(data) + keep, committed - keep);
+			committed = keep;
+			capacity = committed / sizeof(T);
+		}
+
+		void apply_shrink_policy() noexcept {
+			if (RAW_LIKELY(policy.shrink_divisor == 0) || size >= capacity / policy.shrink_divisor)
+				return;
+			size_t target = size * 2;
+			if (target < policy.min_capacity)
+				target = policy.min_capacity;
+			decommit_to(target);
+		}
+
+		void unmap() noexcept {
+			if (data)
+				detail::vm_release(data, reserved_bytes);
+			data = nullptr;
+			size = capacity = committed = 0;
+		}
+
+	public:
+		using value_type = T;
+		using Iterator = typename vector_base<T>::template IteratorBase<T>;
+		using const_iterator = typename vector_base<T>::template IteratorBase<const T>;
+		using reverse_iterator = std::reverse_iterator<Iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		/*********************************************************************
+		 * CONSTRUCTORS: `vm_vector()`, `vm_vector(size_t size_)`, with or
+		 *               without a `vm_reservation` or an `alloc_tag`
+		 *
+		 * Nothing is reserved or committed until the first growth.
+		 * `vm_vector(size_)` starts with `size_` zeroed elements. The
+		 * `alloc_tag` overloads exist for vector_triv compatibility; the tag
+		 * is ignored.
+		 *
+		 * Throws: std::bad_alloc if the range cannot be reserved or committed,
+		 *         std::length_error if `size_` does not fit the reservation.
+		 *********************************************************************/
+
+		vm_vector() noexcept : vm_vector(vm_reservation()) {}
+
+		explicit vm_vector(vm_reservation reservation) noexcept
+			: reserved_bytes(detail::vm_round_up(reservation.bytes ? reservation.bytes : 1, detail::vm_page_size())) {}
+
+		explicit vm_vector(alloc_tag) noexcept : vm_vector(vm_reservation()) {}
+
+		explicit vm_vector(size_t size_, vm_reservation reservation = vm_reservation()) : vm_vector(reservation) {
+			resize(size_);
+		}
+
+		vm_vector(size_t size_, alloc_tag) : vm_vector(size_, vm_reservation()) {}
+
+		/*********************************************************************
+		 * COPY / MOVE: constructors and assignment
+		 *
+		 * A copy gets its own reservation of the same size and commits only
+		 * what the elements need. A move takes the range over, so pointers
+		 * into `other` now point into this vector; `other` is left empty
+		 * with nothing reserved. Construction inherits the shrink policy,
+		 * assignment keeps the target's own.
+		 *
+		 * Throws: std::bad_alloc (copy).
+		 *********************************************************************/
+
+		vm_vector(const vm_vector& other) : reserved_bytes(other.reserved_bytes), policy(other.policy) {
+			if (!other.size)
+				return;
+			detail::raise_if(try_commit(other.size), other.size * sizeof(T));
+			std::memcpy(static_cast<void*>(data), static_cast<const void*>(other.data), other.size * sizeof(T));
+			size = other.size;
+		}
+
+		vm_vector(vm_vector&& other) noexcept
+			: data(other.data), size(other.size), capacity(other.capacity),
+			  committed(other.committed), reserved_bytes(other.reserved_bytes), policy(other.policy) {
+			other.data = nullptr;
+			other.size = other.capacity = other.committed = 0;
+		}
+
+		vm_vector& operator=(const vm_vector& other) {
+			if (this != &other) {
+				vm_vector copy(other);
+				swap(copy);
+			}
+			return *this;
+		}
+
+		vm_vector& operator=(vm_vector&& other) noexcept {
+			if (this != &other) {
+				vm_vector stolen(std::move(other));
+				swap(stolen);
+			}
+			return *this;
+		}
+
+		~vm_vector() { unmap(); }
+
+		/*********************************************************************
+		 * GETTER FUNCTIONS: `get_size()`, `get_capacity()`, `max_size()`,
+		 *                   `get_reserved_size()`, `get_reserved_bytes()`,
+		 *                   `get_data()`, `empty()`
+		 *
+		 * `get_capacity()` counts committed elements, `get_reserved_size()`
+		 * the elements this vector's reservation can ever hold. `max_size()`
+		 * is vector_triv's static bound, the limit for any reservation.
+		 *********************************************************************/
+
+		size_t get_size() const noexcept { return size; }
+		size_t get_capacity() const noexcept { return capacity; }
+		static constexpr size_t max_size() noexcept {
+			return size_t(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(T);
+		}
+		size_t get_reserved_size() const noexcept { return reserved_bytes / sizeof(T); }
+		size_t get_reserved_bytes() const noexcept { return reserved_bytes; }
+		T* get_data() noexcept { return data; }
+		const T* get_data() const noexcept { return data; }
+		bool empty() const noexcept { return size == 0; }
+
+		/*********************************************************************
+		 * INDEXING FUNCTIONS: `at()`, `operator[]`, `front()`, `back()`
+		 *
+		 * `at()` - with bounds checking, throws `std::out_of_range`.
+		 * The rest do no checking.
+		 *********************************************************************/
+
+		T& at(size_t index) {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			return data[index];
+		}
+
+		const T& at(size_t index) const {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			return data[index];
+		}
+
+		T& operator [] (size_t index) noexcept { return data[index]; }
+		const T& operator [] (size_t index) const noexcept { return data[index]; }
+		T& front() noexcept { return data[0]; }
+		const T& front() const noexcept { return data[0]; }
+		T& back() noexcept { return data[size - 1]; }
+		const T& back() const noexcept { return data[size - 1]; }
+
+		/*********************************************************************
+		 * PUSH_BACK FUNCTIONS: `push_back(elem)`, `try_push_back(elem)`
+		 *
+		 * Appends `elem`; commits more pages when the committed ones are
+		 * full. `elem` may refer into this vector: nothing ever moves.
+		 *
+		 * Throws: std::bad_alloc if pages cannot be committed,
+		 *         std::length_error when the reservation is full.
+		 *********************************************************************/
+
+		void push_back(const T& elem) {
+			if (RAW_UNLIKELY(size >= capacity))
+				detail::raise_if(try_commit(size + 1), (size + 1) * sizeof(T));
+			detail::put(data + size, elem);
+			++size;
+		}
+
+		status try_push_back(const T& elem) noexcept {
+			status result = try_commit(size + 1);
+			if (result != status::ok)
+				return result;
+			detail::put(data + size, elem);
+			++size;
+			return status::ok;
+		}
+
+		/*********************************************************************
+		 * SIZE FUNCTIONS: `resize()`, `reserve()`, `try_resize()`, `try_reserve()`,
+		 *                 `clear()`, `pop_back()`
+		 *
+		 * `resize()` zeroes new elements. `reserve()` commits pages up front.
+		 * Shrinking keeps the committed pages unless the shrink policy
+		 * decommits them.
+		 *
+		 * Throws: std::bad_alloc, std::length_error; `pop_back()` throws
+		 *         std::out_of_range when empty.
+		 *********************************************************************/
+
+		status try_resize(size_t new_size) noexcept {
+			if (new_size > size) {
+				status result = try_commit(new_size);
+				if (result != status::ok)
+					return result;
+				detail::zero_elements(data + size, new_size - size);
+			}
+			size = new_size;
+			apply_shrink_policy();
+			return status::ok;
+		}
+
+		status try_reserve(size_t reserve_size) noexcept { return try_commit(reserve_size); }
+
+		void resize(size_t new_size) { detail::raise_if(try_resize(new_size), new_size * sizeof(T)); }
+		void reserve(size_t reserve_size) { detail::raise_if(try_reserve(reserve_size), reserve_size * sizeof(T)); }
+		void clear() noexcept {
+			size = 0;
+			apply_shrink_policy();
+		}
+
+		void pop_back() {
+			if (size == 0)
+				detail::throw_out_of_range("Vector is empty");
+			--size;
+			apply_shrink_policy();
+		}
+
+		/*********************************************************************
+		 * SHRINK POLICY: `set_shrink_policy()`, `get_shrink_policy()`
+		 *
+		 * As in vector_triv, except that shrinking decommits pages in place.
+		 *********************************************************************/
+		void set_shrink_policy(shrink_policy new_policy) noexcept { policy = new_policy; }
+		shrink_policy get_shrink_policy() const noexcept { return policy; }
+
+		/*********************************************************************
+		 * ALLOCATION TAG: `get_alloc_tag()`
+		 *
+		 * Always the untagged default (see the constructors).
+		 *********************************************************************/
+		alloc_tag get_alloc_tag() const { return alloc_tag(); }
+
+		/*********************************************************************
+		 * MEMORY RETURN: `shrink_to_fit()`, `trim()`, `release()`
+		 *
+		 * `shrink_to_fit()`, `trim()` - decommit the pages past the last
+		 *                               element; `data` stays where it is.
+		 * `release()`                 - drops the elements and the whole
+		 *                               reservation; the next growth reserves
+		 *                               a new range (at a new address).
+		 *********************************************************************/
+
+		void shrink_to_fit() noexcept { decommit_to(size); }
+		void trim() noexcept { decommit_to(size); }
+		void release() noexcept { unmap(); }
+
+		/*********************************************************************
+		 * INSERT / ERASE FUNCTIONS: `insert()`, `try_insert()`, `erase()`,
+		 *                           `erase_unordered()`
+		 *
+		 * Same contracts as vector_triv: insert shifts the tail up, erase
+		 * shifts it down, erase_unordered moves the last element in.
+		 *
+		 * Throws: std::out_of_range, std::bad_alloc, std::length_error.
+		 *********************************************************************/
+
+		status try_insert(size_t index, const T& value) noexcept {
+			if (index > size)
+				return status::out_of_range;
+			T copy = value;
+			status result = try_commit(size + 1);
+			if (result != status::ok)
+				return result;
+			detail::move_elements(data + index + 1, data + index, size - index);
+			detail::put(data + index, copy);
+			++size;
+			return status::ok;
+		}
+
+		void insert(size_t index, const T& value) {
+			detail::raise_if(try_insert(index, value), (size + 1) * sizeof(T));
+		}
+
+		Iterator insert(Iterator pos, const T& value) {
+			size_t index = static_cast<size_t>(pos - begin());
+			insert(index, value);
+			return Iterator(data + index);
+		}
+
+		void erase(size_t index) {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			detail::move_elements(data + index, data + index + 1, size - index - 1);
+			--size;
+			apply_shrink_policy();
+		}
+
+		Iterator erase(Iterator pos) {
+			size_t index = static_cast<size_t>(pos - begin());
+			erase(index);
+			return Iterator(data + index);
+		}
+
+		void erase_unordered(size_t index) {
+			if (index >= size)
+				detail::throw_out_of_range("Index out of range");
+			data[index] = data[size - 1];
+			--size;
+			apply_shrink_policy();
+		}
+
+		/*********************************************************************
+		 * SPARE CAPACITY: `spare_capacity()`, `spare_data()`, `reserve_spare(n)`,
+		 *                 `try_reserve_spare(n)`, `commit_spare(n)`
+		 *
+		 * As in vector_triv.
+		 *********************************************************************/
+
+		size_t spare_capacity() const noexcept { return capacity - size; }
+		T* spare_data() noexcept { return data + size; }
+
+		status try_reserve_spare(size_t n) noexcept {
+			if (n > get_reserved_size() - size)
+				return status::length_error;
+			return try_commit(size + n);
+		}
+
+		void reserve_spare(size_t n) { detail::raise_if(try_reserve_spare(n), (size + n) * sizeof(T)); }
+		void commit_spare(size_t n) noexcept { size += n; }
+
+		void swap(vm_vector& other) noexcept {
+			std::swap(data, other.data);
+			std::swap(size, other.size);
+			std::swap(capacity, other.capacity);
+			std::swap(committed, other.committed);
+			std::swap(reserved_bytes, other.reserved_bytes);
+		}
+
+		/*********************************************************************
+		 * ITERATORS: the same contiguous iterators as raw::vector
+		 *********************************************************************/
+
+		Iterator begin() noexcept { return Iterator(data); }
+		Iterator end() noexcept { return Iterator(data + size); }
+		const_iterator begin() const noexcept { return const_iterator(data); }
+		const_iterator end() const noexcept { return const_iterator(data + size); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		const_iterator cend() const noexcept { return end(); }
+		reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+		reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+	};
+}
+#endif
@@ -0,0 +1,138 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/************************************************************************
+* Minimal benchmark harness for the raw containers.
+*
+* Every bench_*.cpp registers its cases with a static `bench::registrar`;
+* main.cpp runs them over the requested sizes and writes CSV/JSON.
+* A case is a function taking `bench::state&` and looping on `keep_running()`:
+*
+*     while (st.keep_running()) {
+*         ... timed work ...
+*         st.pause();  ... untimed setup/cleanup ...  st.resume();
+*     }
+*     st.set_items_per_iteration(n);
+***********************************************************************/
+
+namespace bench {
+	/*********************************************************************
+	 * CLASS: `state`
+	 *
+	 * Per run timer. Iterates until `min_time` seconds of timed work
+	 * (paused sections excluded) were accumulated, at least once.
+	 *********************************************************************/
+	class state {
+	private:
+		using clock = std::chrono::steady_clock;
+
+		double min_time;
+		double accumulated = 0.0;
+		clock::time_point segment_start;
+		bool started = false;
+		bool running = false;
+		size_t iterations = 0;
+		size_t items_per_iteration = 1;
+
+	public:
+		const size_t size;
+
+		state(size_t size_, double min_time_) : min_time(min_time_), size(size_) {}
+
+		bool keep_running() {
+			if (!started) {
+				started = true;
+				resume();
+				return true;
+			}
+			++iterations;
+			bool was_running = running;
+			if (was_running) pause();
+			if (accumulated >= min_time) return false;
+			if (was_running) resume();
+			return true;
+		}
+
+		void pause() {
+			if (!running) return;
+			accumulated += std::chrono::duration<double>(clock::now() - segment_start).count();
+			running = false;
+		}
+
+		void resume() {
+			if (running) return;
+			running = true;
+			segment_start = clock::now();
+		}
+
+		/// Number of operations one iteration performs; results are reported per operation.
+		void set_items_per_iteration(size_t items) { items_per_iteration = items ? items : 1; }
+
+		size_t get_iterations() const { return iterations; }
+		double seconds() const { return accumulated; }
+		double ns_per_item() const {
+			return iterations ? accumulated * 1e9 / (double(iterations) * double(items_per_iteration)) : 0.0;
+		}
+	};
+
+	/*********************************************************************
+	 * STRUCT: `entry`
+	 *
+	 * One registered case. `impl` is the container family ("raw", "std"),
+	 * `type` the element type label. An empty `sizes` list means the
+	 * default size ladder from main.cpp.
+	 *********************************************************************/
+	struct entry {
+		std::string suite;
+		std::string name;
+		std::string impl;
+		std::string type;
+		std::function<void(state&)> fn;
+		std::vector<size_t> sizes;
+	};
+
+	inline std::vector<entry>& registry() {
+		static std::vector<entry> entries;
+		return entries;
+	}
+
+	struct registrar {
+		explicit registrar(std::function<void()> register_fn) { register_fn(); }
+	};
+
+	inline void add(std::string suite, std::string name, std::string impl, std::string type,
+		std::function<void(state&)> fn, std::vector<size_t> sizes = {}) {
+		registry().push_back(entry{ std::move(suite), std::move(name), std::move(impl), std::move(type), std::move(fn), std::move(sizes) });
+	}
+
+	/// Keeps the compiler from discarding a computed value.
+	template<typename T>
+	inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	/// Fixed seed xorshift, so every run sees the same data.
+	class rng {
+	private:
+		uint64_t s;
+	public:
+		explicit rng(uint64_t seed = 0x9E3779B97F4A7C15ull) : s(seed ? seed : 1) {}
+		uint64_t next() {
+			s ^= s << 13;
+			s ^= s >> 7;
+			s ^= s << 17;
+			return s;
+		}
+	};
+}
@@ -0,0 +1,83 @@
+#include "bench.hpp"
+#include "RawNamespace/vector/std_interop.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/************************************************************************
+* Handing `n`-element uint32 buffers between stages.
+*
+* `ingest` - a malloc'd buffer from a C decoder into a raw::vector
+*            (filling the buffer is untimed).
+*   `push_back` - element by element, then free the source.
+*   `memcpy`    - reserve + one copy, then free the source.
+*   `adopt`     - take the buffer.
+* `to_std` - a filled raw::vector into a std::vector and back.
+*   `copy`    - std::vector<uint32_t>(begin, end), then raw::from_std_vector(copy).
+*   `handoff` - raw::to_std_vector (one copy), then raw::from_std_vector
+*               on the malloc_vector (O(1)).
+* Costs per element; only `adopt` and the way back of `handoff` are
+* O(1) per buffer.
+***********************************************************************/
+
+namespace {
+	uint32_t* decoded_buffer(size_t n) {
+		uint32_t* p = static_cast<uint32_t*>(std::malloc(n * sizeof(uint32_t)));
+		for (size_t i = 0; i < n; ++i)
+			p[i] = static_cast<uint32_t>(i * 2654435761u);
+		return p;
+	}
+
+	enum class ingest { push_back, memcpy, adopt };
+
+	template<ingest I>
+	void bm_ingest(bench::state& st) {
+		while (st.keep_running()) {
+			st.pause();
+			uint32_t* source = decoded_buffer(st.size);
+			st.resume();
+			raw::vector<uint32_t> v;
+			if constexpr (I == ingest::push_back) {
+				for (size_t i = 0; i < st.size; ++i)
+					v.push_back(source[i]);
+				std::free(source);
+			}
+			else if constexpr (I == ingest::memcpy) {
+				v.resize(st.size);
+				std::memcpy(v.get_data(), source, st.size * sizeof(uint32_t));
+				std::free(source);
+			}
+			else
+				v.adopt(source, st.size, st.size);
+			bench::do_not_optimize(v);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<bool Handoff>
+	void bm_to_std(bench::state& st) {
+		raw::vector<uint32_t> v;
+		v.adopt(decoded_buffer(st.size), st.size, st.size);
+		while (st.keep_running()) {
+			if constexpr (Handoff) {
+				raw::malloc_vector<uint32_t> std_side = raw::to_std_vector(std::move(v));
+				bench::do_not_optimize(std_side);
+				v = raw::from_std_vector(std::move(std_side));
+			}
+			else {
+				std::vector<uint32_t> std_side(v.begin(), v.end());
+				bench::do_not_optimize(std_side);
+				v = raw::from_std_vector(std_side);
+			}
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	bench::registrar adopt_benchmarks([] {
+		bench::add("adopt", "ingest", "push_back", "uint32", bm_ingest<ingest::push_back>);
+		bench::add("adopt", "ingest", "memcpy", "uint32", bm_ingest<ingest::memcpy>);
+		bench::add("adopt", "ingest", "adopt", "uint32", bm_ingest<ingest::adopt>);
+		bench::add("adopt", "to_std", "copy", "uint32", bm_to_std<false>);
+		bench::add("adopt", "to_std", "handoff", "uint32", bm_to_std<true>);
+	});
+}
@@ -0,0 +1,99 @@
+#include "bench.hpp"
+#include "RawNamespace/heap/RawDaryHeap.hpp"
+#include <functional>
+#include <queue>
+#include <vector>
+
+/************************************************************************
+* raw::dary_heap (D = 2, 4, 8) vs std::priority_queue, as min-heaps of
+* uint64 timestamps like a scheduler's event queue.
+*
+* `build`    - `n` random keys, bulk (push_range vs the range constructor).
+* `push_pop` - `n` pushes then `n` pops.
+* `hold`     - steady state on an `n`-element heap: take the earliest
+*              event, schedule one a random delay later (pop_push vs
+*              pop + push). `n` operations per iteration.
+* Run with `--max-size 100M` for the out-of-cache end.
+***********************************************************************/
+
+namespace {
+	using min_first = std::greater<uint64_t>;
+	using std_queue = std::priority_queue<uint64_t, std::vector<uint64_t>, min_first>;
+	template<size_t D> using raw_heap = raw::dary_heap<uint64_t, D, min_first>;
+
+	std::vector<uint64_t> make_keys(size_t n) {
+		bench::rng rng(45);
+		std::vector<uint64_t> keys(n);
+		for (auto& key : keys)
+			key = rng.next() >> 20;
+		return keys;
+	}
+
+	template<typename Q>
+	void push_all(Q& q, const std::vector<uint64_t>& keys) {
+		if constexpr (std::is_same<Q, std_queue>::value) q = std_queue(min_first(), keys);
+		else q.push_range(keys);
+	}
+
+	template<typename Q>
+	void bm_build(bench::state& st) {
+		const std::vector<uint64_t> keys = make_keys(st.size);
+		while (st.keep_running()) {
+			Q q;
+			push_all(q, keys);
+			bench::do_not_optimize(q);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename Q>
+	void bm_push_pop(bench::state& st) {
+		const std::vector<uint64_t> keys = make_keys(st.size);
+		Q q;
+		while (st.keep_running()) {
+			for (uint64_t key : keys)
+				q.push(key);
+			uint64_t sum = 0;
+			while (!q.empty()) {
+				sum += q.top();
+				q.pop();
+			}
+			bench::do_not_optimize(sum);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename Q>
+	void bm_hold(bench::state& st) {
+		Q q;
+		push_all(q, make_keys(st.size));
+		bench::rng rng(46);
+		while (st.keep_running()) {
+			for (size_t i = 0; i < st.size; ++i) {
+				const uint64_t next = q.top() + (rng.next() >> 40);
+				if constexpr (std::is_same<Q, std_queue>::value) {
+					q.pop();
+					q.push(next);
+				}
+				else
+					q.replace_top(next);
+			}
+			bench::do_not_optimize(q.top());
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename Q>
+	void add_heap_cases(const char* impl) {
+		bench::add("dary_heap", "build", impl, "uint64", bm_build<Q>);
+		bench::add("dary_heap", "push_pop", impl, "uint64", bm_push_pop<Q>);
+		bench::add("dary_heap", "hold", impl, "uint64", bm_hold<Q>);
+	}
+
+	bench::registrar dary_heap_benchmarks([] {
+		add_heap_cases<std_queue>("std_priority_queue");
+		add_heap_cases<raw_heap<2>>("raw_d2");
+		add_heap_cases<raw_heap<4>>("raw_d4");
+		add_heap_cases<raw_heap<8>>("raw_d8");
+	});
+}
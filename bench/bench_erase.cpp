@@ -0,0 +1,93 @@
+#include "bench.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/************************************************************************
+* raw::erase_if vs std::remove_if + erase on std::vector.
+*
+* `remove_10` / `remove_50` - a random 10% / 50% of the elements match
+* the predicate; at 50% a branchy filter mispredicts every other element.
+* Strings are short enough for SSO. Each iteration refills the vector
+* untimed; small sizes cycle through several inputs.
+***********************************************************************/
+
+namespace {
+	template<typename T> T make_value(uint64_t bits);
+	template<> uint32_t make_value<uint32_t>(uint64_t bits) { return static_cast<uint32_t>(bits); }
+	template<> uint64_t make_value<uint64_t>(uint64_t bits) { return bits; }
+	template<> std::string make_value<std::string>(uint64_t bits) { return std::to_string(bits >> 32); }
+
+	template<typename T>
+	std::vector<T> make_values(size_t n) {
+		bench::rng rng(41);
+		std::vector<T> values;
+		values.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+			values.push_back(make_value<T>(rng.next() >> 8));
+		return values;
+	}
+
+	/// Numbers match if their value mod 100 is below `Percent`, strings by their last digit.
+	template<typename T, unsigned Percent>
+	bool matches(const T& x) {
+		if constexpr (std::is_same<T, std::string>::value) return unsigned(x.back() - '0') < Percent / 10;
+		else return x % 100 < Percent;
+	}
+
+	/// Sizes below 64K cycle through several inputs so the branch predictor cannot learn one.
+	size_t input_sets(size_t n) { return n < 65536 ? 65536 / n : 1; }
+
+	template<typename T, unsigned Percent>
+	void bm_raw_erase_if(bench::state& st) {
+		const size_t sets = input_sets(st.size);
+		const std::vector<T> values = make_values<T>(st.size * sets);
+		raw::vector<T> v;
+		v.reserve(st.size);
+		size_t next = 0;
+		while (st.keep_running()) {
+			st.pause();
+			v.clear();
+			for (size_t i = 0; i < st.size; ++i) v.push_back(values[next * st.size + i]);
+			next = next + 1 < sets ? next + 1 : 0;
+			st.resume();
+			raw::erase_if(v, [](const T& x) { return matches<T, Percent>(x); });
+			bench::do_not_optimize(v);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename T, unsigned Percent>
+	void bm_std_remove_if(bench::state& st) {
+		const size_t sets = input_sets(st.size);
+		const std::vector<T> values = make_values<T>(st.size * sets);
+		std::vector<T> v;
+		v.reserve(st.size);
+		size_t next = 0;
+		while (st.keep_running()) {
+			st.pause();
+			v.assign(values.begin() + next * st.size, values.begin() + (next + 1) * st.size);
+			next = next + 1 < sets ? next + 1 : 0;
+			st.resume();
+			v.erase(std::remove_if(v.begin(), v.end(), [](const T& x) { return matches<T, Percent>(x); }), v.end());
+			bench::do_not_optimize(v);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename T>
+	void add_erase_cases(const char* type) {
+		bench::add("erase_if", "remove_10", "raw", type, bm_raw_erase_if<T, 10>);
+		bench::add("erase_if", "remove_10", "std_remove_if", type, bm_std_remove_if<T, 10>);
+		bench::add("erase_if", "remove_50", "raw", type, bm_raw_erase_if<T, 50>);
+		bench::add("erase_if", "remove_50", "std_remove_if", type, bm_std_remove_if<T, 50>);
+	}
+
+	bench::registrar erase_benchmarks([] {
+		add_erase_cases<uint32_t>("uint32");
+		add_erase_cases<uint64_t>("uint64");
+		add_erase_cases<std::string>("string");
+	});
+}
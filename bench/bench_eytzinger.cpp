@@ -0,0 +1,83 @@
+#include "bench.hpp"
+#include "RawNamespace/search/RawEytzinger.hpp"
+#include <algorithm>
+#include <vector>
+
+/************************************************************************
+* raw::eytzinger_array vs std::lower_bound on a sorted std::vector.
+*
+* `lower_bound` - 64K random probes per iteration into `n` sorted random
+*                 keys; ns/op is per probe.
+*   `std_lower_bound` - binary search on the sorted vector.
+*   `raw`             - eytzinger_array::lower_bound, one probe at a time.
+*   `raw_batch`       - lower_bound_batch over all probes.
+* Sizes are 1M, 10M, 100M and 1G keys, all out of cache. The default
+* run stops at 1M; the full ladder needs --max-size 1G (and about
+* 8 GiB free for uint32, 16 GiB for uint64 at 1G):
+*     raw_bench --filter eytzinger --max-size 1G
+***********************************************************************/
+
+namespace {
+	constexpr size_t probe_count = 65536;
+	const std::vector<size_t> search_sizes = { 1000000, 10000000, 100000000, 1000000000 };
+
+	template<typename T>
+	std::vector<T> sorted_keys(size_t n) {
+		bench::rng rng(46);
+		std::vector<T> keys(n);
+		for (auto& key : keys)
+			key = static_cast<T>(rng.next());
+		std::sort(keys.begin(), keys.end());
+		return keys;
+	}
+
+	template<typename T>
+	std::vector<T> probes() {
+		bench::rng rng(47);
+		std::vector<T> out(probe_count);
+		for (auto& key : out)
+			key = static_cast<T>(rng.next());
+		return out;
+	}
+
+	enum class search { std_lower_bound, raw, raw_batch };
+
+	template<typename T, search S>
+	void bm_lower_bound(bench::state& st) {
+		const std::vector<T> keys = sorted_keys<T>(st.size);
+		const std::vector<T> queries = probes<T>();
+		std::vector<size_t> out(probe_count);
+		if constexpr (S == search::std_lower_bound) {
+			while (st.keep_running()) {
+				for (size_t i = 0; i < probe_count; ++i)
+					out[i] = static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), queries[i]) - keys.begin());
+				bench::do_not_optimize(out);
+			}
+		}
+		else {
+			const raw::eytzinger_array<T> array(keys);
+			while (st.keep_running()) {
+				if constexpr (S == search::raw) {
+					for (size_t i = 0; i < probe_count; ++i)
+						out[i] = array.lower_bound(queries[i]);
+				}
+				else
+					array.lower_bound_batch(queries, out);
+				bench::do_not_optimize(out);
+			}
+		}
+		st.set_items_per_iteration(probe_count);
+	}
+
+	template<typename T>
+	void add_search_cases(const char* type) {
+		bench::add("eytzinger", "lower_bound", "std_lower_bound", type, bm_lower_bound<T, search::std_lower_bound>, search_sizes);
+		bench::add("eytzinger", "lower_bound", "raw", type, bm_lower_bound<T, search::raw>, search_sizes);
+		bench::add("eytzinger", "lower_bound", "raw_batch", type, bm_lower_bound<T, search::raw_batch>, search_sizes);
+	}
+
+	bench::registrar eytzinger_benchmarks([] {
+		add_search_cases<uint32_t>("uint32");
+		add_search_cases<uint64_t>("uint64");
+	});
+}
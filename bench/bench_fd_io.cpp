@@ -0,0 +1,77 @@
+#include "bench.hpp"
+#include "RawNamespace/io/RawFdIO.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+/************************************************************************
+* raw::append_from_fd vs reading through a stack buffer.
+*
+* `read_file` - read an `n`-byte file (in the page cache) into a fresh
+*               raw::vector<char>.
+*   `append_from_fd` - sized by fstat, read straight into the vector.
+*   `stack_push_back` - 64 KiB stack buffer, then push_back per byte
+*                       (the ingest path this replaces).
+*   `stack_memcpy`    - 64 KiB stack buffer, then one bulk append per
+*                       read: the best a staging copy can do.
+***********************************************************************/
+
+#ifdef RAW_HAS_FD_IO
+namespace {
+	/// Unlinked temp file holding `n` bytes; closed by the destructor.
+	struct temp_file {
+		int fd = -1;
+		explicit temp_file(size_t n) {
+			char path[] = "/tmp/raw_bench_fd_XXXXXX";
+			fd = mkstemp(path);
+			if (fd < 0) {
+				std::perror("mkstemp");
+				std::exit(1);
+			}
+			unlink(path);
+			raw::vector<char> bytes(n);
+			bench::rng rng(42);
+			for (size_t i = 0; i < n; ++i)
+				bytes[i] = static_cast<char>(rng.next());
+			raw::write_to_fd(fd, bytes);
+		}
+		~temp_file() { close(fd); }
+	};
+
+	enum class reader { append_from_fd, stack_push_back, stack_memcpy };
+
+	template<reader R>
+	void bm_read_file(bench::state& st) {
+		temp_file file(st.size);
+		while (st.keep_running()) {
+			lseek(file.fd, 0, SEEK_SET);
+			raw::vector<char> v;
+			if constexpr (R == reader::append_from_fd) {
+				raw::append_from_fd(v, file.fd);
+			}
+			else {
+				char buffer[64 * 1024];
+				ssize_t got;
+				while ((got = read(file.fd, buffer, sizeof(buffer))) > 0) {
+					if constexpr (R == reader::stack_push_back) {
+						for (ssize_t i = 0; i < got; ++i)
+							v.push_back(buffer[i]);
+					}
+					else {
+						v.reserve_spare(static_cast<size_t>(got));
+						std::memcpy(v.spare_data(), buffer, static_cast<size_t>(got));
+						v.commit_spare(static_cast<size_t>(got));
+					}
+				}
+			}
+			bench::do_not_optimize(v);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	bench::registrar fd_io_benchmarks([] {
+		bench::add("fd_io", "read_file", "append_from_fd", "char", bm_read_file<reader::append_from_fd>);
+		bench::add("fd_io", "read_file", "stack_push_back", "char", bm_read_file<reader::stack_push_back>);
+		bench::add("fd_io", "read_file", "stack_memcpy", "char", bm_read_file<reader::stack_memcpy>);
+	});
+}
+#endif
@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+#include "RawNamespace/gap_buffer/RawGapBuffer.hpp"
+#include <string>
+#include <type_traits>
+
+/************************************************************************
+* raw::gap_buffer vs raw::vector under clustered edits.
+*
+* An edit session starts with `n` elements and the cursor in the middle.
+* Each edit moves the cursor by at most 16 positions and then inserts or
+* erases one element there, alternating, so the size stays at `n`.
+* The vector memmoves its tail on every edit; the gap buffer only moves
+* the elements the cursor passes.
+***********************************************************************/
+
+namespace {
+	template<typename T> T make_element(size_t i);
+	template<> int make_element<int>(size_t i) { return static_cast<int>(i * 2654435761u); }
+	template<> std::string make_element<std::string>(size_t i) { return std::to_string(i); }
+
+	constexpr size_t edits_per_iteration = 64;
+
+	template<typename C, typename T>
+	void bm_edit_session(bench::state& st) {
+		C c;
+		for (size_t i = 0; i < st.size; ++i) {
+			if constexpr (std::is_same<C, raw::gap_buffer<T>>::value) c.insert(make_element<T>(i));
+			else c.push_back(make_element<T>(i));
+		}
+		const T value = make_element<T>(st.size);
+		bench::rng rng;
+		size_t cursor = st.size / 2;
+		bool insert = true;
+		while (st.keep_running()) {
+			for (size_t i = 0; i < edits_per_iteration; ++i) {
+				size_t step = rng.next() % 33;
+				cursor = cursor + step >= 16 ? cursor + step - 16 : 0;
+				if (cursor >= c.get_size()) cursor = c.get_size() - 1;
+				if (insert) c.insert(cursor, value);
+				else c.erase(cursor);
+				insert = !insert;
+			}
+			bench::do_not_optimize(c);
+		}
+		st.set_items_per_iteration(edits_per_iteration);
+	}
+
+	bench::registrar gap_buffer_benchmarks([] {
+		bench::add("gap_buffer", "edit_session", "raw_gap", "int", bm_edit_session<raw::gap_buffer<int>, int>);
+		bench::add("gap_buffer", "edit_session", "raw_vector", "int", bm_edit_session<raw::vector<int>, int>);
+		bench::add("gap_buffer", "edit_session", "raw_gap", "string", bm_edit_session<raw::gap_buffer<std::string>, std::string>);
+		bench::add("gap_buffer", "edit_session", "raw_vector", "string", bm_edit_session<raw::vector<std::string>, std::string>);
+	});
+}
@@ -0,0 +1,128 @@
+#include "bench.hpp"
+#include "RawNamespace/hash_map/RawFlatHashMap.hpp"
+#include <string>
+#include <unordered_map>
+
+/************************************************************************
+* raw::flat_hash_map vs std::unordered_map.
+*
+* `hit`    - lookups of keys that are present, in random order.
+* `miss`   - lookups of keys that are absent.
+* `insert` - building a map of `n` keys from empty (no reserve).
+* `erase`  - erasing all `n` keys from a full map (refill untimed).
+* Every lookup key is precomputed so only the table work is timed.
+***********************************************************************/
+
+namespace {
+	template<typename T> T make_key(uint64_t bits);
+	template<> uint64_t make_key<uint64_t>(uint64_t bits) { return bits; }
+	template<> std::string make_key<std::string>(uint64_t bits) { return "key:" + std::to_string(bits); }
+
+	template<typename K>
+	std::vector<K> make_keys(size_t n, uint64_t seed) {
+		bench::rng rng(seed);
+		std::vector<K> keys;
+		keys.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+			keys.push_back(make_key<K>(rng.next() | 1));
+		return keys;
+	}
+
+	/// Keys with the lowest bit cleared never collide with `make_keys` ones.
+	template<typename K>
+	std::vector<K> make_missing_keys(size_t n, uint64_t seed) {
+		bench::rng rng(seed);
+		std::vector<K> keys;
+		keys.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+			keys.push_back(make_key<K>(rng.next() & ~uint64_t(1)));
+		return keys;
+	}
+
+	template<typename Map, typename K>
+	void fill(Map& map, const std::vector<K>& keys) {
+		for (size_t i = 0; i < keys.size(); ++i)
+			map[keys[i]] = static_cast<uint64_t>(i);
+	}
+
+	template<typename Map, typename K>
+	void bm_hit(bench::state& st) {
+		std::vector<K> keys = make_keys<K>(st.size, 1);
+		Map map;
+		fill(map, keys);
+		std::vector<K> probes = keys;
+		bench::rng rng(2);
+		for (size_t i = probes.size(); i > 1; --i)
+			std::swap(probes[i - 1], probes[rng.next() % i]);
+		while (st.keep_running()) {
+			uint64_t sum = 0;
+			for (const K& key : probes)
+				sum += map.find(key)->second;
+			bench::do_not_optimize(sum);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename Map, typename K>
+	void bm_miss(bench::state& st) {
+		std::vector<K> keys = make_keys<K>(st.size, 1);
+		Map map;
+		fill(map, keys);
+		std::vector<K> probes = make_missing_keys<K>(st.size, 3);
+		while (st.keep_running()) {
+			size_t found = 0;
+			for (const K& key : probes)
+				found += map.find(key) != map.end();
+			bench::do_not_optimize(found);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename Map, typename K>
+	void bm_insert(bench::state& st) {
+		std::vector<K> keys = make_keys<K>(st.size, 1);
+		while (st.keep_running()) {
+			Map map;
+			fill(map, keys);
+			bench::do_not_optimize(map);
+			st.pause();
+			{ Map discard(std::move(map)); }
+			st.resume();
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename Map, typename K>
+	void bm_erase(bench::state& st) {
+		std::vector<K> keys = make_keys<K>(st.size, 1);
+		Map map;
+		while (st.keep_running()) {
+			st.pause();
+			fill(map, keys);
+			st.resume();
+			for (const K& key : keys)
+				map.erase(key);
+			bench::do_not_optimize(map);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename K>
+	void add_hash_map_cases(const char* type) {
+		using raw_map = raw::flat_hash_map<K, uint64_t>;
+		using std_map = std::unordered_map<K, uint64_t>;
+		bench::add("hash_map", "hit", "raw_flat", type, bm_hit<raw_map, K>);
+		bench::add("hash_map", "hit", "std_unordered", type, bm_hit<std_map, K>);
+		bench::add("hash_map", "miss", "raw_flat", type, bm_miss<raw_map, K>);
+		bench::add("hash_map", "miss", "std_unordered", type, bm_miss<std_map, K>);
+		bench::add("hash_map", "insert", "raw_flat", type, bm_insert<raw_map, K>);
+		bench::add("hash_map", "insert", "std_unordered", type, bm_insert<std_map, K>);
+		bench::add("hash_map", "erase", "raw_flat", type, bm_erase<raw_map, K>);
+		bench::add("hash_map", "erase", "std_unordered", type, bm_erase<std_map, K>);
+	}
+
+	bench::registrar hash_map_benchmarks([] {
+		add_hash_map_cases<uint64_t>("uint64");
+		add_hash_map_cases<std::string>("string");
+	});
+}
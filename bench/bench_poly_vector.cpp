@@ -0,0 +1,136 @@
+#include "bench.hpp"
+#include "RawNamespace/poly_vector/RawPolyVector.hpp"
+#include <memory>
+#include <vector>
+
+/************************************************************************
+* raw::poly_vector vs std::vector<std::unique_ptr<Base>>.
+*
+* `build`    - `n` objects of four shape types in random order, from
+*              empty; destruction is untimed.
+* `sum_area` - one virtual call per object over a built container.
+*   `unique_ptr` - objects allocated in insertion order, so the heap
+*                  layout is as friendly as it gets.
+*   `scattered`  - the same objects reached in an order unrelated to
+*                  their allocation, as in a long-lived heap.
+*   `raw`        - poly_vector in insertion order.
+*   `grouped`    - poly_vector after group_by_type(): one indirect
+*                  branch target per run.
+***********************************************************************/
+
+namespace {
+	struct Shape {
+		virtual ~Shape() = default;
+		virtual double area() const = 0;
+	};
+
+	struct Circle final : Shape {
+		double r;
+		explicit Circle(double r_) : r(r_) {}
+		double area() const override { return 3.14159265358979 * r * r; }
+	};
+
+	struct Rect final : Shape {
+		double w, h;
+		Rect(double w_, double h_) : w(w_), h(h_) {}
+		double area() const override { return w * h; }
+	};
+
+	struct Triangle final : Shape {
+		double a, b, c;
+		Triangle(double a_, double b_, double c_) : a(a_), b(b_), c(c_) {}
+		double area() const override { return 0.5 * a * b * c / (a + b + c); }
+	};
+
+	struct Polygon final : Shape {
+		double xs[6];
+		explicit Polygon(double x) : xs{ x, x + 1, x + 2, x + 3, x + 4, x + 5 } {}
+		double area() const override { return (xs[0] * xs[3] + xs[1] * xs[4] + xs[2] * xs[5]) * 0.5; }
+	};
+
+	template<typename Sink>
+	void make_shapes(size_t n, Sink&& sink) {
+		bench::rng rng(44);
+		for (size_t i = 0; i < n; ++i) {
+			const uint64_t bits = rng.next();
+			const double x = static_cast<double>(bits >> 40) * 1e-6;
+			sink(bits & 3, x);
+		}
+	}
+
+	void add_to(std::vector<std::unique_ptr<Shape>>& v, uint64_t kind, double x) {
+		switch (kind) {
+		case 0: v.push_back(std::make_unique<Circle>(x)); break;
+		case 1: v.push_back(std::make_unique<Rect>(x, x + 1)); break;
+		case 2: v.push_back(std::make_unique<Triangle>(x, x + 1, x + 2)); break;
+		default: v.push_back(std::make_unique<Polygon>(x)); break;
+		}
+	}
+
+	void add_to(raw::poly_vector<Shape>& v, uint64_t kind, double x) {
+		switch (kind) {
+		case 0: v.emplace_back<Circle>(x); break;
+		case 1: v.emplace_back<Rect>(x, x + 1); break;
+		case 2: v.emplace_back<Triangle>(x, x + 1, x + 2); break;
+		default: v.emplace_back<Polygon>(x); break;
+		}
+	}
+
+	template<typename C>
+	void bm_build(bench::state& st) {
+		while (st.keep_running()) {
+			std::unique_ptr<C> v(new C());
+			make_shapes(st.size, [&](uint64_t kind, double x) { add_to(*v, kind, x); });
+			bench::do_not_optimize(*v);
+			st.pause();
+			v.reset();
+			st.resume();
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	enum class layout { unique_ptr, scattered, raw, grouped };
+
+	template<typename C>
+	void run_sum_area(bench::state& st, const C& shapes) {
+		while (st.keep_running()) {
+			double sum = 0;
+			for (const auto& shape : shapes) {
+				if constexpr (std::is_same<C, raw::poly_vector<Shape>>::value) sum += shape.area();
+				else sum += shape->area();
+			}
+			bench::do_not_optimize(sum);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<layout L>
+	void bm_sum_area(bench::state& st) {
+		if constexpr (L == layout::unique_ptr || L == layout::scattered) {
+			std::vector<std::unique_ptr<Shape>> v;
+			make_shapes(st.size, [&](uint64_t kind, double x) { add_to(v, kind, x); });
+			if constexpr (L == layout::scattered) {
+				bench::rng rng(45);
+				for (size_t i = v.size(); i > 1; --i)
+					std::swap(v[i - 1], v[rng.next() % i]);
+			}
+			run_sum_area(st, v);
+		}
+		else {
+			raw::poly_vector<Shape> v;
+			make_shapes(st.size, [&](uint64_t kind, double x) { add_to(v, kind, x); });
+			if constexpr (L == layout::grouped)
+				v.group_by_type();
+			run_sum_area(st, v);
+		}
+	}
+
+	bench::registrar poly_vector_benchmarks([] {
+		bench::add("poly_vector", "build", "raw", "shape", bm_build<raw::poly_vector<Shape>>);
+		bench::add("poly_vector", "build", "unique_ptr", "shape", bm_build<std::vector<std::unique_ptr<Shape>>>);
+		bench::add("poly_vector", "sum_area", "raw", "shape", bm_sum_area<layout::raw>);
+		bench::add("poly_vector", "sum_area", "grouped", "shape", bm_sum_area<layout::grouped>);
+		bench::add("poly_vector", "sum_area", "unique_ptr", "shape", bm_sum_area<layout::unique_ptr>);
+		bench::add("poly_vector", "sum_area", "scattered", "shape", bm_sum_area<layout::scattered>);
+	});
+}
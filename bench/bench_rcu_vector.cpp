@@ -0,0 +1,120 @@
+#include "bench.hpp"
+#include "RawNamespace/rcu/RawRcuVector.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/************************************************************************
+* Read scalability of a 4096-entry routing table: raw::rcu_vector vs a
+* raw::vector behind std::shared_mutex.
+*
+* The size is the number of reader threads (1, 2, 4, ... up to every
+* hardware thread). Each reader does 256K lookups per iteration: take a
+* snapshot / shared lock, read one entry, drop it. ns/op is wall time
+* per lookup over all threads, so perfect scaling halves it per doubling.
+* `read`        - readers only.
+* `read_update` - plus a writer republishing the table every 100 us.
+* Thread counts are below the default minimum size:
+*     raw_bench --filter rcu_vector --min-size 1
+***********************************************************************/
+
+namespace {
+	constexpr size_t table_size = 4096;
+	constexpr size_t lookups_per_thread = 262144;
+
+	raw::vector<uint64_t> make_table(uint64_t salt) {
+		raw::vector<uint64_t> table;
+		table.reserve(table_size);
+		for (size_t i = 0; i < table_size; ++i)
+			table.push_back(i * 0x9E3779B97F4A7C15ull + salt);
+		return table;
+	}
+
+	struct rcu_table {
+		raw::rcu_vector<uint64_t> table{ make_table(0), 256 };
+
+		template<typename Body>
+		void reader_thread(Body&& body) {
+			auto reader = table.make_reader();
+			body([&](size_t i) { return reader.read()[i]; });
+		}
+
+		void republish(uint64_t salt) { table.assign(make_table(salt)); }
+	};
+
+	struct shared_mutex_table {
+		raw::vector<uint64_t> table = make_table(0);
+		std::shared_mutex lock;
+
+		template<typename Body>
+		void reader_thread(Body&& body) {
+			body([&](size_t i) {
+				std::shared_lock<std::shared_mutex> guard(lock);
+				return table[i];
+			});
+		}
+
+		void republish(uint64_t salt) {
+			raw::vector<uint64_t> fresh = make_table(salt);
+			std::unique_lock<std::shared_mutex> guard(lock);
+			table.swap(fresh);
+		}
+	};
+
+	template<typename Table, bool Writer>
+	void bm_read(bench::state& st) {
+		Table shared;
+		const size_t readers = st.size;
+		while (st.keep_running()) {
+			std::atomic<bool> stop{ false };
+			std::thread writer;
+			if constexpr (Writer) {
+				writer = std::thread([&] {
+					for (uint64_t salt = 1; !stop.load(std::memory_order_relaxed); ++salt) {
+						shared.republish(salt);
+						std::this_thread::sleep_for(std::chrono::microseconds(100));
+					}
+				});
+			}
+			std::vector<std::thread> threads;
+			for (size_t t = 0; t < readers; ++t) {
+				threads.emplace_back([&shared, t] {
+					shared.reader_thread([t](auto&& lookup) {
+						uint64_t sum = 0;
+						size_t index = t * 977;
+						for (size_t i = 0; i < lookups_per_thread; ++i) {
+							sum += lookup(index % table_size);
+							index += 0x9E37;
+						}
+						bench::do_not_optimize(sum);
+					});
+				});
+			}
+			for (std::thread& thread : threads)
+				thread.join();
+			stop.store(true);
+			if constexpr (Writer)
+				writer.join();
+		}
+		st.set_items_per_iteration(readers * lookups_per_thread);
+	}
+
+	std::vector<size_t> reader_counts() {
+		const size_t hardware = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+		std::vector<size_t> counts;
+		for (size_t n = 1; n < hardware; n *= 2)
+			counts.push_back(n);
+		counts.push_back(hardware);
+		return counts;
+	}
+
+	bench::registrar rcu_vector_benchmarks([] {
+		bench::add("rcu_vector", "read", "shared_mutex", "uint64", bm_read<shared_mutex_table, false>, reader_counts());
+		bench::add("rcu_vector", "read", "rcu", "uint64", bm_read<rcu_table, false>, reader_counts());
+		bench::add("rcu_vector", "read_update", "shared_mutex", "uint64", bm_read<shared_mutex_table, true>, reader_counts());
+		bench::add("rcu_vector", "read_update", "rcu", "uint64", bm_read<rcu_table, true>, reader_counts());
+	});
+}
@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "RawNamespace/sort/RawSort.hpp"
+#include <algorithm>
+#include <cstring>
+
+/************************************************************************
+* raw::radix_sort vs std::sort.
+*
+* `uniform`    - keys drawn from the whole value range.
+* `skewed`     - keys below 4096, so the high digits are identical and
+*                radix_sort skips their passes.
+* `presorted`  - ascending input; radix_sort returns after one scan,
+*                std::sort still does its O(n log n) comparisons.
+* Each iteration restores an unsorted input untimed. Small sizes cycle
+* through several different inputs so std::sort cannot win by having
+* the branch predictor learn one input.
+***********************************************************************/
+
+namespace {
+	enum class distribution { uniform, skewed, presorted };
+
+	template<typename T>
+	T make_key(uint64_t bits, distribution d) {
+		if (d == distribution::skewed)
+			bits &= 4095;
+		if constexpr (std::is_floating_point<T>::value)
+			return static_cast<T>(static_cast<int64_t>(bits >> 11) - (int64_t(1) << 52)) * T(1e-6);
+		else
+			return static_cast<T>(bits);
+	}
+
+	/// `sets` inputs of `n` keys back to back.
+	template<typename T>
+	raw::vector<T> make_inputs(size_t n, size_t sets, distribution d) {
+		bench::rng rng(7);
+		raw::vector<T> v(n * sets);
+		for (size_t i = 0; i < n * sets; ++i)
+			v[i] = make_key<T>(rng.next(), d);
+		if (d == distribution::presorted) {
+			for (size_t s = 0; s < sets; ++s)
+				std::sort(v.begin() + s * n, v.begin() + (s + 1) * n);
+		}
+		return v;
+	}
+
+	template<typename T, distribution D, bool Radix>
+	void bm_sort(bench::state& st) {
+		const size_t sets = st.size < 4096 ? 4096 / st.size : 1;
+		const raw::vector<T> inputs = make_inputs<T>(st.size, sets, D);
+		raw::vector<T> work(st.size);
+		size_t next = 0;
+		while (st.keep_running()) {
+			st.pause();
+			std::memcpy(work.get_data(), inputs.get_data() + next * st.size, st.size * sizeof(T));
+			next = next + 1 < sets ? next + 1 : 0;
+			st.resume();
+			if (Radix) raw::radix_sort(work);
+			else std::sort(work.begin(), work.end());
+			bench::do_not_optimize(work);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename T>
+	void add_sort_cases(const char* type) {
+		bench::add("sort", "uniform", "radix", type, bm_sort<T, distribution::uniform, true>);
+		bench::add("sort", "uniform", "std_sort", type, bm_sort<T, distribution::uniform, false>);
+		bench::add("sort", "skewed", "radix", type, bm_sort<T, distribution::skewed, true>);
+		bench::add("sort", "skewed", "std_sort", type, bm_sort<T, distribution::skewed, false>);
+		bench::add("sort", "presorted", "radix", type, bm_sort<T, distribution::presorted, true>);
+		bench::add("sort", "presorted", "std_sort", type, bm_sort<T, distribution::presorted, false>);
+	}
+
+	bench::registrar sort_benchmarks([] {
+		add_sort_cases<uint32_t>("uint32");
+		add_sort_cases<uint64_t>("uint64");
+		add_sort_cases<float>("float");
+		add_sort_cases<double>("double");
+	});
+}
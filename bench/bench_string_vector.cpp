@@ -0,0 +1,148 @@
+#include "bench.hpp"
+#include "RawNamespace/string_vector/RawStringVector.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/************************************************************************
+* raw::string_vector vs std::vector<std::string> as a dictionary of `n`
+* words of 4..27 random lowercase letters (some under, most over the
+* SSO limit).
+*
+* `build` - push_back every word into an empty container.
+* `split` - split one newline-separated buffer of all the words
+*           (append_delimited vs a memchr loop constructing strings).
+* `sort`  - sort a filled container (a fresh copy each iteration,
+*           copied outside the timed region).
+* `scan`  - sum the lengths and first bytes of every string.
+* Run with `--max-size 10M` for the out-of-cache end.
+***********************************************************************/
+
+namespace {
+	std::string make_text(size_t n) {
+		bench::rng rng(47);
+		std::string text;
+		text.reserve(n * 16);
+		for (size_t i = 0; i < n; ++i) {
+			const uint64_t bits = rng.next();
+			const size_t length = 4 + bits % 24;
+			uint64_t letters = rng.next();
+			for (size_t c = 0; c < length; ++c) {
+				if (c % 12 == 11)
+					letters = rng.next();
+				text.push_back(static_cast<char>('a' + (letters % 26)));
+				letters /= 26;
+			}
+			text.push_back('\n');
+		}
+		return text;
+	}
+
+	std::vector<std::string_view> split_views(const std::string& text) {
+		std::vector<std::string_view> words;
+		size_t begin = 0;
+		while (begin < text.size()) {
+			const size_t end = text.find('\n', begin);
+			words.emplace_back(text.data() + begin, end - begin);
+			begin = end + 1;
+		}
+		return words;
+	}
+
+	struct std_strings {
+		std::vector<std::string> v;
+		void push_back(std::string_view s) { v.emplace_back(s); }
+		void append_delimited(std::string_view text) {
+			const char* p = text.data();
+			const char* end = p + text.size();
+			while (p < end) {
+				const char* stop = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+				if (!stop)
+					stop = end;
+				v.emplace_back(p, static_cast<size_t>(stop - p));
+				p = stop + 1;
+			}
+		}
+		void sort() { std::sort(v.begin(), v.end()); }
+		size_t get_size() const { return v.size(); }
+		std::string_view operator [] (size_t i) const { return v[i]; }
+	};
+
+	struct raw_strings {
+		raw::string_vector v;
+		void push_back(std::string_view s) { v.push_back(s); }
+		void append_delimited(std::string_view text) { v.append_delimited(text); }
+		void sort() { v.sort(); }
+		size_t get_size() const { return v.get_size(); }
+		std::string_view operator [] (size_t i) const { return v[i]; }
+	};
+
+	template<typename S>
+	void bm_build(bench::state& st) {
+		const std::string text = make_text(st.size);
+		const std::vector<std::string_view> words = split_views(text);
+		while (st.keep_running()) {
+			S s;
+			for (std::string_view word : words)
+				s.push_back(word);
+			bench::do_not_optimize(s);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename S>
+	void bm_split(bench::state& st) {
+		const std::string text = make_text(st.size);
+		while (st.keep_running()) {
+			S s;
+			s.append_delimited(text);
+			bench::do_not_optimize(s);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename S>
+	void bm_sort(bench::state& st) {
+		const std::string text = make_text(st.size);
+		S filled;
+		filled.append_delimited(text);
+		while (st.keep_running()) {
+			st.pause();
+			S s = filled;
+			st.resume();
+			s.sort();
+			bench::do_not_optimize(s);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename S>
+	void bm_scan(bench::state& st) {
+		S s;
+		s.append_delimited(make_text(st.size));
+		while (st.keep_running()) {
+			size_t sum = 0;
+			for (size_t i = 0; i < s.get_size(); ++i) {
+				const std::string_view word = s[i];
+				sum += word.size() + static_cast<unsigned char>(word[0]);
+			}
+			bench::do_not_optimize(sum);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename S>
+	void add_string_cases(const char* impl) {
+		bench::add("string_vector", "build", impl, "string", bm_build<S>);
+		bench::add("string_vector", "split", impl, "string", bm_split<S>);
+		bench::add("string_vector", "sort", impl, "string", bm_sort<S>);
+		bench::add("string_vector", "scan", impl, "string", bm_scan<S>);
+	}
+
+	bench::registrar string_vector_benchmarks([] {
+		add_string_cases<std_strings>("std_vector_string");
+		add_string_cases<raw_strings>("raw");
+	});
+}
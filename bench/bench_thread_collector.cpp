@@ -0,0 +1,109 @@
+#include "bench.hpp"
+#include "RawNamespace/collector/RawThreadCollector.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/************************************************************************
+* Gathering `n` uint64 results from 4 worker threads into one raw::vector.
+*
+* `collect` - workers filter a range (keeping ~3/4) and emit results:
+*   `mutex_vector`     - push_back into a shared vector under a mutex.
+*   `concat_push_back` - per-worker vectors, concatenated with push_back.
+*   `collector`        - thread_collector::local(w), then merge().
+* `merge`   - only the concatenation, locals filled outside the timing:
+*   `concat_push_back` - push_back loop over the locals.
+*   `collector_1`      - merge() on one thread.
+*   `collector_all`    - merge() with every hardware thread.
+***********************************************************************/
+
+namespace {
+	constexpr unsigned workers = 4;
+
+	bool keep(uint64_t i) noexcept { return ((i * 0x9E3779B97F4A7C15ull) >> 62) != 0; }
+
+	template<typename Emit>
+	void run_workers(size_t n, Emit emit) {
+		std::vector<std::thread> threads;
+		for (unsigned w = 0; w < workers; ++w) {
+			threads.emplace_back([=] {
+				for (uint64_t i = n * w / workers; i < n * (w + 1) / workers; ++i)
+					if (keep(i))
+						emit(w, i);
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	enum class gather { mutex_vector, concat_push_back, collector };
+
+	template<gather G>
+	void bm_collect(bench::state& st) {
+		while (st.keep_running()) {
+			raw::vector<uint64_t> result;
+			if constexpr (G == gather::mutex_vector) {
+				std::mutex lock;
+				run_workers(st.size, [&](unsigned, uint64_t value) {
+					std::lock_guard<std::mutex> guard(lock);
+					result.push_back(value);
+				});
+			}
+			else if constexpr (G == gather::concat_push_back) {
+				std::vector<raw::vector<uint64_t>> locals(workers);
+				run_workers(st.size, [&](unsigned w, uint64_t value) { locals[w].push_back(value); });
+				for (const auto& local : locals)
+					for (uint64_t value : local)
+						result.push_back(value);
+			}
+			else {
+				raw::thread_collector<uint64_t> collector(workers);
+				run_workers(st.size, [&](unsigned w, uint64_t value) { collector.local(w).push_back(value); });
+				raw::merge_options options;
+				options.threads = 0;
+				result = collector.merge(options);
+			}
+			bench::do_not_optimize(result);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	enum class concat { push_back, collector_1, collector_all };
+
+	template<concat C>
+	void bm_merge(bench::state& st) {
+		raw::thread_collector<uint64_t> collector(workers);
+		while (st.keep_running()) {
+			st.pause();
+			for (unsigned w = 0; w < workers; ++w)
+				for (uint64_t i = st.size * w / workers; i < st.size * (w + 1) / workers; ++i)
+					collector.local(w).push_back(i);
+			st.resume();
+			raw::vector<uint64_t> result;
+			if constexpr (C == concat::push_back) {
+				for (unsigned w = 0; w < workers; ++w)
+					for (uint64_t value : collector.local(w))
+						result.push_back(value);
+				st.pause();
+				collector.clear();
+				st.resume();
+			}
+			else {
+				raw::merge_options options;
+				options.threads = C == concat::collector_1 ? 1 : 0;
+				result = collector.merge(options);
+			}
+			bench::do_not_optimize(result);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	bench::registrar thread_collector_benchmarks([] {
+		bench::add("thread_collector", "collect", "mutex_vector", "uint64", bm_collect<gather::mutex_vector>);
+		bench::add("thread_collector", "collect", "concat_push_back", "uint64", bm_collect<gather::concat_push_back>);
+		bench::add("thread_collector", "collect", "collector", "uint64", bm_collect<gather::collector>);
+		bench::add("thread_collector", "merge", "concat_push_back", "uint64", bm_merge<concat::push_back>);
+		bench::add("thread_collector", "merge", "collector_1", "uint64", bm_merge<concat::collector_1>);
+		bench::add("thread_collector", "merge", "collector_all", "uint64", bm_merge<concat::collector_all>);
+	});
+}
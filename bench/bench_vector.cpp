@@ -0,0 +1,241 @@
+#include "bench.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/************************************************************************
+* raw::vector vs std::vector.
+*
+* Every case runs for `int` (vector_triv) and `std::string` (vector_non_triv,
+* short strings so the numbers measure the container and not the heap).
+* Element values are generated before timing starts.
+***********************************************************************/
+
+namespace {
+	template<typename V> struct is_std_vector : std::false_type {};
+	template<typename T, typename A> struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+	template<typename V>
+	size_t size_of(const V& v) {
+		if constexpr (is_std_vector<V>::value) return v.size();
+		else return v.get_size();
+	}
+
+	template<typename V, typename T>
+	void insert_at(V& v, size_t index, const T& value) {
+		if constexpr (is_std_vector<V>::value) v.insert(v.begin() + index, value);
+		else v.insert(index, value);
+	}
+
+	template<typename V>
+	void erase_at(V& v, size_t index) {
+		if constexpr (is_std_vector<V>::value) v.erase(v.begin() + index);
+		else v.erase(index);
+	}
+
+	template<typename T> T make_value(size_t i);
+	template<> int make_value<int>(size_t i) { return static_cast<int>(i * 2654435761u); }
+	template<> std::string make_value<std::string>(size_t i) { return std::to_string(i); }
+
+	template<typename T>
+	std::vector<T> make_values(size_t n) {
+		std::vector<T> values;
+		values.reserve(n);
+		for (size_t i = 0; i < n; ++i) values.push_back(make_value<T>(i));
+		return values;
+	}
+
+	template<typename V, typename T>
+	V make_filled(const std::vector<T>& values) {
+		V v;
+		v.reserve(values.size());
+		for (const T& value : values) v.push_back(value);
+		return v;
+	}
+
+	/// Number of edits timed per iteration for insert/erase cases; each one is O(n) at most.
+	size_t edit_count(size_t n) { return std::min<size_t>(n, 32); }
+
+	enum class where { front, middle, back };
+
+	size_t position(where w, size_t size) {
+		switch (w) {
+		case where::front: return 0;
+		case where::middle: return size / 2;
+		default: return size;
+		}
+	}
+
+	template<typename V, typename T>
+	void bm_push_back(bench::state& st) {
+		std::vector<T> values = make_values<T>(st.size);
+		while (st.keep_running()) {
+			std::optional<V> v(std::in_place);
+			for (const T& value : values) v->push_back(value);
+			bench::do_not_optimize(*v);
+			st.pause();
+			v.reset();
+			st.resume();
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename V, typename T>
+	void bm_reserve_push_back(bench::state& st) {
+		std::vector<T> values = make_values<T>(st.size);
+		while (st.keep_running()) {
+			std::optional<V> v(std::in_place);
+			v->reserve(st.size);
+			for (const T& value : values) v->push_back(value);
+			bench::do_not_optimize(*v);
+			st.pause();
+			v.reset();
+			st.resume();
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename V, typename T>
+	void bm_resize(bench::state& st) {
+		while (st.keep_running()) {
+			std::optional<V> v(std::in_place);
+			v->resize(st.size);
+			bench::do_not_optimize(*v);
+			st.pause();
+			v.reset();
+			st.resume();
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	/// Timed: `edits` inserts at `w`. Untimed: erasing them again so every iteration sees `size` elements.
+	template<typename V, typename T, where W>
+	void bm_insert(bench::state& st) {
+		std::vector<T> values = make_values<T>(st.size);
+		V v = make_filled<V>(values);
+		const size_t edits = edit_count(st.size);
+		const T value = make_value<T>(st.size);
+		while (st.keep_running()) {
+			for (size_t i = 0; i < edits; ++i)
+				insert_at(v, position(W, size_of(v)), value);
+			st.pause();
+			for (size_t i = 0; i < edits; ++i)
+				erase_at(v, std::min(position(W, size_of(v)), size_of(v) - 1));
+			st.resume();
+		}
+		st.set_items_per_iteration(edits);
+	}
+
+	/// Timed: `edits` erases at `w`. Untimed: inserting them back.
+	template<typename V, typename T, where W>
+	void bm_erase(bench::state& st) {
+		std::vector<T> values = make_values<T>(st.size);
+		V v = make_filled<V>(values);
+		const size_t edits = edit_count(st.size);
+		const T value = make_value<T>(st.size);
+		while (st.keep_running()) {
+			for (size_t i = 0; i < edits; ++i)
+				erase_at(v, std::min(position(W, size_of(v)), size_of(v) - 1));
+			st.pause();
+			for (size_t i = 0; i < edits; ++i)
+				insert_at(v, position(W, size_of(v)), value);
+			st.resume();
+		}
+		st.set_items_per_iteration(edits);
+	}
+
+	/// clear() then push_back `size` elements again; with capacity retention no iteration allocates.
+	template<typename V, typename T>
+	void bm_clear_refill(bench::state& st) {
+		std::vector<T> values = make_values<T>(st.size);
+		V v = make_filled<V>(values);
+		while (st.keep_running()) {
+			v.clear();
+			for (const T& value : values) v.push_back(value);
+			bench::do_not_optimize(v);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename V, typename T>
+	void bm_copy(bench::state& st) {
+		V source = make_filled<V>(make_values<T>(st.size));
+		while (st.keep_running()) {
+			std::optional<V> copy(source);
+			bench::do_not_optimize(*copy);
+			st.pause();
+			copy.reset();
+			st.resume();
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	/// One op is a move construction plus a move assignment back; a buffer-stealing move is O(1).
+	template<typename V, typename T>
+	void bm_move(bench::state& st) {
+		V source = make_filled<V>(make_values<T>(st.size));
+		const size_t round_trips = 16;
+		while (st.keep_running()) {
+			for (size_t i = 0; i < round_trips; ++i) {
+				V moved(std::move(source));
+				bench::do_not_optimize(moved);
+				source = std::move(moved);
+			}
+		}
+		st.set_items_per_iteration(round_trips);
+	}
+
+	template<typename V, typename T>
+	void bm_iterate(bench::state& st) {
+		V v = make_filled<V>(make_values<T>(st.size));
+		while (st.keep_running()) {
+			size_t sum = 0;
+			for (const T& value : v) {
+				if constexpr (std::is_same<T, std::string>::value) sum += value.size();
+				else sum += static_cast<size_t>(value);
+			}
+			bench::do_not_optimize(sum);
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename V, typename T>
+	void bm_destroy(bench::state& st) {
+		std::vector<T> values = make_values<T>(st.size);
+		while (st.keep_running()) {
+			st.pause();
+			std::optional<V> v(make_filled<V>(values));
+			st.resume();
+			v.reset();
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	template<typename V, typename T>
+	void register_container(const char* impl, const char* type) {
+		bench::add("vector", "push_back", impl, type, bm_push_back<V, T>);
+		bench::add("vector", "reserve_push_back", impl, type, bm_reserve_push_back<V, T>);
+		bench::add("vector", "resize", impl, type, bm_resize<V, T>);
+		bench::add("vector", "insert_front", impl, type, bm_insert<V, T, where::front>);
+		bench::add("vector", "insert_middle", impl, type, bm_insert<V, T, where::middle>);
+		bench::add("vector", "insert_back", impl, type, bm_insert<V, T, where::back>);
+		bench::add("vector", "erase_front", impl, type, bm_erase<V, T, where::front>);
+		bench::add("vector", "erase_middle", impl, type, bm_erase<V, T, where::middle>);
+		bench::add("vector", "erase_back", impl, type, bm_erase<V, T, where::back>);
+		bench::add("vector", "clear_refill", impl, type, bm_clear_refill<V, T>);
+		bench::add("vector", "copy", impl, type, bm_copy<V, T>);
+		bench::add("vector", "move", impl, type, bm_move<V, T>);
+		bench::add("vector", "iterate", impl, type, bm_iterate<V, T>);
+		bench::add("vector", "destroy", impl, type, bm_destroy<V, T>);
+	}
+
+	bench::registrar vector_benchmarks([] {
+		register_container<raw::vector<int>, int>("raw", "int");
+		register_container<std::vector<int>, int>("std", "int");
+		register_container<raw::vector<std::string>, std::string>("raw", "string");
+		register_container<std::vector<std::string>, std::string>("std", "string");
+	});
+}
@@ -0,0 +1,36 @@
+#include "bench.hpp"
+#include "RawNamespace/vm_vector/RawVmVector.hpp"
+#include "RawNamespace/vector/vector_alias.hpp"
+#include <optional>
+
+/************************************************************************
+* raw::vm_vector vs raw::vector.
+*
+* `push_back` - `n` appends into a fresh vector. raw::vector copies its
+*               buffer on every doubling realloc that cannot grow in
+*               place; vm_vector only changes page protections.
+* Destruction is untimed.
+***********************************************************************/
+
+#ifdef RAW_HAS_VM_VECTOR
+namespace {
+	template<typename V>
+	void bm_push_back(bench::state& st) {
+		while (st.keep_running()) {
+			std::optional<V> v(std::in_place);
+			for (size_t i = 0; i < st.size; ++i)
+				v->push_back(static_cast<uint64_t>(i));
+			bench::do_not_optimize(*v);
+			st.pause();
+			v.reset();
+			st.resume();
+		}
+		st.set_items_per_iteration(st.size);
+	}
+
+	bench::registrar vm_vector_benchmarks([] {
+		bench::add("vm_vector", "push_back", "raw_vm", "uint64", bm_push_back<raw::vm_vector<uint64_t>>);
+		bench::add("vm_vector", "push_back", "raw_vector", "uint64", bm_push_back<raw::vector<uint64_t>>);
+	});
+}
+#endif
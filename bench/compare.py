@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Compare raw_bench results.
+
+Two files (CSV or JSON written by raw_bench):
+    compare.py baseline.json current.json [--threshold 0.05]
+  flags every case whose median ns/op grew by more than the threshold.
+
+One file with --vs-std:
+    compare.py current.json --vs-std [--threshold 0.05]
+  flags every case where raw::* is slower than the std:: counterpart.
+
+Exits with 1 when something was flagged, so it can gate CI.
+"""
+import argparse
+import csv
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        if path.endswith(".json"):
+            rows = json.load(f)["results"]
+        else:
+            rows = list(csv.DictReader(f))
+    results = {}
+    for row in rows:
+        key = (row["suite"], row["benchmark"], row["impl"], row["type"], int(row["size"]))
+        results[key] = float(row["median_ns_per_op"])
+    return results
+
+
+def fmt(key):
+    suite, name, impl, type_, size = key
+    return f"{suite}/{name}/{impl}/{type_}/{size}"
+
+
+def compare_runs(baseline, current, threshold):
+    flagged = 0
+    for key in sorted(current):
+        if key not in baseline or baseline[key] <= 0:
+            continue
+        ratio = current[key] / baseline[key]
+        status = ""
+        if ratio > 1 + threshold:
+            status = "REGRESSION"
+            flagged += 1
+        elif ratio < 1 - threshold:
+            status = "improved"
+        print(f"{fmt(key):60s} {baseline[key]:14.3f} {current[key]:14.3f} {ratio:7.3f} {status}")
+    return flagged
+
+
+def compare_vs_std(results, threshold):
+    flagged = 0
+    for key in sorted(results):
+        suite, name, impl, type_, size = key
+        if impl == "std":
+            continue
+        std_key = (suite, name, "std", type_, size)
+        if std_key not in results or results[std_key] <= 0:
+            continue
+        ratio = results[key] / results[std_key]
+        status = ""
+        if ratio > 1 + threshold:
+            status = "SLOWER"
+            flagged += 1
+        elif ratio < 1 - threshold:
+            status = "faster"
+        print(f"{fmt(key):60s} {results[std_key]:14.3f} {results[key]:14.3f} {ratio:7.3f} {status}")
+    return flagged
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+")
+    parser.add_argument("--threshold", type=float, default=0.05, help="relative change that is flagged (default 0.05)")
+    parser.add_argument("--vs-std", action="store_true", help="compare raw against std inside one result file")
+    args = parser.parse_args()
+
+    if args.vs_std:
+        if len(args.files) != 1:
+            parser.error("--vs-std takes exactly one file")
+        print(f"{'case':60s} {'std ns/op':>14s} {'raw ns/op':>14s} {'ratio':>7s}")
+        flagged = compare_vs_std(load(args.files[0]), args.threshold)
+    else:
+        if len(args.files) != 2:
+            parser.error("expected baseline and current result files")
+        print(f"{'case':60s} {'base ns/op':>14s} {'curr ns/op':>14s} {'ratio':>7s}")
+        flagged = compare_runs(load(args.files[0]), load(args.files[1]), args.threshold)
+
+    print(f"\n{flagged} case(s) beyond {args.threshold:.0%}")
+    return 1 if flagged else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,154 @@
+#include "bench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/************************************************************************
+* Benchmark driver.
+*
+* Usage: raw_bench [--min-size N] [--max-size N] [--filter TEXT]
+*                  [--repetitions N] [--min-time SECONDS]
+*                  [--csv FILE] [--json FILE] [--list]
+*
+* CSV rows go to stdout unless --csv is given. Each case runs
+* `--repetitions` times and the median ns/op is reported next to the minimum.
+***********************************************************************/
+
+namespace {
+	struct options {
+		size_t min_size = 8;
+		size_t max_size = 1000000;
+		std::string filter;
+		size_t repetitions = 5;
+		double min_time = 0.05;
+		std::string csv_path;
+		std::string json_path;
+		bool list = false;
+	};
+
+	struct result {
+		const bench::entry* entry;
+		size_t size;
+		double median_ns;
+		double min_ns;
+		size_t iterations;
+	};
+
+	/// 8 .. 100M, roughly x8 per step.
+	const std::vector<size_t> default_sizes = { 8, 64, 512, 4096, 32768, 262144, 1000000, 10000000, 100000000 };
+
+	size_t parse_size(const char* text) {
+		char* end = nullptr;
+		double value = std::strtod(text, &end);
+		if (end && (*end == 'k' || *end == 'K')) value *= 1e3;
+		if (end && (*end == 'm' || *end == 'M')) value *= 1e6;
+		if (end && (*end == 'g' || *end == 'G')) value *= 1e9;
+		return static_cast<size_t>(value);
+	}
+
+	bool parse(int argc, char** argv, options& opt) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			auto next = [&]() -> const char* {
+				if (i + 1 >= argc) { std::cerr << "missing value for " << arg << "\n"; std::exit(2); }
+				return argv[++i];
+			};
+			if (arg == "--min-size") opt.min_size = parse_size(next());
+			else if (arg == "--max-size") opt.max_size = parse_size(next());
+			else if (arg == "--filter") opt.filter = next();
+			else if (arg == "--repetitions") opt.repetitions = std::max<size_t>(1, parse_size(next()));
+			else if (arg == "--min-time") opt.min_time = std::strtod(next(), nullptr);
+			else if (arg == "--csv") opt.csv_path = next();
+			else if (arg == "--json") opt.json_path = next();
+			else if (arg == "--list") opt.list = true;
+			else {
+				std::cerr << "unknown option " << arg << "\n";
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::string full_name(const bench::entry& e) {
+		return e.suite + "/" + e.name + "/" + e.impl + "/" + e.type;
+	}
+
+	void write_csv(std::ostream& os, const std::vector<result>& results) {
+		os << "suite,benchmark,impl,type,size,median_ns_per_op,min_ns_per_op,iterations\n";
+		for (const result& r : results)
+			os << r.entry->suite << ',' << r.entry->name << ',' << r.entry->impl << ',' << r.entry->type << ','
+			<< r.size << ',' << r.median_ns << ',' << r.min_ns << ',' << r.iterations << '\n';
+	}
+
+	void write_json(std::ostream& os, const std::vector<result>& results, const options& opt) {
+		os << "{\n  \"context\": {\"compiler\": \"" <<
+#if defined(__clang__)
+			"clang " __clang_version__
+#elif defined(__GNUC__)
+			"gcc " __VERSION__
+#elif defined(_MSC_VER)
+			"msvc"
+#else
+			"unknown"
+#endif
+			<< "\", \"repetitions\": " << opt.repetitions << ", \"min_time\": " << opt.min_time << "},\n  \"results\": [\n";
+		for (size_t i = 0; i < results.size(); ++i) {
+			const result& r = results[i];
+			os << "    {\"suite\": \"" << r.entry->suite << "\", \"benchmark\": \"" << r.entry->name
+				<< "\", \"impl\": \"" << r.entry->impl << "\", \"type\": \"" << r.entry->type
+				<< "\", \"size\": " << r.size << ", \"median_ns_per_op\": " << r.median_ns
+				<< ", \"min_ns_per_op\": " << r.min_ns << ", \"iterations\": " << r.iterations << "}"
+				<< (i + 1 < results.size() ? ",\n" : "\n");
+		}
+		os << "  ]\n}\n";
+	}
+}
+
+int main(int argc, char** argv) {
+	options opt;
+	if (!parse(argc, argv, opt)) return 2;
+
+	std::vector<result> results;
+	for (const bench::entry& e : bench::registry()) {
+		std::string name = full_name(e);
+		if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) continue;
+		const std::vector<size_t>& sizes = e.sizes.empty() ? default_sizes : e.sizes;
+		for (size_t size : sizes) {
+			if (size < opt.min_size || size > opt.max_size) continue;
+			if (opt.list) {
+				std::cout << name << "/" << size << "\n";
+				continue;
+			}
+			std::vector<double> samples;
+			size_t iterations = 0;
+			for (size_t rep = 0; rep < opt.repetitions; ++rep) {
+				bench::state st(size, opt.min_time);
+				e.fn(st);
+				samples.push_back(st.ns_per_item());
+				iterations += st.get_iterations();
+			}
+			std::sort(samples.begin(), samples.end());
+			results.push_back(result{ &e, size, samples[samples.size() / 2], samples.front(), iterations });
+			std::cerr << name << "/" << size << ": " << samples[samples.size() / 2] << " ns/op\n";
+		}
+	}
+	if (opt.list) return 0;
+
+	if (opt.csv_path.empty()) {
+		write_csv(std::cout, results);
+	}
+	else {
+		std::ofstream csv(opt.csv_path);
+		write_csv(csv, results);
+	}
+	if (!opt.json_path.empty()) {
+		std::ofstream json(opt.json_path);
+		write_json(json, results, opt);
+	}
+	return 0;
+}
@@ -1,11 +1,41 @@
-﻿#include "RawNamespace\vector\vector_alias.hpp"
+﻿#include "RawNamespace/vector/vector_alias.hpp"
+#include "RawNamespace/bit_vector/RawBitVector.hpp"
+#include "RawNamespace/inplace_vector/RawInplaceVector.hpp"
+#include "RawNamespace/gap_buffer/RawGapBuffer.hpp"
+#include "RawNamespace/span/RawSpan.hpp"
+#include "RawNamespace/expr/RawExpr.hpp"
+#include "RawNamespace/sort/RawSort.hpp"
+#include "RawNamespace/hash_map/RawFlatHashMap.hpp"
+#include "RawNamespace/slot_map/RawSlotMap.hpp"
+#include "RawNamespace/io/RawFdIO.hpp"
+#include "RawNamespace/vm_vector/RawVmVector.hpp"
+#include "RawNamespace/poly_vector/RawPolyVector.hpp"
+#include "RawNamespace/heap/RawDaryHeap.hpp"
+#include "RawNamespace/search/RawEytzinger.hpp"
+#include "RawNamespace/string_vector/RawStringVector.hpp"
+#include "RawNamespace/vector/std_interop.hpp"
+#include "RawNamespace/rcu/RawRcuVector.hpp"
+#include "RawNamespace/collector/RawThreadCollector.hpp"
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <string_view>
 #include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <stdexcept>
 #include <random>
+#include <queue>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <iterator>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <system_error>
+#include <fcntl.h>
 
 
 // Helper function to check vector contents
@@ -265,9 +295,10 @@ void testClearInt() {
     for (int i = 0; i < 5; ++i) {
         v[i] = i;
     }
+    size_t old_capacity = v.get_capacity();
     v.clear();
     assert(v.get_size() == 0);
-    assert(v.get_capacity() == 1); // Capacity should be reset to 1
+    assert(v.get_capacity() == old_capacity); // Capacity is kept for refilling
     std::cout << "clear() test for int passed.\n";
 }
 
@@ -728,6 +759,2102 @@ void testCombinedOperationsInt() {
     std::cout << "Combined operations test for int passed - STRESS TEST COMPLETE!\n";
 }
 
+void testBitVectorBasic() {
+    std::cout << "Testing bit_vector push_back/set/reset/test...\n";
+    raw::bit_vector bv;
+    std::vector<bool> ref;
+    for (size_t i = 0; i < 1000; ++i) {
+        bool bit = (i * 7) % 3 == 0;
+        bv.push_back(bit);
+        ref.push_back(bit);
+    }
+    bv.push_back_word(0xF0F0F0F0F0F0F0F0ull, 40);
+    for (size_t i = 0; i < 40; ++i) {
+        ref.push_back((0xF0F0F0F0F0F0F0F0ull >> i) & 1);
+    }
+    assert(bv.get_size() == ref.size());
+    assert(bv.get_word_count() == (ref.size() + 63) / 64);
+    for (size_t i = 0; i < ref.size(); ++i) {
+        assert(bv.test(i) == ref[i]);
+    }
+    bv.set(5);
+    bv.reset(0);
+    assert(bv.test(5) && !bv.test(0));
+    try {
+        bv.test(bv.get_size());
+        assert(false);
+    }
+    catch (const std::out_of_range& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    bv.resize(2000, true);
+    assert(bv.test(1999) && bv.test(1040));
+    bv.resize(70);
+    bv.resize(130);
+    assert(!bv.test(100));
+    std::cout << "bit_vector basic test passed.\n";
+}
+
+void testBitVectorBulkOps() {
+    std::cout << "Testing bit_vector bulk operations and count...\n";
+    const size_t n = 1234;
+    raw::bit_vector a(n), b(n);
+    for (size_t i = 0; i < n; ++i) {
+        a.set(i, i % 2 == 0);
+        b.set(i, i % 3 == 0);
+    }
+    raw::bit_vector and_v = a, or_v = a, xor_v = a, andnot_v = a;
+    and_v &= b;
+    or_v |= b;
+    xor_v ^= b;
+    andnot_v.and_not(b);
+    size_t and_count = 0, or_count = 0, xor_count = 0, andnot_count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        bool x = i % 2 == 0, y = i % 3 == 0;
+        assert(and_v[i] == (x && y));
+        assert(or_v[i] == (x || y));
+        assert(xor_v[i] == (x != y));
+        assert(andnot_v[i] == (x && !y));
+        and_count += x && y;
+        or_count += x || y;
+        xor_count += x != y;
+        andnot_count += x && !y;
+    }
+    assert(and_v.count() == and_count);
+    assert(or_v.count() == or_count);
+    assert(xor_v.count() == xor_count);
+    assert(andnot_v.count() == andnot_count);
+    raw::bit_vector ones(n, true);
+    assert(ones.count() == n);
+    try {
+        raw::bit_vector other(n + 1);
+        a &= other;
+        assert(false);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    std::cout << "bit_vector bulk operations test passed.\n";
+}
+
+void testBitVectorRankSelect() {
+    std::cout << "Testing bit_vector rank/select and find_next_set...\n";
+    const size_t n = 100000;
+    raw::bit_vector bv(n);
+    std::vector<size_t> positions;
+    std::mt19937 gen(42);
+    for (size_t i = 0; i < n; ++i) {
+        // sparse region in the middle so find_next_set has to skip zero words
+        bool bit = (i < 30000 || i > 70000) ? gen() % 4 == 0 : false;
+        if (bit) {
+            bv.set(i);
+            positions.push_back(i);
+        }
+    }
+    size_t k = 0;
+    for (size_t pos = bv.find_first(); pos != raw::bit_vector::npos; pos = bv.find_next_set(pos + 1)) {
+        assert(pos == positions[k++]);
+    }
+    assert(k == positions.size());
+    k = 0;
+    bv.for_each_set([&](size_t pos) { assert(pos == positions[k++]); });
+
+    bv.build_rank_select();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        assert(bv.select(i) == positions[i]);
+        assert(bv.rank(positions[i]) == i);
+        assert(bv.rank(positions[i] + 1) == i + 1);
+    }
+    assert(bv.rank(n) == positions.size());
+    assert(bv.select(positions.size()) == raw::bit_vector::npos);
+    bv.push_back(true);
+    try {
+        bv.rank(0);
+        assert(false);
+    }
+    catch (const std::logic_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    std::cout << "bit_vector rank/select test passed.\n";
+}
+
+struct ProfilerTestTag {
+    static constexpr const char* name = "profiler_test";
+};
+
+void testAllocProfiler() {
+    std::cout << "Testing allocation profiler...\n";
+#ifdef RAW_VECTOR_PROFILING
+    raw::profiling::reset_counters();
+    {
+        raw::tagged_vector<int, ProfilerTestTag> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i);
+        }
+        raw::profiling::tag_snapshot snap = raw::profiling::snapshot("profiler_test");
+        assert(snap.live_bytes == v.get_capacity() * sizeof(int));
+        assert(snap.slack_bytes == (v.get_capacity() - v.get_size()) * sizeof(int));
+        assert(snap.live_vectors == 1);
+        assert(snap.allocations == 1);
+        assert(snap.reallocations >= 7); // 1 -> 128 by doubling
+        assert(snap.relocations <= snap.reallocations);
+
+        raw::vector<std::string> named(raw::alloc_tag("profiler_strings"));
+        for (int i = 0; i < 10; ++i) {
+            named.push_back(std::to_string(i));
+        }
+        raw::vector<std::string> moved(std::move(named));
+        raw::profiling::tag_snapshot strings = raw::profiling::snapshot("profiler_strings");
+        assert(strings.live_bytes == moved.get_capacity() * sizeof(std::string));
+        assert(strings.bytes_moved > 0);
+
+        std::string json = raw::profiling::to_json();
+        assert(json.find("\"name\":\"profiler_test\"") != std::string::npos);
+        assert(json.find("\"histogram\":{") != std::string::npos);
+    }
+    raw::profiling::tag_snapshot after = raw::profiling::snapshot("profiler_test");
+    assert(after.live_bytes == 0);
+    assert(after.live_vectors == 0);
+    assert(after.frees == 1);
+#else
+    static_assert(std::is_empty<raw::alloc_tag>::value, "alloc_tag must be empty without profiling");
+    raw::tagged_vector<int, ProfilerTestTag> v(4);
+    raw::vector<int> named(raw::alloc_tag("unused"));
+    assert(v.get_size() == 4 && named.get_size() == 0);
+#endif
+    std::cout << "allocation profiler test passed.\n";
+}
+
+static size_t g_failed_bytes = 0;
+static void recordAllocFailure(size_t bytes) {
+    g_failed_bytes = bytes;
+}
+
+void testTryApi() {
+    std::cout << "Testing non-throwing try_* API...\n";
+    raw::vector<int> ints;
+    for (int i = 0; i < 10; ++i) {
+        assert(ints.try_push_back(i) == raw::status::ok);
+    }
+    assert(ints.get_size() == 10);
+    assert(ints.try_reserve(64) == raw::status::ok && ints.get_capacity() >= 64);
+    assert(ints.try_reserve(std::numeric_limits<size_t>::max()) == raw::status::length_error);
+    assert(ints.try_resize(std::numeric_limits<size_t>::max()) == raw::status::length_error);
+    assert(ints.get_size() == 10 && ints[9] == 9);
+    assert(ints.try_insert(11, 5) == raw::status::out_of_range);
+    assert(ints.try_insert(0, -1) == raw::status::ok && ints[0] == -1 && ints.get_size() == 11);
+    assert(ints.try_resize(3) == raw::status::ok && ints.get_size() == 3);
+
+    raw::vector<std::string> strings;
+    for (int i = 0; i < 20; ++i) {
+        assert(strings.try_push_back(std::to_string(i)) == raw::status::ok);
+    }
+    assert(strings.try_insert(25, std::string("x")) == raw::status::out_of_range);
+    assert(strings.try_insert(5, strings[0]) == raw::status::ok);
+    assert(strings[5] == "0" && strings[6] == "5" && strings.get_size() == 21);
+    assert(strings.try_reserve(std::numeric_limits<size_t>::max()) == raw::status::length_error);
+    assert(strings.try_resize(30) == raw::status::ok && strings[29].empty());
+    assert(strings.try_resize(2) == raw::status::ok && strings.get_size() == 2 && strings[1] == "1");
+
+    try {
+        ints.reserve(std::numeric_limits<size_t>::max());
+        assert(false);
+    }
+    catch (const std::length_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    assert(raw::get_alloc_failure_handler() == nullptr);
+    assert(raw::set_alloc_failure_handler(recordAllocFailure) == nullptr);
+    assert(raw::get_alloc_failure_handler() == recordAllocFailure);
+    try {
+        raw::detail::alloc_failure(123);
+        assert(false);
+    }
+    catch (const std::bad_alloc&) {
+        assert(g_failed_bytes == 123);
+    }
+    assert(raw::set_alloc_failure_handler(nullptr) == recordAllocFailure);
+    std::cout << "try_* API test passed.\n";
+}
+#if defined(RAW_HAS_CONSTEXPR_VECTOR) && !defined(RAW_VECTOR_PROFILING)
+constexpr raw::vector<uint32_t> makeCrcTable() {
+    raw::vector<uint32_t> table;
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table.push_back(c);
+    }
+    return table;
+}
+
+constexpr int constexprEditsInt() {
+    raw::vector<int> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i);
+    }
+    v.insert(0, 100);
+    v.erase(5);
+    v.pop_back();
+    v.resize(12);
+    v.reserve(40);
+    v.shrink_to_fit();
+    raw::vector<int> copied(v);
+    raw::vector<int> moved(std::move(copied));
+    int sum = 0;
+    for (int x : moved) {
+        sum += x;
+    }
+    return sum + int(moved.get_size());
+}
+
+struct ConstexprBox {
+    int value;
+    constexpr ConstexprBox(int v = 0) : value(v) {}
+    constexpr ConstexprBox(const ConstexprBox& other) : value(other.value) {}
+    constexpr ConstexprBox& operator=(const ConstexprBox& other) { value = other.value; return *this; }
+    constexpr ~ConstexprBox() {}
+};
+
+constexpr int constexprNonTrivial() {
+    raw::vector<ConstexprBox> v;
+    for (int i = 0; i < 20; ++i) {
+        v.push_back(ConstexprBox(i));
+    }
+    v.insert(3, ConstexprBox(50));
+    v.resize(25);
+    v.pop_back();
+    raw::vector<ConstexprBox> copied(v);
+    int sum = 0;
+    for (size_t i = 0; i < copied.get_size(); ++i) {
+        sum += copied[i].value;
+    }
+    return sum;
+}
+
+static_assert(!raw::myis_trivial<ConstexprBox>::value, "ConstexprBox must use vector_non_triv");
+static_assert(constexprEditsInt() == (100 + 0 + 1 + 2 + 3 + 5 + 6 + 7 + 8) + 12, "constexpr vector_triv edits");
+static_assert(constexprNonTrivial() == 190 + 50, "constexpr vector_non_triv edits");
+
+constexpr auto kCrcTable = raw::freeze<makeCrcTable>();
+static_assert(kCrcTable.size() == 256, "frozen table has the vector's size");
+static_assert(kCrcTable[1] == 0x77073096u && kCrcTable[255] == 0x2D02EF8Du, "CRC-32 table");
+#endif
+
+void testConstexprVector() {
+    std::cout << "Testing constexpr vector...\n";
+#if defined(RAW_HAS_CONSTEXPR_VECTOR) && !defined(RAW_VECTOR_PROFILING)
+    raw::vector<uint32_t> runtime = makeCrcTable();
+    assert(runtime.get_size() == kCrcTable.size());
+    for (size_t i = 0; i < kCrcTable.size(); ++i) {
+        assert(runtime[i] == kCrcTable[i]);
+    }
+    assert(constexprEditsInt() == (100 + 0 + 1 + 2 + 3 + 5 + 6 + 7 + 8) + 12);
+    std::cout << "constexpr vector test passed.\n";
+#else
+    std::cout << "constexpr vector test skipped (needs C++20, no profiling).\n";
+#endif
+}
+void testInplaceVectorTrivial() {
+    std::cout << "Testing inplace_vector (trivial)...\n";
+    using small_vec = raw::inplace_vector<int, 8>;
+    static_assert(std::is_same<small_vec, raw::inplace_vector_triv<int, 8>>::value, "int picks the trivial specialization");
+    static_assert(std::is_trivially_copyable<small_vec>::value, "trivial inplace_vector must be trivially copyable");
+    static_assert(sizeof(small_vec) == 8 * sizeof(int) + alignof(int), "size counter is one byte, padded to int");
+
+    small_vec v;
+    assert(v.empty() && v.get_capacity() == 8);
+    for (int i = 0; i < 8; ++i) {
+        v.push_back(i);
+    }
+    assert(v.try_push_back(8) == raw::status::length_error);
+    assert(v.get_size() == 8 && v.back() == 7);
+    try {
+        v.push_back(8);
+        assert(false);
+    }
+    catch (const std::length_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    v.erase(0);
+    v.insert(3, 100);
+    assert(v[0] == 1 && v[3] == 100 && v[4] == 4 && v.get_size() == 8);
+    assert(v.try_insert(0, 5) == raw::status::length_error);
+    v.pop_back();
+    assert(v.try_insert(9, 5) == raw::status::out_of_range);
+
+    small_vec copy = v;
+    std::memset(static_cast<void*>(&v), 0, sizeof(v));
+    assert(copy.get_size() == 7 && copy[3] == 100);
+
+    copy.resize(2);
+    copy.resize(5);
+    assert(copy[1] == 2 && copy[2] == 0 && copy[4] == 0);
+    assert(copy.try_resize(9) == raw::status::length_error && copy.get_size() == 5);
+
+    int sum = 0;
+    for (int x : copy) {
+        sum += x;
+    }
+    assert(sum == 3);
+    copy.clear();
+    assert(copy.empty());
+    std::cout << "inplace_vector (trivial) test passed.\n";
+}
+
+void testInplaceVectorNonTrivial() {
+    std::cout << "Testing inplace_vector (non-trivial)...\n";
+    using string_vec = raw::inplace_vector<std::string, 4>;
+    static_assert(std::is_same<string_vec, raw::inplace_vector_non_triv<std::string, 4>>::value, "std::string picks the non-trivial specialization");
+
+    string_vec v;
+    v.push_back("a");
+    v.push_back(std::string(40, 'b'));
+    v.insert(0, std::string("front"));
+    assert(v.get_size() == 3 && v[0] == "front" && v[1] == "a" && v[2].size() == 40);
+    v.unchecked_push_back("d");
+    assert(v.try_push_back("e") == raw::status::length_error);
+    assert(v.try_insert(1, v[0]) == raw::status::length_error);
+
+    string_vec copied(v);
+    string_vec moved(std::move(copied));
+    assert(moved.get_size() == 4 && moved[3] == "d");
+    moved.erase(1);
+    assert(moved[1].size() == 40 && moved.get_size() == 3);
+    moved.insert(1, moved[0]);
+    assert(moved[1] == "front");
+
+    v.resize(1);
+    v.swap(moved);
+    assert(v.get_size() == 4 && moved.get_size() == 1 && moved[0] == "front");
+    v.resize(2);
+    assert(v.get_size() == 2);
+    try {
+        v.resize(5);
+        assert(false);
+    }
+    catch (const std::length_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    std::cout << "inplace_vector (non-trivial) test passed.\n";
+}
+void testShrinkPolicy() {
+    std::cout << "Testing shrink policy, trim() and release()...\n";
+    raw::vector<int> v;
+    for (int i = 0; i < 1024; ++i) {
+        v.push_back(i);
+    }
+    assert(v.get_capacity() == 1024);
+    while (v.get_size() > 0) {
+        v.pop_back();
+    }
+    assert(v.get_capacity() == 1024); // default policy keeps everything
+    for (int i = 0; i < 1024; ++i) {
+        v.push_back(i);
+    }
+    assert(v.get_capacity() == 1024);
+
+    v.set_shrink_policy(raw::shrink_policy::quarter(16));
+    while (v.get_size() > 256) {
+        v.pop_back();
+    }
+    assert(v.get_capacity() == 1024);
+    v.pop_back();
+    assert(v.get_size() == 255 && v.get_capacity() == 510);
+    v.push_back(255);
+    v.pop_back();
+    assert(v.get_capacity() == 510); // no ping-pong at the boundary
+    assert(v[254] == 254);
+    v.erase(0);
+    assert(v.get_capacity() == 510);
+    v.resize(100); // 100 < 510 / 4
+    assert(v.get_capacity() == 200);
+    v.resize(10);
+    assert(v.get_capacity() == 20 && v[9] == 10);
+
+    raw::vector<int> copied(v);
+    assert(copied.get_shrink_policy().shrink_divisor == 4);
+    copied.clear();
+    assert(copied.get_capacity() == 16);
+
+    v.trim();
+    assert(v.get_capacity() == 16 && v.get_size() == 10);
+    v.release();
+    assert(v.get_capacity() == 0 && v.get_size() == 0);
+    v.push_back(7);
+    assert(v.get_size() == 1 && v[0] == 7);
+
+    raw::vector<std::string> strings;
+    for (int i = 0; i < 64; ++i) {
+        strings.push_back(std::to_string(i));
+    }
+    size_t string_capacity = strings.get_capacity();
+    strings.clear();
+    assert(strings.get_capacity() == string_capacity);
+    for (int i = 0; i < 64; ++i) {
+        strings.push_back(std::to_string(i));
+    }
+    assert(strings.get_capacity() == string_capacity);
+    strings.set_shrink_policy(raw::shrink_policy::quarter(4));
+    while (strings.get_size() > 3) {
+        strings.pop_back();
+    }
+    assert(strings.get_capacity() < string_capacity && strings[2] == "2");
+    strings.trim();
+    assert(strings.get_capacity() == 4);
+    strings.release();
+    assert(strings.get_capacity() == 0);
+    strings.push_back("again");
+    assert(strings[0] == "again");
+    std::cout << "shrink policy test passed.\n";
+}
+
+// Copy may throw once `copies_left` runs out; the move constructor is not noexcept,
+// so relocation has to copy and the strong guarantee must hold.
+struct ThrowingCopy {
+    static int copies_left;
+    std::string payload;
+    ThrowingCopy() = default;
+    ThrowingCopy(std::string p) : payload(std::move(p)) {}
+    ThrowingCopy(const ThrowingCopy& other) : payload(other.payload) {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    ThrowingCopy(ThrowingCopy&& other) noexcept(false) : payload(std::move(other.payload)) {}
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) = default;
+};
+int ThrowingCopy::copies_left = -1;
+
+// Counts live objects; move assignment throws once `assigns_left` reaches 0 (-1: never).
+struct ThrowingAssign {
+    static int live;
+    static int assigns_left;
+    int value;
+    ThrowingAssign(int v = 0) : value(v) { ++live; }
+    ThrowingAssign(const ThrowingAssign& other) : value(other.value) { ++live; }
+    ThrowingAssign(ThrowingAssign&& other) noexcept : value(other.value) { ++live; }
+    ThrowingAssign& operator=(const ThrowingAssign& other) { value = other.value; return *this; }
+    ThrowingAssign& operator=(ThrowingAssign&& other) {
+        if (assigns_left == 0) throw std::runtime_error("move assignment failed");
+        if (assigns_left > 0) --assigns_left;
+        value = other.value;
+        return *this;
+    }
+    ~ThrowingAssign() { --live; }
+};
+int ThrowingAssign::live = 0;
+int ThrowingAssign::assigns_left = -1;
+
+void testMoveNonTrivial() {
+    std::cout << "Testing non-trivial move and relocation...\n";
+    raw::vector<std::string> a;
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(std::to_string(i));
+    }
+    const std::string* buffer = &a[0];
+    raw::vector<std::string> b(std::move(a));
+    assert(&b[0] == buffer && b.get_size() == 100 && b[99] == "99");
+    assert(a.get_size() == 0 && a.get_capacity() == 0);
+    a.push_back("reused");
+    assert(a.get_size() == 1 && a[0] == "reused");
+
+    raw::vector<std::string> c(std::move(raw::vector<std::string>()));
+    c = std::move(b);
+    assert(&c[0] == buffer && c.get_size() == 100 && b.get_size() == 0);
+    c = std::move(c);
+    assert(c.get_size() == 100 && c[42] == "42");
+    b = std::move(a);
+    assert(b[0] == "reused" && a.get_capacity() == 0);
+
+    raw::vector<ThrowingCopy> guarded;
+    guarded.reserve(4);
+    for (int i = 0; i < 4; ++i) {
+        guarded.push_back(ThrowingCopy(std::to_string(i)));
+    }
+    ThrowingCopy::copies_left = 2;
+    try {
+        guarded.push_back(ThrowingCopy("4"));
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    ThrowingCopy::copies_left = -1;
+    assert(guarded.get_size() == 4 && guarded.get_capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(guarded[i].payload == std::to_string(i));
+    }
+    guarded.push_back(ThrowingCopy("4"));
+    assert(guarded.get_size() == 5 && guarded[4].payload == "4" && guarded[0].payload == "0");
+
+    // A throwing shift in insert() destroys the element it constructed at the end.
+    {
+        raw::vector<ThrowingAssign> shifted;
+        shifted.reserve(8);
+        for (int i = 0; i < 5; ++i) shifted.push_back(ThrowingAssign(i));
+        ThrowingAssign::assigns_left = 2;
+        bool threw = false;
+        try { shifted.insert(0, ThrowingAssign(-1)); }
+        catch (const std::runtime_error&) { threw = true; }
+        ThrowingAssign::assigns_left = -1;
+        assert(threw && shifted.get_size() == 5 && ThrowingAssign::live == 5);
+    }
+    assert(ThrowingAssign::live == 0);
+    std::cout << "non-trivial move test passed.\n";
+}
+
+void testGapBuffer() {
+    std::cout << "Testing gap_buffer...\n";
+    raw::gap_buffer<int> g;
+    assert(g.empty() && g.get_capacity() == 0);
+    for (int i = 0; i < 10; ++i) {
+        g.insert(i);
+    }
+    assert(g.get_size() == 10 && g.cursor() == 10);
+    g.move_cursor(3);
+    g.insert(100);
+    g.insert(101);
+    assert(g.cursor() == 5 && g[3] == 100 && g[4] == 101 && g[5] == 3);
+    g.erase_before();
+    g.erase_after(2);
+    assert(g.get_size() == 9 && g[3] == 100 && g[4] == 5 && g[8] == 9);
+    g.insert(0, -1);
+    g.erase(6, 1);
+    std::vector<int> expected = { -1, 0, 1, 2, 100, 5, 7, 8, 9 };
+    assert(g.get_size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        assert(g[i] == expected[i] && g.at(i) == expected[i]);
+    }
+    int block[3] = { 40, 41, 42 };
+    g.insert(2, block);
+    assert(g[2] == 40 && g[4] == 42 && g[5] == 1 && g.cursor() == 5);
+
+    raw::gap_buffer<int> copied(g);
+    raw::span<int> flat = copied.make_contiguous();
+    assert(copied.is_contiguous() && copied.cursor() == copied.get_size());
+    for (size_t i = 0; i < g.get_size(); ++i) {
+        assert(flat[i] == g[i]);
+    }
+    try {
+        g.move_cursor(g.get_size() + 1);
+        assert(false);
+    }
+    catch (const std::out_of_range& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    assert(g.try_move_cursor(100) == raw::status::out_of_range);
+    g.clear();
+    assert(g.empty() && g.gap_size() == g.get_capacity());
+
+    raw::gap_buffer<std::string> text;
+    std::string reference;
+    std::mt19937 gen(7);
+    for (int step = 0; step < 2000; ++step) {
+        size_t pos = gen() % (text.get_size() + 1);
+        if (text.get_size() > 0 && gen() % 3 == 0) {
+            pos = std::min(pos, text.get_size() - 1);
+            text.erase(pos);
+            reference.erase(pos, 1);
+        }
+        else {
+            char c = static_cast<char>('a' + gen() % 26);
+            text.insert(pos, std::string(20, c));
+            reference.insert(reference.begin() + pos, c);
+        }
+    }
+    assert(text.get_size() == reference.size());
+    for (size_t i = 0; i < reference.size(); ++i) {
+        assert(text[i] == std::string(20, reference[i]));
+    }
+    raw::gap_buffer<std::string> moved(std::move(text));
+    assert(text.get_capacity() == 0 && moved.get_size() == reference.size());
+    text = moved;
+    raw::span<std::string> joined = text.make_contiguous();
+    for (size_t i = 0; i < reference.size(); ++i) {
+        assert(joined[i][0] == reference[i]);
+    }
+    std::cout << "gap_buffer test passed.\n";
+}
+
+namespace {
+    long long sumSpan(raw::span<const int> values) {
+        long long total = 0;
+        for (int value : values) {
+            total += value;
+        }
+        return total;
+    }
+}
+
+void testSpan() {
+    std::cout << "Testing span...\n";
+    raw::vector<int> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    raw::span<int> all = v;
+    assert(all.get_data() == v.get_data() && all.get_size() == 100);
+    assert(sumSpan(v) == 4950);
+    const raw::vector<int>& cv = v;
+    raw::span<const int> read_only(cv);
+    assert(read_only.get_size() == 100 && sumSpan(read_only) == 4950);
+
+    raw::span<int> middle = all.subspan(10, 20);
+    assert(middle.front() == 10 && middle.back() == 29 && middle.get_size() == 20);
+    assert(all.first(3)[2] == 2 && all.last(3)[0] == 97 && all.subspan(95).get_size() == 5);
+    middle[0] = -10;
+    assert(v[10] == -10);
+    v[10] = 10;
+    assert(sumSpan(all.first(0)) == 0);
+    try {
+        all.subspan(50, 51);
+        assert(false);
+    }
+    catch (const std::out_of_range& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    raw::strided_span<int> evens = all.strided(2);
+    assert(evens.get_size() == 50 && evens[49] == 98);
+    raw::strided_span<int> odds = all.strided(2, 1);
+    int odd_count = 0;
+    for (int value : odds) {
+        assert(value % 2 == 1);
+        ++odd_count;
+    }
+    assert(odd_count == 50);
+    assert(all.subspan(0, 10).strided(3).get_size() == 4 && all.strided(3).strided(2)[1] == 6);
+
+    raw::span_chunks<int> parts = all.chunks(30);
+    assert(parts.get_size() == 4 && parts[3].get_size() == 10 && parts[3].front() == 90);
+    size_t covered = 0;
+    long long chunked_sum = 0;
+    for (raw::span<int> part : parts) {
+        assert(part.get_data() == v.get_data() + covered);
+        covered += part.get_size();
+        chunked_sum += sumSpan(part);
+    }
+    assert(covered == 100 && chunked_sum == 4950);
+
+    raw::inplace_vector<int, 8> small;
+    small.push_back(5);
+    small.push_back(6);
+    std::vector<int> standard = { 1, 2, 3 };
+    int array[4] = { 1, 1, 1, 1 };
+    assert(sumSpan(small) == 11 && sumSpan(standard) == 6 && sumSpan(array) == 4);
+    raw::span deduced(standard);
+    static_assert(std::is_same<decltype(deduced), raw::span<int>>::value, "deduces the element type");
+
+    raw::vector<std::string> words;
+    words.push_back("b");
+    words.push_back("a");
+    raw::span<std::string> word_view = words;
+    std::sort(word_view.begin(), word_view.end());
+    assert(words[0] == "a" && words[1] == "b");
+    std::cout << "span test passed.\n";
+}
+
+void testExpressions() {
+    std::cout << "Testing expression templates...\n";
+    raw::vector<float> a, b, d;
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(static_cast<float>(i));
+        b.push_back(2.0f);
+        d.push_back(static_cast<float>(100 - i));
+    }
+    raw::vector<float> c = a * b + d;
+    assert(c.get_size() == 100);
+    for (int i = 0; i < 100; ++i) {
+        assert(c[i] == static_cast<float>(i + 100));
+    }
+    c = -(c - 100.0f) / 2.0f;
+    assert(c[10] == -5.0f && c[0] == 0.0f);
+    c = raw::where(a > 49.0f, a, 0.0f);
+    assert(c[49] == 0.0f && c[50] == 50.0f);
+    assert(raw::count(a >= 90.0f) == 10 && raw::count(raw::equal(b, 2.0f)) == 100);
+    assert(raw::sum(a) == 4950.0f && raw::dot(a, b) == 9900.0f);
+    assert(raw::min_value(d - a) == -98.0f && raw::max_value(raw::abs(d - a)) == 100.0f);
+    assert(raw::any(a > 98.0f) && !raw::any(a > 99.0f) && raw::all(b > 1.0f) && !raw::all(a > 0.0f));
+    assert(raw::sum(raw::maximum(a, 95.0f)) == 95.0f * 96 + 96 + 97 + 98 + 99);
+    assert(raw::sqrt(b * 8.0f).get_size() == 100 && raw::eval(raw::sqrt(b * 8.0f))[3] == 4.0f);
+
+    // Same-position aliasing is element-wise safe; shifted aliasing goes through a temporary.
+    c = a;
+    c = c * 2.0f + c;
+    assert(c[7] == 21.0f);
+    raw::span<float> all = c;
+    c = all.subspan(1) - all.first(99);
+    assert(c.get_size() == 99 && c[0] == 3.0f && c[98] == 3.0f);
+    raw::vector<int> ramp;
+    for (int i = 0; i < 10; ++i) {
+        ramp.push_back(i);
+    }
+    raw::span<int> r = ramp;
+    raw::assign(r.subspan(1), r.first(9) * 10);
+    assert(ramp[0] == 0 && ramp[1] == 0 && ramp[2] == 10 && ramp[9] == 80);
+
+    raw::vector<int> mask = a < 3.0f;
+    assert(mask.get_size() == 100 && mask[2] == 1 && mask[3] == 0);
+
+    // where() evaluates both sides: guard an integer division on its divisor, not its result.
+    raw::vector<int> num, den;
+    for (int i = 0; i < 9; ++i) {
+        num.push_back(10 * i);
+        den.push_back(i % 3);
+    }
+    raw::vector<int> quotient = raw::where(raw::not_equal(den, 0), num / raw::where(raw::not_equal(den, 0), den, 1), 0);
+    for (int i = 0; i < 9; ++i) {
+        assert(quotient[i] == (i % 3 ? 10 * i / (i % 3) : 0));
+    }
+    raw::vector<float> small(3);
+    try {
+        c = a + small;
+        assert(false);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    try {
+        raw::min_value(raw::span<float>(small).first(0) * 1.0f);
+        assert(false);
+    }
+    catch (const std::out_of_range& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    std::cout << "expression templates test passed.\n";
+}
+
+void testIteratorConformance() {
+    std::cout << "Testing iterator conformance...\n";
+    using It = raw::vector<int>::Iterator;
+    using CIt = raw::vector<int>::const_iterator;
+    static_assert(std::is_same<std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>::value, "random access");
+    static_assert(std::is_same<std::iterator_traits<It>::difference_type, std::ptrdiff_t>::value, "signed difference");
+    static_assert(std::is_same<std::iterator_traits<CIt>::value_type, int>::value, "value_type drops const");
+    static_assert(std::is_trivially_copyable<It>::value, "iterator is a wrapped pointer");
+#ifdef __cpp_lib_concepts
+    static_assert(std::contiguous_iterator<It> && std::contiguous_iterator<CIt>, "contiguous");
+    static_assert(std::contiguous_iterator<raw::vector<std::string>::Iterator>, "contiguous for non-trivial too");
+    static_assert(std::random_access_iterator<raw::vector<int>::reverse_iterator>, "reverse iterators");
+#endif
+
+    raw::vector<int> v;
+    for (int i = 0; i < 5; ++i) {
+        v.push_back(i);
+    }
+    assert(v.begin() - v.end() == -5 && v.end() - v.begin() == 5);
+    assert(v.begin()[3] == 3 && (v.end() - 2)[1] == 4);
+    It it = v.end();
+    It old = it--;
+    assert(old == v.end() && *it == 4);
+    CIt cit = v.begin();
+    assert(cit == v.begin() && cit < v.end());
+#ifdef __cpp_lib_to_address
+    assert(std::to_address(v.begin()) == v.get_data());
+#endif
+
+    std::vector<int> reversed(v.rbegin(), v.rend());
+    assert((reversed == std::vector<int>{ 4, 3, 2, 1, 0 }));
+    const raw::vector<int>& cv = v;
+    assert(*cv.rbegin() == 4 && std::distance(cv.crbegin(), cv.crend()) == 5);
+    raw::vector<int> empty;
+    assert(empty.rbegin() == empty.rend());
+
+    raw::vector<int> shuffled;
+    std::mt19937 gen(11);
+    for (int i = 0; i < 1000; ++i) {
+        shuffled.push_back(static_cast<int>(gen() % 500));
+    }
+    std::sort(shuffled.begin(), shuffled.end());
+    assert(std::is_sorted(shuffled.begin(), shuffled.end()));
+    auto lower = std::lower_bound(shuffled.begin(), shuffled.end(), 250);
+    assert(lower == shuffled.end() || *lower >= 250);
+    assert(lower == shuffled.begin() || *(lower - 1) < 250);
+
+    raw::vector<int> target(5);
+    std::copy(v.begin(), v.end(), target.begin());
+    std::copy_backward(target.begin(), target.begin() + 3, target.end());
+    assert(target[0] == 0 && target[2] == 0 && target[3] == 1 && target[4] == 2);
+
+    raw::inplace_vector<int, 4> small;
+    small.push_back(1);
+    small.push_back(2);
+    assert(*small.rbegin() == 2 && small.rend() - small.rbegin() == 2);
+    std::cout << "iterator conformance test passed.\n";
+}
+
+void testRadixSort() {
+    std::cout << "Testing radix sort...\n";
+    std::mt19937_64 gen(38);
+
+    // Every size through the sorting network, plus the first radix sizes.
+    for (size_t n = 0; n <= 40; ++n) {
+        raw::vector<int32_t> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(static_cast<int32_t>(gen() % 200) - 100);
+        }
+        std::vector<int32_t> expected(v.begin(), v.end());
+        std::sort(expected.begin(), expected.end());
+        raw::radix_sort(v);
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+
+    // Every digit width and the parallel path agree with std::sort.
+    std::vector<uint64_t> source(200000);
+    for (auto& x : source) {
+        x = gen();
+    }
+    std::vector<uint64_t> expected = source;
+    std::sort(expected.begin(), expected.end());
+    for (unsigned bits : { 0u, 8u, 11u, 16u, 5u }) {
+        raw::vector<uint64_t> v;
+        v.reserve(source.size());
+        for (uint64_t x : source) {
+            v.push_back(x);
+        }
+        raw::radix_options options;
+        options.digit_bits = bits;
+        options.threads = bits == 11 ? 4 : 1;
+        raw::radix_sort(v, options);
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+
+    // Keys that share their high digits, and already sorted input.
+    std::vector<uint32_t> narrow(5000);
+    for (auto& x : narrow) {
+        x = 0xABCD0000u | static_cast<uint32_t>(gen() % 300);
+    }
+    std::vector<uint32_t> narrow_sorted = narrow;
+    std::sort(narrow_sorted.begin(), narrow_sorted.end());
+    raw::radix_sort(narrow);
+    assert(narrow == narrow_sorted);
+    raw::radix_sort(narrow);
+    assert(narrow == narrow_sorted);
+
+    // Floating point: negatives, signed zeros, infinities.
+    raw::vector<double> d;
+    for (int i = 0; i < 1000; ++i) {
+        d.push_back((static_cast<double>(gen() % 20001) - 10000.0) / 7.0);
+    }
+    d.push_back(-0.0);
+    d.push_back(0.0);
+    d.push_back(std::numeric_limits<double>::infinity());
+    d.push_back(-std::numeric_limits<double>::infinity());
+    raw::radix_sort(d);
+    assert(std::is_sorted(d.begin(), d.end()));
+    assert(d[0] == -std::numeric_limits<double>::infinity() && d[d.get_size() - 1] == std::numeric_limits<double>::infinity());
+    auto zero = std::lower_bound(d.begin(), d.end(), 0.0);
+    assert(std::signbit(*zero) && *(zero + 1) == 0.0 && !std::signbit(*(zero + 1)));
+    float small[5] = { 2.5f, -1.0f, 0.0f, -0.0f, -7.25f };
+    raw::radix_sort(small);
+    assert(small[0] == -7.25f && small[1] == -1.0f && std::signbit(small[2]) && small[4] == 2.5f);
+
+    // Records are sorted stably by key.
+    struct record {
+        int16_t key;
+        uint32_t seq;
+    };
+    raw::vector<record> records;
+    for (uint32_t i = 0; i < 3000; ++i) {
+        records.push_back(record{ static_cast<int16_t>(static_cast<int>(gen() % 50) - 25), i });
+    }
+    raw::radix_sort_by_key(records, [](const record& r) { return r.key; });
+    for (size_t i = 1; i < records.get_size(); ++i) {
+        assert(records[i - 1].key < records[i].key ||
+            (records[i - 1].key == records[i].key && records[i - 1].seq < records[i].seq));
+    }
+
+    // argsort leaves the keys alone and is stable.
+    std::vector<float> scores = { 3.0f, -1.0f, 3.0f, 0.5f, -1.0f };
+    raw::vector<uint32_t> order = raw::argsort(scores);
+    assert(order.get_size() == 5 && order[0] == 1 && order[1] == 4 && order[2] == 3 && order[3] == 0 && order[4] == 2);
+    assert(scores[0] == 3.0f);
+    raw::vector<int64_t> big;
+    for (int i = 0; i < 500; ++i) {
+        big.push_back(static_cast<int64_t>(gen() % 100) - 50);
+    }
+    raw::vector<size_t> big_order = raw::argsort<size_t>(big);
+    for (size_t i = 1; i < big_order.get_size(); ++i) {
+        assert(big[big_order[i - 1]] < big[big_order[i]] ||
+            (big[big_order[i - 1]] == big[big_order[i]] && big_order[i - 1] < big_order[i]));
+    }
+
+    bool threw = false;
+    try {
+        raw::radix_options options;
+        options.digit_bits = 17;
+        raw::radix_sort(big, options);
+    }
+    catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "radix sort test passed.\n";
+}
+
+void testFlatHashMap() {
+    std::cout << "Testing flat hash map...\n";
+    // Random inserts, overwrites, erases and lookups against std::unordered_map.
+    raw::flat_hash_map<uint64_t, int> map;
+    std::unordered_map<uint64_t, int> expected;
+    std::mt19937_64 gen(39);
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t key = gen() % 3000;
+        switch (gen() % 3) {
+        case 0:
+            map[key] = i;
+            expected[key] = i;
+            break;
+        case 1:
+            assert(map.erase(key) == expected.erase(key));
+            break;
+        default: {
+            auto it = map.find(key);
+            auto jt = expected.find(key);
+            assert((it == map.end()) == (jt == expected.end()));
+            assert(jt == expected.end() || it->second == jt->second);
+        }
+        }
+        assert(map.get_size() == expected.size());
+    }
+    size_t visited = 0;
+    for (const auto& kv : map) {
+        assert(expected.at(kv.first) == kv.second);
+        ++visited;
+    }
+    assert(visited == expected.size());
+    // Tombstone churn is cleaned up by rehashing, not by growing forever.
+    assert(map.get_capacity() < 16 * 1024);
+
+    // Erasing while iterating.
+    for (auto it = map.begin(); it != map.end();) {
+        if (it->first % 2)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+    for (const auto& kv : map) {
+        assert(kv.first % 2 == 0 && map.contains(kv.first));
+    }
+
+    // reserve() avoids rehashing.
+    raw::flat_hash_map<int, int> reserved;
+    reserved.reserve(1000);
+    size_t capacity = reserved.get_capacity();
+    for (int i = 0; i < 1000; ++i) {
+        reserved.try_emplace(i, i * 2);
+    }
+    assert(reserved.get_capacity() == capacity && reserved.get_size() == 1000);
+    assert(reserved.load_factor() <= 0.875f);
+
+    // Insert variants.
+    raw::flat_hash_map<std::string, std::string> names;
+    assert(names.try_emplace("a", "first").second);
+    assert(!names.try_emplace("a", "second").second && names.at("a") == "first");
+    assert(!names.insert_or_assign("a", "third").second && names.at("a") == "third");
+    assert(names.insert({ "b", "bee" }).second);
+    assert(names.emplace("c", "sea").second && !names.emplace("c", "x").second);
+    names["d"];
+    assert(names.get_size() == 4 && names.at("d").empty());
+
+    // Values taken from the map itself survive the rehash they trigger.
+    raw::flat_hash_map<int, std::string> self;
+    self[0] = std::string(100, 'z');
+    for (int i = 1; i < 100; ++i) {
+        self.try_emplace(i, self.at(0));
+        self.insert_or_assign(-i, self.at(i - 1));
+    }
+    for (int i = -99; i < 100; ++i)
+        assert(self.at(i) == std::string(100, 'z'));
+
+    // Heterogeneous lookup: no std::string is built for these.
+    std::string_view view = "b";
+    assert(names.find(view) != names.end() && names.find(view)->second == "bee");
+    assert(names.contains("c") && names.count("zzz") == 0);
+    assert(names.erase(std::string_view("c")) == 1 && !names.contains("c"));
+    bool threw = false;
+    try {
+        names.at("missing");
+    }
+    catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Copies are deep, moves steal.
+    raw::flat_hash_map<std::string, std::string> copy = names;
+    copy["a"] = "changed";
+    assert(names.at("a") == "third");
+    raw::flat_hash_map<std::string, std::string> moved = std::move(copy);
+    assert(moved.at("a") == "changed" && copy.get_size() == 0 && copy.begin() == copy.end());
+    moved.clear();
+    assert(moved.empty() && moved.find("a") == moved.end());
+
+    // Sets.
+    raw::flat_hash_set<std::string> set;
+    assert(set.insert("x").second && !set.insert("x").second);
+    set.emplace(3, 'y');
+    assert(set.contains("yyy") && set.get_size() == 2);
+    const raw::flat_hash_map<uint64_t, int>& cmap = map;
+    assert(cmap.begin() == cmap.end() || cmap.find(cmap.begin()->first) == cmap.begin());
+    std::cout << "flat hash map test passed.\n";
+}
+
+void testSlotMap() {
+    std::cout << "Testing slot map...\n";
+    // Random inserts and erases against std::unordered_map, checking every live handle.
+    raw::slot_map<int> map;
+    std::unordered_map<uint64_t, int> expected;
+    std::vector<raw::slot_handle> live, dead;
+    auto key = [](raw::slot_handle h) { return (uint64_t(h.index) << 32) | h.generation; };
+    std::mt19937 gen(40);
+    for (int i = 0; i < 20000; ++i) {
+        if (live.empty() || gen() % 3) {
+            raw::slot_handle h = map.insert(i);
+            assert(expected.emplace(key(h), i).second);
+            live.push_back(h);
+        }
+        else {
+            size_t pick = gen() % live.size();
+            raw::slot_handle h = live[pick];
+            assert(map.erase(h) && !map.erase(h));
+            expected.erase(key(h));
+            live[pick] = live.back();
+            live.pop_back();
+            dead.push_back(h);
+        }
+    }
+    assert(map.get_size() == live.size() && map.slot_count() < 20000);
+    for (raw::slot_handle h : live)
+        assert(map.contains(h) && *map.get(h) == expected[key(h)] && map.at(h) == map[h]);
+    for (raw::slot_handle h : dead)
+        assert(!map.contains(h) && map.get(h) == nullptr);
+    assert(!map.contains(raw::slot_handle{}));
+
+    // Dense iteration visits every element once; handle_at maps back to the handles.
+    long long sum = 0, expected_sum = 0;
+    for (int v : map) sum += v;
+    for (const auto& kv : expected) expected_sum += kv.second;
+    assert(sum == expected_sum && map.values_span().get_size() == map.get_size());
+    for (size_t i = 0; i < map.get_size(); ++i)
+        assert(map.get(map.handle_at(i)) == map.get_data() + i);
+
+    bool threw = false;
+    try { map.at(dead.front()); }
+    catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+
+    // clear() invalidates every handle and keeps the slots for reuse.
+    size_t slots = map.slot_count();
+    map.clear();
+    assert(map.empty() && map.slot_count() == slots);
+    for (raw::slot_handle h : live)
+        assert(!map.contains(h));
+    raw::slot_handle reused = map.insert(7);
+    assert(reused.index < slots && map[reused] == 7);
+
+    // Non-trivial elements survive the swap-and-pop moves.
+    raw::slot_map<std::string> names;
+    raw::slot_handle a = names.emplace(40, 'a');
+    raw::slot_handle b = names.insert("bob");
+    raw::slot_handle c = names.insert(std::string("carol"));
+    assert(names.erase(a));
+    assert(names.get_size() == 2 && names[b] == "bob" && names[c] == "carol");
+    raw::slot_handle d = names.insert("dave");
+    assert(d.index == a.index && d.generation != a.generation && !names.contains(a));
+    raw::slot_map<std::string> copy = names;
+    names.clear();
+    assert(copy.at(d) == "dave" && copy.at(c) == "carol");
+    std::cout << "slot map test passed.\n";
+}
+
+void testEraseIf() {
+    std::cout << "Testing erase_if and erase_unordered...\n";
+    // Random keep/remove patterns against std::remove_if, for every element width.
+    std::mt19937_64 gen(41);
+    auto check = [&gen](auto tag, int percent) {
+        using T = decltype(tag);
+        for (size_t n : {0, 1, 7, 8, 9, 31, 100, 1000}) {
+            raw::vector<T> v;
+            std::vector<T> expected;
+            for (size_t i = 0; i < n; ++i) {
+                T x = static_cast<T>(gen() % 100);
+                v.push_back(x);
+                expected.push_back(x);
+            }
+            size_t calls = 0;
+            auto drop = [percent](T x) { return static_cast<int>(x) < percent; };
+            size_t removed = raw::erase_if(v, [&](const T& x) { ++calls; return drop(x); });
+            size_t before = expected.size();
+            expected.erase(std::remove_if(expected.begin(), expected.end(), drop), expected.end());
+            assert(calls == n && removed == before - expected.size());
+            assert(compareVectors(v, expected));
+        }
+    };
+    for (int percent : {0, 10, 50, 90, 100}) {
+        check(uint8_t(), percent);
+        check(int16_t(), percent);
+        check(int(), percent);
+        check(float(), percent);
+        check(uint64_t(), percent);
+        check(double(), percent);
+    }
+
+    raw::vector<int> ints;
+    for (int i = 0; i < 20; ++i) ints.push_back(i % 4);
+    assert(raw::erase(ints, ints[1]) == 5 && ints.get_size() == 15);
+    for (int x : ints) assert(x != 1);
+    assert(raw::erase(ints, 7) == 0 && ints.get_size() == 15);
+
+    // Non-trivial elements: kept ones are moved, removed ones destroyed.
+    raw::vector<std::string> words;
+    std::vector<std::string> expected_words;
+    for (int i = 0; i < 200; ++i) {
+        std::string w = "word number " + std::to_string(i % 7);
+        words.push_back(w);
+        if (i % 7 != 3 && i % 7 != 5) expected_words.push_back(w);
+    }
+    raw::erase(words, std::string("word number 3"));
+    raw::erase_if(words, [](const std::string& w) { return w.back() == '5'; });
+    assert(compareVectors(words, expected_words));
+
+    // erase() keeps the order, erase_unordered() moves the last element in.
+    words.erase(0);
+    expected_words.erase(expected_words.begin());
+    assert(compareVectors(words, expected_words));
+    std::string last = words.back();
+    words.erase_unordered(1);
+    assert(words[1] == last && words.get_size() == expected_words.size() - 1);
+    words.erase_unordered(words.get_size() - 1);
+    assert(words.get_size() == expected_words.size() - 2);
+    ints.erase_unordered(0);
+    assert(ints[0] == 3 && ints.get_size() == 14);
+    bool threw = false;
+    try { ints.erase_unordered(14); }
+    catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+    std::cout << "erase_if and erase_unordered test passed.\n";
+}
+
+void testFdIO() {
+    std::cout << "Testing file descriptor I/O...\n";
+    raw::vector<char> payload;
+    for (size_t i = 0; i < 300000; ++i) payload.push_back(static_cast<char>('a' + i % 26));
+
+    // Regular file: gathered write, then one exact-sized read up to EOF.
+    char path[] = "/tmp/raw_fd_io_XXXXXX";
+    int file = mkstemp(path);
+    assert(file >= 0);
+    unlink(path);
+    std::string header = "header:";
+    assert(raw::write_to_fd(file, header, payload, std::string()) == header.size() + payload.get_size());
+    assert(lseek(file, 0, SEEK_SET) == 0);
+    raw::vector<char> in;
+    in.push_back('>');
+    raw::fd_read_result r = raw::append_from_fd(in, file);
+    assert(r.eof && r.bytes == header.size() + payload.get_size());
+    assert(in.get_size() == 1 + r.bytes && in[0] == '>');
+    assert(std::memcmp(in.get_data() + 1, header.data(), header.size()) == 0);
+    assert(std::memcmp(in.get_data() + 1 + header.size(), payload.get_data(), payload.get_size()) == 0);
+
+    // `max_bytes` stops early; the rest is still there.
+    assert(lseek(file, 0, SEEK_SET) == 0);
+    raw::vector<unsigned char> part;
+    r = raw::append_from_fd(part, file, 10);
+    assert(r.bytes == 10 && !r.eof && part.get_size() == 10 && part[7] == 'a');
+    r = raw::append_from_fd(part, file);
+    assert(r.eof && part.get_size() == in.get_size() - 1);
+    close(file);
+
+    // Pipe fed by a writer thread: read until EOF, in however many calls it takes.
+    int fds[2];
+    assert(pipe(fds) == 0);
+    std::thread writer([&] {
+        size_t written = raw::write_to_fd(fds[1], raw::span<const char>(payload.get_data(), payload.get_size()));
+        assert(written == payload.get_size());
+        close(fds[1]);
+    });
+    raw::vector<char> piped;
+    for (;;) {
+        r = raw::append_from_fd(piped, fds[0]);
+        if (r.eof) break;
+        assert(r.bytes > 0);
+    }
+    writer.join();
+    assert(piped.get_size() == payload.get_size());
+    assert(std::memcmp(piped.get_data(), payload.get_data(), payload.get_size()) == 0);
+    close(fds[0]);
+
+    // Non-blocking ends: EAGAIN stops the call without an error.
+    assert(pipe(fds) == 0);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    raw::vector<char> empty;
+    r = raw::append_from_fd(empty, fds[0]);
+    assert(r.bytes == 0 && !r.eof && empty.get_size() == 0);
+    size_t accepted = raw::write_to_fd(fds[1], payload);
+    assert(accepted > 0 && accepted < payload.get_size());
+    raw::vector<char> drained;
+    r = raw::append_from_fd(drained, fds[0]);
+    assert(r.bytes == accepted && !r.eof);
+    assert(std::memcmp(drained.get_data(), payload.get_data(), accepted) == 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    bool threw = false;
+    try { raw::append_from_fd(drained, -1); }
+    catch (const std::system_error& e) { threw = e.code().value() == EBADF; }
+    assert(threw);
+    std::cout << "file descriptor I/O test passed.\n";
+}
+
+void testVmVector() {
+    std::cout << "Testing vm_vector...\n";
+    // Growth commits pages in place: the first element never moves.
+    raw::vm_vector<uint64_t> v;
+    v.push_back(0);
+    const uint64_t* first = &v[0];
+    for (uint64_t i = 1; i < 1000000; ++i) {
+        v.push_back(v[i - 1] + 1);
+        assert(&v[0] == first);
+    }
+    assert(v.get_size() == 1000000 && v.back() == 999999);
+    assert(v.get_capacity() >= v.get_size() && v.get_reserved_size() >= (size_t(1) << 20));
+
+    // Shrinking decommits past the last element; regrowth zeroes and stays in place.
+    v.resize(10);
+    v.shrink_to_fit();
+    assert(v.get_capacity() < 100000 && &v[0] == first && v[9] == 9);
+    v.resize(200000);
+    assert(&v[0] == first && v[10] == 0 && v[199999] == 0);
+
+    // Same member API as vector_triv.
+    raw::vm_vector<int> w(5);
+    w[2] = 7;
+    w.insert(0, 1);
+    w.insert(w.begin() + 6, 9);
+    w.erase(1);
+    w.erase_unordered(0);
+    assert(w.get_size() == 5 && w[0] == 9 && w.at(2) == 7);
+    std::sort(w.begin(), w.end());
+    assert(w.front() == 0 && w.back() == 9);
+    raw::span<int> view(w);
+    assert(view.get_size() == 5 && view.begin() == w.get_data());
+    w.reserve_spare(3);
+    w.spare_data()[0] = 4;
+    w.commit_spare(1);
+    assert(w.get_size() == 6 && w[5] == 4);
+    assert(*w.crbegin() == 4 && w.crend() - w.crbegin() == 6);
+    static_assert(raw::vm_vector<int>::max_size() == raw::vector<int>::max_size(), "same static bound");
+    raw::vm_vector<int> tagged(raw::alloc_tag("vm")), tagged_sized(3, raw::alloc_tag("vm"));
+    assert(tagged.empty() && tagged_sized.get_size() == 3 && tagged_sized[2] == 0);
+
+    // A shrink policy decommits pages as the size drops, in place.
+    raw::vm_vector<uint64_t> policed;
+    policed.set_shrink_policy(raw::shrink_policy::quarter(16));
+    assert(policed.get_shrink_policy().shrink_divisor == 4);
+    policed.resize(1 << 20);
+    const uint64_t* base = policed.get_data();
+    while (policed.get_size() > 1000)
+        policed.pop_back();
+    assert(policed.get_capacity() < (size_t(1) << 18) && policed.get_data() == base);
+    raw::vm_vector<uint64_t> inherits = policed;
+    assert(inherits.get_shrink_policy().shrink_divisor == 4);
+
+    raw::vm_vector<int> copy = w;
+    assert(copy.get_size() == w.get_size() && copy.get_data() != w.get_data() && copy[5] == 4);
+    raw::vm_vector<int> moved = std::move(copy);
+    assert(moved.get_size() == 6 && copy.get_size() == 0 && copy.get_data() == nullptr);
+    moved.release();
+    assert(moved.empty() && moved.get_capacity() == 0);
+    moved.push_back(3);
+    assert(moved[0] == 3);
+
+    // The reservation is a hard limit.
+    raw::vm_vector<char> small(raw::vm_reservation{ 100 });
+    assert(small.get_reserved_size() == small.get_reserved_bytes() && small.get_reserved_size() >= 100);
+    small.resize(small.get_reserved_size());
+    assert(small.try_push_back('x') == raw::status::length_error);
+    bool threw = false;
+    try { small.push_back('x'); }
+    catch (const std::length_error&) { threw = true; }
+    assert(threw);
+    std::cout << "vm_vector test passed.\n";
+}
+
+namespace poly_test {
+    int live = 0;
+
+    struct Shape {
+        virtual ~Shape() = default;
+        virtual double area() const = 0;
+    };
+
+    struct Square final : Shape {
+        double side;
+        explicit Square(double side_) : side(side_) {}
+        double area() const override { return side * side; }
+    };
+
+    struct Label final : Shape {
+        std::string text;
+        explicit Label(std::string text_) : text(std::move(text_)) { ++live; }
+        Label(const Label& other) : Shape(), text(other.text) { ++live; }
+        Label(Label&& other) noexcept : Shape(), text(std::move(other.text)) { ++live; }
+        ~Label() override { --live; }
+        double area() const override { return static_cast<double>(text.size()); }
+    };
+
+    struct alignas(64) Block final : Shape {
+        double cells[3] = { 1, 2, 3 };
+        double area() const override { return cells[0] + cells[1] + cells[2]; }
+    };
+}
+
+void testPolyVector() {
+    using namespace poly_test;
+    std::cout << "Testing poly_vector...\n";
+    {
+        raw::poly_vector<Shape> v;
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back<Square>(i);
+            v.emplace_back<Label>(std::string(static_cast<size_t>(i % 40), 'x'));
+            if (i % 10 == 0) v.emplace_back<Block>();
+        }
+        assert(v.get_size() == 210 && live == 100);
+        assert(v.get_byte_size() <= v.get_byte_capacity());
+
+        // Strings and 64-byte alignment survive growth and realignment.
+        double total = 0;
+        size_t blocks = 0;
+        for (size_t i = 0; i < v.get_size(); ++i) {
+            if (v.is<Block>(i)) {
+                assert(reinterpret_cast<uintptr_t>(&v[i]) % 64 == 0);
+                ++blocks;
+            }
+            total += v[i].area();
+        }
+        assert(blocks == 10);
+        assert(v.get_if<Square>(0) && v.get_if<Square>(0)->side == 0 && !v.get_if<Label>(0));
+        assert(v.get_if<Label>(4)->text == std::string(1, 'x'));
+
+        // Exact-type iteration and grouping keep per-type order.
+        double squares = 0;
+        v.for_each<Square>([&](Square& s) { squares += s.area(); });
+        v.group_by_type();
+        assert(v.get_size() == 210 && live == 100);
+        for (size_t i = 0; i < 100; ++i) {
+            assert(v.is<Square>(i) && v.get_if<Square>(i)->side == static_cast<double>(i));
+            assert(v.is<Label>(100 + i) && v.get_if<Label>(100 + i)->text.size() == i % 40);
+        }
+        for (size_t i = 200; i < 210; ++i) assert(v.is<Block>(i) && reinterpret_cast<uintptr_t>(&v[i]) % 64 == 0);
+        double regrouped = 0;
+        for (const Shape& s : v) regrouped += s.area();
+        assert(regrouped == total);
+        double squares_after = 0;
+        v.for_each<Square>([&](const Square& s) { squares_after += s.area(); });
+        assert(squares_after == squares);
+
+        // Removal and moves.
+        v.pop_back();
+        assert(v.get_size() == 209 && v.back().area() == 6);
+        raw::poly_vector<Shape> w(std::move(v));
+        assert(v.empty() && w.get_size() == 209 && live == 100);
+        Label& pushed = w.push_back(Label("moved"));
+        assert(pushed.text == "moved" && live == 101);
+        w.reserve(w.get_size() + 10, w.get_byte_capacity() * 2);
+        assert(w.back().area() == 5 && w.at(100).area() == 0);
+        bool threw = false;
+        try { (void)w.at(1000); }
+        catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+        w.clear();
+        assert(w.empty() && live == 0);
+        w.emplace_back<Label>("again");
+    }
+    assert(live == 0);
+    std::cout << "poly_vector tests passed.\n";
+}
+
+namespace heap_test {
+    /// Writes each element's heap position into a side table indexed by element id.
+    struct PositionTable {
+        std::vector<size_t>* positions;
+        void operator()(const std::pair<int, int>& item, size_t pos) const { (*positions)[static_cast<size_t>(item.second)] = pos; }
+    };
+
+    template<typename Heap, typename Ref>
+    void drain_and_compare(Heap& heap, Ref& ref) {
+        assert(heap.get_size() == ref.size());
+        while (!ref.empty()) {
+            assert(heap.top() == ref.top());
+            heap.pop();
+            ref.pop();
+        }
+        assert(heap.empty());
+    }
+}
+
+void testDaryHeap() {
+    using namespace heap_test;
+    std::cout << "Testing dary_heap...\n";
+    std::mt19937_64 rng(45);
+
+    // Matches std::priority_queue through pushes, pops, pop_push and push_range.
+    {
+        raw::dary_heap<uint64_t> heap;
+        std::priority_queue<uint64_t> ref;
+        for (int i = 0; i < 20000; ++i) {
+            const uint64_t x = rng() % 1000;
+            if (i % 3 == 2) {
+                assert(heap.top() == ref.top());
+                heap.pop();
+                ref.pop();
+            }
+            else {
+                heap.push(x);
+                ref.push(x);
+            }
+        }
+        for (int i = 0; i < 1000; ++i) {
+            const uint64_t x = rng() % 1000;
+            const uint64_t old = heap.pop_push(x);
+            assert(old == ref.top());
+            ref.pop();
+            ref.push(x);
+        }
+        std::vector<uint64_t> bulk(50000);
+        for (auto& x : bulk) x = rng();
+        heap.push_range(bulk);
+        for (uint64_t x : bulk) ref.push(x);
+        heap.push_range(bulk.begin(), bulk.begin() + 100);
+        for (size_t i = 0; i < 100; ++i) ref.push(bulk[i]);
+        // Every child group starts on an aligned boundary (4 x 8 bytes).
+        assert(reinterpret_cast<uintptr_t>(heap.get_data() + 1) % 32 == 0);
+        raw::dary_heap<uint64_t> copy(heap);
+        assert(reinterpret_cast<uintptr_t>(copy.get_data() + 1) % 32 == 0);
+        assert(copy.get_size() == ref.size() && copy.top() == ref.top());
+        drain_and_compare(heap, ref);
+    }
+
+    // Other arities, a min-heap, and non-trivial elements.
+    {
+        raw::dary_heap<int, 2, std::greater<int>> min_heap;
+        raw::dary_heap<std::string, 8> strings;
+        std::priority_queue<int, std::vector<int>, std::greater<int>> min_ref;
+        std::priority_queue<std::string> string_ref;
+        for (int i = 0; i < 3000; ++i) {
+            const int x = static_cast<int>(rng() % 5000);
+            min_heap.push(x);
+            min_ref.push(x);
+            strings.push("value " + std::to_string(x));
+            string_ref.push("value " + std::to_string(x));
+        }
+        strings.replace_top("a");
+        string_ref.pop();
+        string_ref.push("a");
+        drain_and_compare(min_heap, min_ref);
+        raw::dary_heap<std::string, 8> moved(std::move(strings));
+        assert(strings.empty());
+        drain_and_compare(moved, string_ref);
+        bool threw = false;
+        try { moved.pop(); }
+        catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+    }
+
+    // Decrease-key through tracked positions: a min-heap of (distance, id).
+    {
+        std::vector<size_t> positions(1000, SIZE_MAX);
+        using item = std::pair<int, int>;
+        raw::dary_heap<item, 4, std::greater<item>, PositionTable> heap(std::greater<item>(), PositionTable{ &positions });
+        std::vector<int> distance(1000);
+        for (int id = 0; id < 1000; ++id) {
+            distance[id] = 10000 + static_cast<int>(rng() % 10000);
+            heap.push({ distance[id], id });
+        }
+        for (int id = 0; id < 1000; ++id) assert(heap[positions[id]].second == id);
+        for (int round = 0; round < 2000; ++round) {
+            const int id = static_cast<int>(rng() % 1000);
+            distance[id] -= static_cast<int>(rng() % 100);
+            heap.update(positions[id], { distance[id], id });
+        }
+        const item erased = heap.erase(positions[7]);
+        assert(erased.second == 7 && positions[7] == SIZE_MAX);
+        int last = INT32_MIN;
+        size_t popped = 0;
+        while (!heap.empty()) {
+            const item top = heap.top();
+            assert(top.first >= last && top.first == distance[top.second]);
+            last = top.first;
+            heap.pop();
+            assert(positions[top.second] == SIZE_MAX);
+            ++popped;
+        }
+        assert(popped == 999);
+    }
+    std::cout << "dary_heap tests passed.\n";
+}
+
+void testEytzinger() {
+    std::cout << "Testing eytzinger_array...\n";
+    std::mt19937_64 rng(46);
+
+    // Every size up to 300 (full and partial last levels), every probe between and around the keys.
+    for (size_t n = 0; n <= 300; ++n) {
+        raw::vector<int> sorted;
+        int value = 0;
+        for (size_t i = 0; i < n; ++i) {
+            value += static_cast<int>(rng() % 3);  // gaps and duplicates
+            sorted.push_back(value);
+        }
+        raw::eytzinger_array<int> array(sorted);
+        assert(array.get_size() == n);
+        raw::vector<int> probes;
+        for (int key = -1; key <= value + 1; ++key) probes.push_back(key);
+        raw::vector<size_t> slots = array.lower_bound_batch(probes);
+        for (size_t p = 0; p < probes.get_size(); ++p) {
+            const int key = probes[p];
+            const size_t rank = static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin());
+            const size_t slot = array.lower_bound(key);
+            assert(slots[p] == slot);
+            if (rank == n) assert(slot == n);
+            else assert(slot < n && array[slot] == sorted[rank]);
+            assert(array.contains(key) == std::binary_search(sorted.begin(), sorted.end(), key));
+        }
+    }
+
+    // Payloads follow the layout; 64-bit keys, a copy, and a descending order.
+    {
+        std::vector<uint64_t> keys(100000);
+        for (auto& k : keys) k = rng();
+        std::sort(keys.begin(), keys.end());
+        std::vector<uint32_t> ids(keys.size());
+        for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<uint32_t>(i);
+        raw::eytzinger_array<uint64_t> array(keys);
+        raw::vector<uint32_t> by_slot = array.permute(raw::span<const uint32_t>(ids.data(), ids.size()));
+        assert(reinterpret_cast<uintptr_t>(array.get_data() - 1) % 64 == 0);
+        raw::eytzinger_array<uint64_t> copy(array);
+        assert(reinterpret_cast<uintptr_t>(copy.get_data() - 1) % 64 == 0);
+        for (size_t i = 0; i < keys.size(); i += 97) {
+            assert(by_slot[copy.lower_bound(keys[i])] == i);
+            const size_t above = copy.lower_bound(keys[i] + 1);
+            assert(above == copy.get_size() || copy[above] > keys[i]);
+        }
+
+        std::vector<uint64_t> descending(keys.rbegin(), keys.rend());
+        raw::eytzinger_array<uint64_t, std::greater<uint64_t>> reversed(descending);
+        assert(reversed[reversed.lower_bound(keys[500])] == keys[500]);
+        assert(reversed.lower_bound(0) == reversed.get_size() || reversed[reversed.lower_bound(0)] == keys[0]);
+    }
+
+    // Non-trivial elements, and lookups on an empty array.
+    {
+        std::vector<std::string> words = { "apple", "banana", "cherry", "date", "elderberry", "fig", "grape" };
+        raw::eytzinger_array<std::string> array(words);
+        assert(array[array.lower_bound(std::string("c"))] == "cherry");
+        assert(array.lower_bound(std::string("zebra")) == array.get_size());
+        raw::eytzinger_array<std::string> moved(std::move(array));
+        assert(moved.contains(std::string("fig")) && !array.contains(std::string("fig")));
+        raw::eytzinger_array<int> empty;
+        assert(empty.lower_bound(5) == 0 && !empty.contains(5));
+        bool threw = false;
+        raw::vector<size_t> too_short(1);
+        try { raw::eytzinger_array<int>().lower_bound_batch(raw::vector<int>(4), raw::span<size_t>(too_short)); }
+        catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+    }
+    std::cout << "eytzinger_array tests passed.\n";
+}
+
+void testStringVector() {
+    std::cout << "Testing string_vector...\n";
+
+    // Appends, views, and the 32-bit offset variant.
+    {
+        raw::string_vector words;
+        words.push_back("apple");
+        words.push_back("");
+        words.push_back(std::string(100, 'x'));
+        assert(words.get_size() == 3 && words[0] == "apple" && words[1].empty() && words.back().size() == 100);
+        assert(words.get_char_count() == 105);
+        bool threw = false;
+        try { (void)words.at(3); } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+
+        raw::string_vector32 small;
+        small.push_back("abc");
+        assert(small[0] == "abc" && sizeof(raw::string_vector32::entry) == 8);
+    }
+
+    // append_delimited: a trailing piece without the delimiter, empty pieces, appends after it.
+    {
+        raw::string_vector lines;
+        assert(lines.append_delimited("") == 0);
+        assert(lines.append_delimited("one\ntwo\n\nthree") == 4);
+        assert(lines.append_delimited("four\n") == 1);
+        lines.push_back("five");
+        const std::vector<std::string> expected = { "one", "two", "", "three", "four", "five" };
+        assert(lines.get_size() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) assert(lines[i] == expected[i]);
+        assert(std::equal(lines.begin(), lines.end(), expected.begin()));
+
+        raw::string_vector csv;
+        assert(csv.append_delimited("a,b,", ',') == 2 && csv[1] == "b");
+
+        // Views into the vector's own characters survive the growth they cause.
+        raw::string_vector self;
+        self.push_back("a string long enough to matter");
+        for (int i = 0; i < 1000; ++i)
+            self.push_back(self[self.get_size() - 1]);
+        for (size_t i = 0; i < self.get_size(); ++i) assert(self[i] == "a string long enough to matter");
+        raw::string_vector doubled;
+        doubled.append_delimited("one\ntwo\n");
+        for (int i = 0; i < 12; ++i)
+            doubled.append_delimited(std::string_view(doubled.get_char_data(), doubled.get_char_count()));
+        assert(doubled.get_size() == (size_t(2) << 12) && doubled[4095] == "two" && doubled[8190] == "one");
+    }
+
+    // sort() matches std::sort on std::string, through shared 8-byte prefixes and embedded NULs.
+    {
+        std::mt19937_64 rng(47);
+        std::vector<std::string> reference;
+        raw::string_vector strings;
+        for (int i = 0; i < 5000; ++i) {
+            std::string s = (i % 3 == 0) ? "prefix__" : "";
+            const size_t length = rng() % 12;
+            for (size_t c = 0; c < length; ++c) s.push_back(static_cast<char>("ab\0\xff"[rng() % 4]));
+            reference.push_back(s);
+            strings.push_back(s);
+        }
+        std::sort(reference.begin(), reference.end());
+        strings.sort();
+        for (size_t i = 0; i < reference.size(); ++i) assert(strings[i] == reference[i]);
+
+        strings.sort(std::greater<std::string_view>());
+        for (size_t i = 0; i < reference.size(); ++i) assert(strings[i] == reference[reference.size() - 1 - i]);
+
+        // compact() lays the characters out in element order again.
+        const size_t before = strings.get_char_count();
+        strings.compact();
+        assert(strings.get_char_count() == before && strings.get_char_count_referenced() == before);
+        for (size_t i = 1; i < strings.get_size(); ++i) assert(strings.entry_at(i).begin == strings.entry_at(i - 1).end);
+        for (size_t i = 0; i < reference.size(); ++i) assert(strings[i] == reference[reference.size() - 1 - i]);
+    }
+
+    // erase / pop_back, compact after erase, swap, offset overflow.
+    {
+        raw::string_vector v;
+        v.append_delimited("red green blue", ' ');
+        v.erase(1);
+        assert(v.get_size() == 2 && v[0] == "red" && v[1] == "blue");
+        v.pop_back();
+        assert(v.get_size() == 1 && v.get_char_count() == 10);
+        v.compact();
+        assert(v.get_char_count() == 3 && v[0] == "red");
+        raw::string_vector other;
+        other.swap(v);
+        assert(v.empty() && other[0] == "red");
+        other.pop_back();
+        bool threw = false;
+        try { other.pop_back(); } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+        other.compact();
+        assert(other.get_char_count() == 0);
+
+        // 4 GiB of reserved, never committed address space stands in for a too-long input.
+        raw::vm_vector<char> huge(raw::vm_reservation{ size_t(1) << 32 });
+        huge.push_back('x');
+        const std::string_view too_long(huge.get_data(), size_t(1) << 32);
+        raw::string_vector32 v32;
+        threw = false;
+        try { v32.push_back(too_long); } catch (const std::length_error&) { threw = true; }
+        assert(threw && v32.empty());
+        threw = false;
+        try { v32.append_delimited(too_long); } catch (const std::length_error&) { threw = true; }
+        assert(threw && v32.empty() && v32.get_char_count() == 0);
+    }
+
+    std::cout << "string_vector tests passed.\n";
+}
+
+namespace adopt_test {
+    struct free_counter {
+        int calls = 0;
+        size_t last_capacity = 0;
+    };
+
+    inline void counted_free(void* ptr, size_t capacity, void* context) {
+        auto counter = static_cast<free_counter*>(context);
+        ++counter->calls;
+        counter->last_capacity = capacity;
+        std::free(ptr);
+    }
+
+    template<typename T>
+    T* malloc_filled(size_t capacity, size_t count) {
+        T* p = static_cast<T*>(std::malloc(capacity * sizeof(T)));
+        for (size_t i = 0; i < count; ++i) ::new (static_cast<void*>(p + i)) T(static_cast<T>(i));
+        return p;
+    }
+}
+
+void testAdoptDetach() {
+    std::cout << "Testing adopt/detach...\n";
+    using namespace adopt_test;
+
+    // A malloc'd buffer becomes the vector's own: grown with realloc, freed with free.
+    {
+        raw::vector<int> v;
+        int* p = malloc_filled<int>(8, 5);
+        v.adopt(p, 5, 8);
+        assert(v.get_data() == p && v.get_size() == 5 && v.get_capacity() == 8 && !v.has_custom_deleter());
+        for (int i = 5; i < 100; ++i) v.push_back(i);
+        for (int i = 0; i < 100; ++i) assert(v[i] == i);
+    }
+
+    // With a deleter: called once, on the first reallocation, after the elements were copied out.
+    {
+        free_counter counter;
+        raw::vector<int> v;
+        int* p = malloc_filled<int>(4, 4);
+        v.adopt(p, 4, 4, raw::buffer_deleter{ counted_free, &counter });
+        assert(v.has_custom_deleter() && v.get_data() == p);
+        v[0] = 42;
+        v.push_back(4);
+        assert(counter.calls == 1 && counter.last_capacity == 4 && !v.has_custom_deleter());
+        assert(v.get_size() == 5 && v[0] == 42 && v[4] == 4);
+        v.push_back(5);
+        assert(counter.calls == 1);
+    }
+
+    // ...on destruction, through a move, a swap and shrink_to_fit; never twice.
+    {
+        free_counter counter;
+        {
+            raw::vector<int> v;
+            v.adopt(malloc_filled<int>(16, 3), 3, 16, raw::buffer_deleter{ counted_free, &counter });
+            raw::vector<int> moved(std::move(v));
+            assert(moved.has_custom_deleter() && !v.has_custom_deleter() && moved[2] == 2);
+            raw::vector<int> other;
+            other.push_back(7);
+            other.swap(moved);
+            assert(other.has_custom_deleter() && !moved.has_custom_deleter() && moved[0] == 7);
+            assert(counter.calls == 0);
+        }
+        assert(counter.calls == 1 && counter.last_capacity == 16);
+
+        raw::vector<int> v;
+        v.adopt(malloc_filled<int>(16, 3), 3, 16, raw::buffer_deleter{ counted_free, &counter });
+        v.shrink_to_fit();
+        assert(counter.calls == 2 && v.get_capacity() == 3 && v[2] == 2 && !v.has_custom_deleter());
+        v.adopt(malloc_filled<int>(2, 1), 1, 2, raw::buffer_deleter{ counted_free, &counter });
+        v.release();
+        assert(counter.calls == 3 && v.get_size() == 0);
+    }
+
+    // detach hands the buffer out without freeing it; another vector can adopt it.
+    {
+        raw::vector<double> v;
+        for (int i = 0; i < 10; ++i) v.push_back(i * 0.5);
+        const double* before = v.get_data();
+        raw::detached_buffer<double> buffer = v.detach();
+        assert(buffer.data == before && buffer.size == 10 && buffer.capacity >= 10);
+        assert(v.get_size() == 0 && v.get_capacity() == 0 && v.get_data() == nullptr);
+        v.push_back(1.0);
+        assert(v.get_size() == 1 && v[0] == 1.0);
+
+        raw::vector<double> w;
+        w.adopt(buffer.data, buffer.size, buffer.capacity, buffer.deleter);
+        assert(w.get_data() == before && w[9] == 4.5);
+        raw::detached_buffer<double> again = w.detach();
+        again.dispose();
+        assert(again.data == nullptr);
+
+        free_counter counter;
+        raw::vector<double> x;
+        x.adopt(static_cast<double*>(std::malloc(sizeof(double))), 0, 1, raw::buffer_deleter{ counted_free, &counter });
+        raw::detached_buffer<double> custom = x.detach();
+        assert(custom.deleter.fn == counted_free && counter.calls == 0);
+        custom.dispose();
+        assert(counter.calls == 1);
+    }
+
+    // Invalid descriptions throw and leave both sides untouched.
+    {
+        raw::vector<int> v;
+        v.push_back(1);
+        int* p = malloc_filled<int>(4, 4);
+        bool threw = false;
+        try { v.adopt(p, 5, 4); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw && v.get_size() == 1 && v[0] == 1);
+        threw = false;
+        try { v.adopt(nullptr, 1, 1); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+        threw = false;
+        try { v.adopt(v.get_data(), 1, 1); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw && v[0] == 1);
+        v.adopt(nullptr, 0, 0);
+        assert(v.get_size() == 0 && v.get_capacity() == 0);
+        v.push_back(3);
+        assert(v[0] == 3);
+        std::free(p);
+    }
+
+    // Non-trivial elements: adopted objects are destroyed by the vector, detached ones by the caller.
+    {
+        free_counter counter;
+        std::string* p = static_cast<std::string*>(std::malloc(2 * sizeof(std::string)));
+        ::new (static_cast<void*>(p)) std::string(40, 'a');
+        {
+            raw::vector<std::string> v;
+            v.adopt(p, 1, 2, raw::buffer_deleter{ counted_free, &counter });
+            v.push_back(std::string(40, 'b'));
+            v.push_back(std::string(40, 'c'));
+            assert(counter.calls == 1 && v[0] == std::string(40, 'a') && v[2] == std::string(40, 'c'));
+            raw::detached_buffer<std::string> buffer = v.detach();
+            for (size_t i = 0; i < buffer.size; ++i) buffer.data[i].~basic_string();
+            buffer.dispose();
+        }
+        assert(counter.calls == 1);
+    }
+
+    // std::vector interop: malloc_vector buffers come over without a copy, go back with one.
+    {
+        raw::vector<uint32_t> v;
+        for (uint32_t i = 0; i < 1000; ++i) v.push_back(i * 3);
+        raw::malloc_vector<uint32_t> std_side = raw::to_std_vector(std::move(v));
+        assert(std_side.size() == 1000 && v.get_size() == 0 && v.get_data() == nullptr);
+        for (uint32_t i = 0; i < 1000; ++i) assert(std_side[i] == i * 3);
+
+        std_side.resize(1200);
+        assert(std_side[1100] == 0 && raw::malloc_vector<uint32_t>(8)[7] == 0);
+        const uint32_t* grown = std_side.data();
+        const size_t capacity = std_side.capacity();
+        raw::vector<uint32_t> back = raw::from_std_vector(std::move(std_side));
+        assert(back.get_data() == grown && back.get_capacity() == capacity && back.get_size() == 1200);
+        assert(back[999] == 2997 && back[1100] == 0 && std_side.empty());
+        back.push_back(7);
+        assert(back[1200] == 7);
+
+        free_counter counter;
+        raw::vector<uint32_t> adopted;
+        adopted.adopt(malloc_filled<uint32_t>(4, 4), 4, 4, raw::buffer_deleter{ counted_free, &counter });
+        raw::malloc_vector<uint32_t> copied = raw::to_std_vector(std::move(adopted));
+        assert(counter.calls == 1 && copied.size() == 4 && copied[3] == 3);
+
+        raw::malloc_vector<uint32_t> empty;
+        assert(raw::from_std_vector(std::move(empty)).get_size() == 0);
+        raw::vector<uint32_t> none;
+        none.release();
+        assert(raw::to_std_vector(std::move(none)).empty());
+
+        const std::vector<std::string> words = { "x", "y", "z" };
+        raw::vector<std::string> copy = raw::from_std_vector(words);
+        assert(copy.get_size() == 3 && copy[2] == "z" && words[2] == "z");
+    }
+
+    std::cout << "adopt/detach tests passed.\n";
+}
+
+void testRcuVector() {
+    std::cout << "Testing rcu_vector...\n";
+
+    // Batches publish as one version; unpublished batches vanish; snapshots keep their version.
+    {
+        raw::vector<int> initial;
+        for (int i = 0; i < 4; ++i) initial.push_back(i);
+        raw::rcu_vector<int> table(initial, 4);
+        auto reader = table.make_reader();
+        {
+            auto before = reader.read();
+            assert(before.get_size() == 4 && before[3] == 3);
+
+            auto batch = table.edit();
+            batch->push_back(4);
+            (*batch)[0] = 100;
+            assert(before[0] == 0);  // not yet published
+            batch.publish();
+
+            auto nested = reader.read();
+            assert(nested.get_size() == 5 && nested[0] == 100);
+            assert(before.get_size() == 4 && before[0] == 0);  // still the old version
+
+            { auto discarded = table.edit(); discarded->clear(); }
+            table.update([](raw::vector<int>& v) { v.push_back(5); });
+            assert(table.get_retired_count() == 2);  // both held back by the open snapshots
+            int sum = 0;
+            for (int value : before.get_span()) sum += value;
+            assert(sum == 6);
+        }
+        table.reclaim();
+        assert(table.get_retired_count() == 0);
+        auto after = reader.read();
+        assert(after.get_size() == 6 && after[0] == 100 && after[5] == 5 && table.get_epoch() == 3);
+    }
+
+    // Reader slots: exhaustion throws, a dropped reader frees its slot.
+    {
+        raw::rcu_vector<int> table(2);
+        auto a = table.make_reader();
+        {
+            auto b = table.make_reader();
+            bool threw = false;
+            try { (void)table.make_reader(); } catch (const std::length_error&) { threw = true; }
+            assert(threw);
+        }
+        auto c = table.make_reader();
+        assert(c.read().empty());
+        table.assign(raw::vector<int>(3));
+        assert(a.read().get_size() == 3);
+    }
+
+    // Concurrent readers and writers: every snapshot is one whole version (ASan catches early frees).
+    {
+        raw::rcu_vector<std::string> table;
+        table.assign(raw::vector<std::string>());
+        std::atomic<bool> done{ false };
+        std::atomic<size_t> checked{ 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                auto reader = table.make_reader();
+                size_t local = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto snap = reader.read();
+                    const size_t n = snap.get_size();
+                    if (n == 0) continue;
+                    const std::string& first = snap[0];
+                    assert(first.size() == n);
+                    for (size_t i = 1; i < n; ++i) assert(snap[i] == first);
+                    ++local;
+                }
+                checked.fetch_add(local);
+            });
+        }
+        for (int w = 0; w < 2; ++w) {
+            threads.emplace_back([&, w]() {
+                for (int round = 0; round < 300; ++round) {
+                    const char fill = static_cast<char>('a' + w);
+                    table.update([&](raw::vector<std::string>& v) {
+                        const size_t n = static_cast<size_t>(round % 40) + 20;
+                        v.clear();
+                        for (size_t i = 0; i < n; ++i) v.push_back(std::string(n, fill));
+                    });
+                    if (round % 16 == 0) std::this_thread::yield();
+                }
+            });
+        }
+        threads[4].join();
+        threads[5].join();
+        done.store(true);
+        for (int t = 0; t < 4; ++t) threads[t].join();
+        table.reclaim();
+        assert(table.get_retired_count() == 0 && table.get_epoch() == 602);
+    }
+
+    std::cout << "rcu_vector tests passed.\n";
+}
+
+void testThreadCollector() {
+    std::cout << "Testing thread_collector...\n";
+
+    // Explicit worker indices: the merge is the slots in index order, whatever the timing.
+    {
+        raw::thread_collector<uint32_t> collector(5);
+        std::vector<std::thread> workers;
+        for (uint32_t w = 0; w < 5; ++w) {
+            workers.emplace_back([&collector, w]() {
+                raw::vector<uint32_t>& out = collector.local(w);
+                for (uint32_t i = 0; i < w * 300; ++i) out.push_back(w * 100000 + i);  // slot 0 stays empty
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        assert(collector.get_size() == 3000);
+        raw::vector<uint32_t> merged = collector.merge();
+        assert(merged.get_size() == 3000 && merged.get_capacity() == 3000);
+        size_t k = 0;
+        for (uint32_t w = 0; w < 5; ++w)
+            for (uint32_t i = 0; i < w * 300; ++i) assert(merged[k++] == w * 100000 + i);
+        assert(collector.get_size() == 0 && collector.local(4).get_capacity() >= 1200);
+
+        // merge_into appends; a second round reuses the locals.
+        collector.local(2).push_back(7);
+        collector.local(0).push_back(6);
+        collector.merge_into(merged);
+        assert(merged.get_size() == 3002 && merged[3000] == 6 && merged[3001] == 7);
+
+        bool threw = false;
+        try { (void)collector.local(5); } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+    }
+
+    // Parallel copy of a large result (4 copy threads over uneven pieces).
+    {
+        raw::thread_collector<uint64_t> collector(7);
+        const size_t counts[7] = { 100000, 0, 1, 250000, 33333, 0, 140000 };
+        uint64_t value = 0;
+        for (size_t w = 0; w < 7; ++w)
+            for (size_t i = 0; i < counts[w]; ++i) collector.local(w).push_back(value++);
+        raw::merge_options options;
+        options.threads = 4;
+        options.keep_capacity = false;
+        raw::vector<uint64_t> merged = collector.merge(options);
+        assert(merged.get_size() == value);
+        for (uint64_t i = 0; i < value; ++i) assert(merged[i] == i);
+        assert(collector.local(3).get_capacity() == 0);
+    }
+
+    // local(): each thread gets its own slot; too many threads throws.
+    {
+        raw::thread_collector<int> collector(4);
+        raw::thread_collector<int> other(4);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&collector, &other, t]() {
+                for (int i = 0; i < 1000; ++i) {
+                    collector.local().push_back(t * 1000 + i);
+                    other.local().push_back(t);  // alternating collectors keeps each slot
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        raw::vector<int> merged = collector.merge();
+        assert(merged.get_size() == 4000);
+        for (size_t piece = 0; piece < 4; ++piece) {
+            const int first = merged[piece * 1000];
+            assert(first % 1000 == 0);
+            for (int i = 0; i < 1000; ++i) assert(merged[piece * 1000 + i] == first + i);
+        }
+        assert(other.get_size() == 4000);
+
+        raw::thread_collector<int> single(1);
+        single.local().push_back(1);  // the main thread takes the only slot
+        bool threw = false;
+        std::thread extra([&]() {
+            try { single.local().push_back(0); } catch (const std::length_error&) { threw = true; }
+        });
+        extra.join();
+        assert(threw && single.get_size() == 1);
+    }
+
+    // Non-trivial elements are moved.
+    {
+        raw::thread_collector<std::string> collector(2);
+        collector.local(1).push_back(std::string(50, 'b'));
+        collector.local(0).push_back(std::string(50, 'a'));
+        collector.local(1).push_back("c");
+        raw::vector<std::string> merged = collector.merge();
+        assert(merged.get_size() == 3 && merged[0] == std::string(50, 'a') && merged[1] == std::string(50, 'b') && merged[2] == "c");
+    }
+
+    std::cout << "thread_collector tests passed.\n";
+}
 
 int main() {
     testDefaultConstructorInt();
@@ -758,5 +2885,36 @@ int main() {
     testCombinedOperationsInt();
 
     std::cout << "All int tests passed!\n";
+
+    testBitVectorBasic();
+    testBitVectorBulkOps();
+    testBitVectorRankSelect();
+
+    std::cout << "All bit_vector tests passed!\n";
+
+    testAllocProfiler();
+    testTryApi();
+    testConstexprVector();
+    testInplaceVectorTrivial();
+    testInplaceVectorNonTrivial();
+    testShrinkPolicy();
+    testMoveNonTrivial();
+    testGapBuffer();
+    testSpan();
+    testExpressions();
+    testIteratorConformance();
+    testRadixSort();
+    testFlatHashMap();
+    testSlotMap();
+    testEraseIf();
+    testFdIO();
+    testVmVector();
+    testPolyVector();
+    testDaryHeap();
+    testEytzinger();
+    testStringVector();
+    testAdoptDetach();
+    testRcuVector();
+    testThreadCollector();
     return 0;
 }